@@ -118,6 +118,7 @@ def run_miniterm(config, port):
     import serial
 
     from esphome import platformio_api
+    from esphome.components.logger.binary_log import get_decoder
 
     if CONF_LOGGER not in config:
         _LOGGER.info("Logger is not enabled. Not starting UART logs.")
@@ -129,6 +130,7 @@ def run_miniterm(config, port):
     _LOGGER.info("Starting log output from %s with baud rate %s", port, baud_rate)
 
     backtrace_state = False
+    decoder = get_decoder(config)
     ser = serial.Serial()
     ser.baudrate = baud_rate
     ser.port = port
@@ -154,6 +156,8 @@ def run_miniterm(config, port):
                         .replace(b"\n", b"")
                         .decode("utf8", "backslashreplace")
                     )
+                    if decoder is not None:
+                        line = decoder.decode(line)
                     time_str = datetime.now().time().strftime("[%H:%M:%S]")
                     message = time_str + line
                     safe_print(message)
@@ -360,10 +364,14 @@ def upload_program(config, args, host):
             config, args.username, args.password, args.client_id
         )
 
+    # Earlier uploads to this device, to send patches against them
+    image_cache_dir = CORE.relative_internal_path("ota_images", CORE.name)
     if getattr(args, "file", None) is not None:
-        return espota2.run_ota(host, remote_port, password, args.file)
+        return espota2.run_ota(host, remote_port, password, args.file, image_cache_dir)
 
-    return espota2.run_ota(host, remote_port, password, CORE.firmware_bin)
+    return espota2.run_ota(
+        host, remote_port, password, CORE.firmware_bin, image_cache_dir
+    )
 
 
 def show_logs(config, args, port):
@@ -94,7 +94,11 @@ void APIConnection::loop() {
     return;
   }
   ReadPacketBuffer buffer;
-  err = this->helper_->read_packet(&buffer);
+  if (!this->helper_->can_read_without_blocking()) {
+    err = APIError::WOULD_BLOCK;
+  } else {
+    err = this->helper_->read_packet(&buffer);
+  }
   if (err == APIError::WOULD_BLOCK) {
     // pass
   } else if (err != APIError::OK) {
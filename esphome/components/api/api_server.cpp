@@ -25,7 +25,7 @@ static const char *const TAG = "api";
 void APIServer::setup() {
   ESP_LOGCONFIG(TAG, "Setting up Home Assistant API server...");
   this->setup_controller();
-  socket_ = socket::socket_ip(SOCK_STREAM, 0);
+  socket_ = socket::socket_ip_loop_monitored(SOCK_STREAM, 0);
   if (socket_ == nullptr) {
     ESP_LOGW(TAG, "Could not create socket.");
     this->mark_failed();
@@ -94,7 +94,7 @@ void APIServer::setup() {
 }
 void APIServer::loop() {
   // Accept new clients
-  while (true) {
+  while (this->socket_->ready()) {
     struct sockaddr_storage source_addr;
     socklen_t addr_len = sizeof(source_addr);
     auto sock = socket_->accept((struct sockaddr *) &source_addr, &addr_len);
@@ -85,10 +85,36 @@ void Display::draw_pixels_at(int x_start, int y_start, int w, int h, const uint8
   }
 }
 
+void HOT Display::draw_row_internal_(int x, int y, int w, const Color *colors) {
+  for (int i = 0; i != w; i++)
+    this->draw_pixel_at(x + i, y, colors[i]);
+}
+
+void HOT Display::draw_rgb565_row_internal_(int x, int y, int w, const uint8_t *data) {
+  Color colors[ROW_CHUNK_SIZE];
+  while (w > 0) {
+    int len = std::min(w, ROW_CHUNK_SIZE);
+    for (int i = 0; i != len; i++, data += 2) {
+      colors[i] = ColorUtil::rgb565_to_color((data[0] << 8) | data[1]);
+    }
+    this->draw_row_internal_(x, y, len, colors);
+    x += len;
+    w -= len;
+  }
+}
+
 void HOT Display::horizontal_line(int x, int y, int width, Color color) {
-  // Future: Could be made more efficient by manipulating buffer directly in certain rotations.
-  for (int i = x; i < x + width; i++)
-    this->draw_pixel_at(i, y, color);
+  int min_x, max_x, min_y, max_y;
+  if (!this->clamp_y_(y, 1, min_y, max_y) || !this->clamp_x_(x, width, min_x, max_x))
+    return;
+  Color colors[ROW_CHUNK_SIZE];
+  int len = std::min(max_x - min_x, ROW_CHUNK_SIZE);
+  for (int i = 0; i != len; i++)
+    colors[i] = color;
+  for (x = min_x; x < max_x; x += len) {
+    len = std::min(max_x - x, ROW_CHUNK_SIZE);
+    this->draw_row_internal_(x, y, len, colors);
+  }
 }
 void HOT Display::vertical_line(int x, int y, int height, Color color) {
   // Future: Could be made more efficient by manipulating buffer directly in certain rotations.
@@ -164,6 +164,9 @@ const float ROTATION_90_DEGREES = 90.0;
 const float ROTATION_180_DEGREES = 180.0;
 const float ROTATION_270_DEGREES = 270.0;
 
+/// Number of pixels of a row converted at once by the row drawing functions.
+const int ROW_CHUNK_SIZE = 32;
+
 enum RegularPolygonVariation {
   VARIATION_POINTY_TOP = 0,
   VARIATION_FLAT_TOP = 1,
@@ -256,6 +259,47 @@ class Display : public PollingComponent {
     this->draw_pixels_at(x_start, y_start, w, h, ptr, order, bitness, big_endian, 0, 0, 0);
   }
 
+  /** Queue drawing a packed block of pixels, see draw_pixels_at().
+   *
+   * Displays that transfer pixels in the background may return while ptr is still being read, so the buffer must not
+   * be changed until draw_pixels_complete() returns true. By default the pixels are drawn before returning.
+   */
+  virtual void queue_draw_pixels_at(int x_start, int y_start, int w, int h, const uint8_t *ptr, ColorOrder order,
+                                    ColorBitness bitness, bool big_endian) {
+    this->draw_pixels_at(x_start, y_start, w, h, ptr, order, bitness, big_endian, 0, 0, 0);
+  }
+
+  /// Check if the pixels queued by queue_draw_pixels_at() have been drawn, optionally waiting until they are.
+  virtual bool draw_pixels_complete(bool wait) { return true; }
+
+  /** Draw a horizontal row of pixels starting at [x, y].
+   *
+   * Equivalent to calling draw_pixel_at() for every pixel, but the row is clipped once and buffered displays write
+   * the visible part of the row at once.
+   *
+   * \param x The x position of the first pixel
+   * \param y The y position of the row
+   * \param w The number of pixels in the row
+   * \param colors The colors of the pixels
+   */
+  void draw_row_at(int x, int y, int w, const Color *colors) {
+    int min_x, max_x, min_y, max_y;
+    if (!this->clamp_y_(y, 1, min_y, max_y) || !this->clamp_x_(x, w, min_x, max_x))
+      return;
+    this->draw_row_internal_(min_x, y, max_x - min_x, colors + (min_x - x));
+  }
+
+  /** Draw a horizontal row of pixels stored as big-endian RGB565 starting at [x, y], see draw_row_at().
+   *
+   * Displays with a big-endian RGB565 buffer copy the row as is.
+   */
+  void draw_rgb565_row_at(int x, int y, int w, const uint8_t *data) {
+    int min_x, max_x, min_y, max_y;
+    if (!this->clamp_y_(y, 1, min_y, max_y) || !this->clamp_x_(x, w, min_x, max_x))
+      return;
+    this->draw_rgb565_row_internal_(min_x, y, max_x - min_x, data + (min_x - x) * 2);
+  }
+
   /// Draw a straight line from the point [x1,y1] to [x2,y2] with the given color.
   void line(int x1, int y1, int x2, int y2, Color color = COLOR_ON);
 
@@ -645,6 +689,11 @@ class Display : public PollingComponent {
  protected:
   bool clamp_x_(int x, int w, int &min_x, int &max_x);
   bool clamp_y_(int y, int h, int &min_y, int &max_y);
+
+  /// Draw a row that lies completely within the display and the clipping rectangle.
+  virtual void draw_row_internal_(int x, int y, int w, const Color *colors);
+  /// Draw a big-endian RGB565 row that lies completely within the display and the clipping rectangle.
+  virtual void draw_rgb565_row_internal_(int x, int y, int w, const uint8_t *data);
   void vprintf_(int x, int y, BaseFont *font, Color color, Color background, TextAlign align, const char *format,
                 va_list arg);
 
@@ -20,6 +20,25 @@ void DisplayBuffer::init_internal_(uint32_t buffer_length) {
   this->clear();
 }
 
+void DisplayBuffer::start_band_(int y_start, int height) {
+  this->band_start_ = y_start;
+  this->clear_clipping_();
+  switch (this->rotation_) {
+    case DISPLAY_ROTATION_0_DEGREES:
+      this->start_clipping(Rect(0, y_start, this->get_width(), height));
+      break;
+    case DISPLAY_ROTATION_90_DEGREES:
+      this->start_clipping(Rect(y_start, 0, height, this->get_height()));
+      break;
+    case DISPLAY_ROTATION_180_DEGREES:
+      this->start_clipping(Rect(0, this->get_height_internal() - y_start - height, this->get_width(), height));
+      break;
+    case DISPLAY_ROTATION_270_DEGREES:
+      this->start_clipping(Rect(this->get_height_internal() - y_start - height, 0, height, this->get_height()));
+      break;
+  }
+}
+
 int DisplayBuffer::get_width() {
   switch (this->rotation_) {
     case DISPLAY_ROTATION_90_DEGREES:
@@ -68,5 +87,56 @@ void HOT DisplayBuffer::draw_pixel_at(int x, int y, Color color) {
   App.feed_wdt();
 }
 
+void HOT DisplayBuffer::draw_row_internal_(int x, int y, int w, const Color *colors) {
+  switch (this->rotation_) {
+    case DISPLAY_ROTATION_0_DEGREES:
+      this->draw_absolute_row_internal(x, y, w, colors);
+      break;
+    case DISPLAY_ROTATION_90_DEGREES:
+      for (int i = 0; i != w; i++)
+        this->draw_absolute_pixel_internal(this->get_width_internal() - y - 1, x + i, colors[i]);
+      break;
+    case DISPLAY_ROTATION_180_DEGREES:
+      // still a row, but drawn from right to left
+      for (int i = 0; i != w; i++) {
+        this->draw_absolute_pixel_internal(this->get_width_internal() - x - i - 1, this->get_height_internal() - y - 1,
+                                           colors[i]);
+      }
+      break;
+    case DISPLAY_ROTATION_270_DEGREES:
+      for (int i = 0; i != w; i++)
+        this->draw_absolute_pixel_internal(y, this->get_height_internal() - x - i - 1, colors[i]);
+      break;
+  }
+  App.feed_wdt();
+}
+
+void HOT DisplayBuffer::draw_rgb565_row_internal_(int x, int y, int w, const uint8_t *data) {
+  if (this->rotation_ != DISPLAY_ROTATION_0_DEGREES) {
+    Display::draw_rgb565_row_internal_(x, y, w, data);
+    return;
+  }
+  this->draw_absolute_rgb565_row_internal(x, y, w, data);
+  App.feed_wdt();
+}
+
+void HOT DisplayBuffer::draw_absolute_row_internal(int x, int y, int w, const Color *colors) {
+  for (int i = 0; i != w; i++)
+    this->draw_absolute_pixel_internal(x + i, y, colors[i]);
+}
+
+void HOT DisplayBuffer::draw_absolute_rgb565_row_internal(int x, int y, int w, const uint8_t *data) {
+  Color colors[ROW_CHUNK_SIZE];
+  while (w > 0) {
+    int len = std::min(w, ROW_CHUNK_SIZE);
+    for (int i = 0; i != len; i++, data += 2) {
+      colors[i] = ColorUtil::rgb565_to_color((data[0] << 8) | data[1]);
+    }
+    this->draw_absolute_row_internal(x, y, len, colors);
+    x += len;
+    w -= len;
+  }
+}
+
 }  // namespace display
 }  // namespace esphome
@@ -24,10 +24,26 @@ class DisplayBuffer : public Display {
 
  protected:
   virtual void draw_absolute_pixel_internal(int x, int y, Color color) = 0;
+  /// Write a row of pixels at unrotated coordinates, override to write into the buffer without per-pixel calls.
+  virtual void draw_absolute_row_internal(int x, int y, int w, const Color *colors);
+  /// Write a row of big-endian RGB565 pixels at unrotated coordinates.
+  virtual void draw_absolute_rgb565_row_internal(int x, int y, int w, const uint8_t *data);
+
+  void draw_row_internal_(int x, int y, int w, const Color *colors) override;
+  void draw_rgb565_row_internal_(int x, int y, int w, const uint8_t *data) override;
 
   void init_internal_(uint32_t buffer_length);
 
+  /** Restrict drawing to the unrotated rows [y_start, y_start + height) for rendering the display in bands.
+   *
+   * Sets the clipping rectangle to the part of the display covered by the band, so that a buffer holding only
+   * these rows can be rendered by running the writer once per band. The clipping is cleared by do_update_().
+   */
+  void start_band_(int y_start, int height);
+
   uint8_t *buffer_{nullptr};
+  /// The first unrotated row held by the buffer when rendering in bands.
+  int band_start_{0};
 };
 
 }  // namespace display
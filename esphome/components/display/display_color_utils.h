@@ -66,6 +66,13 @@ class ColorUtil {
     }
     return color_return;
   }
+  /// Convert a RGB565 value to a color, the high bits of each component are repeated in its low bits.
+  static inline Color rgb565_to_color(uint16_t rgb565) {
+    uint8_t r = (rgb565 & 0xF800) >> 11;
+    uint8_t g = (rgb565 & 0x07E0) >> 5;
+    uint8_t b = rgb565 & 0x001F;
+    return Color((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2), 0xFF);
+  }
   static inline Color rgb332_to_color(uint8_t rgb332_color) {
     return to_color((uint32_t) rgb332_color, COLOR_ORDER_RGB, COLOR_BITNESS_332);
   }
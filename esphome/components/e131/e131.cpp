@@ -18,7 +18,7 @@ E131Component::~E131Component() {
 }
 
 void E131Component::setup() {
-  this->socket_ = socket::socket_ip(SOCK_DGRAM, IPPROTO_IP);
+  this->socket_ = socket::socket_ip_loop_monitored(SOCK_DGRAM, IPPROTO_IP);
 
   int enable = 1;
   int err = this->socket_->setsockopt(SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(int));
@@ -53,6 +53,9 @@ void E131Component::setup() {
 }
 
 void E131Component::loop() {
+  if (!this->socket_->ready())
+    return;
+
   std::vector<uint8_t> payload;
   E131Packet packet;
   int universe = 0;
@@ -1,9 +1,14 @@
 #ifdef USE_ESP32
 
 #include "esphome/core/preferences.h"
+#include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 #include <nvs_flash.h>
+#ifdef USE_PREFERENCES_RTC_CACHE
+#include <esp_attr.h>
+#include <esp_system.h>
+#endif
 #include <cstring>
 #include <cinttypes>
 #include <vector>
@@ -14,44 +19,135 @@ namespace esp32 {
 
 static const char *const TAG = "esp32.preferences";
 
-struct NVSData {
-  std::string key;
-  std::vector<uint8_t> data;
+class ESP32PreferenceBackend;
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+static std::vector<ESP32PreferenceBackend *> s_pending_save;
+
+#ifdef USE_PREFERENCES_RTC_CACHE
+// Copy of the values in NVS, in RTC memory which is kept in deep sleep. After waking up, values are loaded from it
+// instead of NVS. Entries are the type (4 bytes), the length (2 bytes) and the value.
+static const uint32_t RTC_CACHE_MAGIC = 0x50524546;
+static const size_t RTC_CACHE_ENTRY_HEADER_SIZE = 6;
+
+struct RTCCache {
+  uint32_t magic;
+  uint16_t crc;
+  uint16_t used;
+  uint8_t data[USE_PREFERENCES_RTC_CACHE];
 };
+RTC_NOINIT_ATTR static RTCCache s_rtc_cache;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+static uint16_t rtc_cache_crc() { return crc16(s_rtc_cache.data, s_rtc_cache.used, s_rtc_cache.used); }
+
+static void rtc_cache_setup() {
+  // Values in RTC memory after other resets are not trusted, NVS might have changed
+  if (esp_reset_reason() == ESP_RST_DEEPSLEEP && s_rtc_cache.magic == RTC_CACHE_MAGIC &&
+      s_rtc_cache.used <= sizeof(s_rtc_cache.data) && s_rtc_cache.crc == rtc_cache_crc()) {
+    ESP_LOGV(TAG, "Using %u bytes of preferences kept in RTC memory", s_rtc_cache.used);
+    return;
+  }
+  s_rtc_cache.used = 0;
+  s_rtc_cache.crc = rtc_cache_crc();
+  s_rtc_cache.magic = RTC_CACHE_MAGIC;
+}
+
+static uint8_t *rtc_cache_find(uint32_t type, uint16_t *len) {
+  uint8_t *entry = s_rtc_cache.data;
+  while (entry + RTC_CACHE_ENTRY_HEADER_SIZE <= s_rtc_cache.data + s_rtc_cache.used) {
+    uint32_t entry_type;
+    memcpy(&entry_type, entry, 4);
+    memcpy(len, entry + 4, 2);
+    if (entry_type == type)
+      return entry + RTC_CACHE_ENTRY_HEADER_SIZE;
+    entry += RTC_CACHE_ENTRY_HEADER_SIZE + *len;
+  }
+  return nullptr;
+}
 
-static std::vector<NVSData> s_pending_save;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static bool rtc_cache_load(uint32_t type, uint8_t *data, size_t len) {
+  if (s_rtc_cache.magic != RTC_CACHE_MAGIC)
+    return false;
+  uint16_t entry_len;
+  uint8_t *value = rtc_cache_find(type, &entry_len);
+  if (value == nullptr || entry_len != len)
+    return false;
+  memcpy(data, value, len);
+  return true;
+}
+
+static void rtc_cache_store(uint32_t type, const uint8_t *data, size_t len) {
+  uint16_t entry_len;
+  uint8_t *value = rtc_cache_find(type, &entry_len);
+  if (value != nullptr && entry_len != len) {
+    // Entries can't be resized, start over
+    s_rtc_cache.used = 0;
+    value = nullptr;
+  }
+  if (value == nullptr) {
+    if (s_rtc_cache.used + RTC_CACHE_ENTRY_HEADER_SIZE + len > sizeof(s_rtc_cache.data)) {
+      ESP_LOGV(TAG, "RTC memory for preferences is full");
+      return;
+    }
+    uint8_t *entry = s_rtc_cache.data + s_rtc_cache.used;
+    entry_len = len;
+    memcpy(entry, &type, 4);
+    memcpy(entry + 4, &entry_len, 2);
+    value = entry + RTC_CACHE_ENTRY_HEADER_SIZE;
+    s_rtc_cache.used += RTC_CACHE_ENTRY_HEADER_SIZE + len;
+  }
+  memcpy(value, data, len);
+  s_rtc_cache.crc = rtc_cache_crc();
+}
+#endif  // USE_PREFERENCES_RTC_CACHE
 
 class ESP32PreferenceBackend : public ESPPreferenceBackend {
  public:
   std::string key;
+  uint32_t type;
   uint32_t nvs_handle;
+  /// Value to write on the next sync, if pending.
+  std::vector<uint8_t> pending_data;
+  bool pending{false};
+  /// Copy of the value in NVS, to detect changes without reading it back.
+  std::vector<uint8_t> stored_data;
+  bool stored_known{false};
+  uint32_t min_write_interval{0};
+  uint32_t last_write{0};
+  bool written{false};
+
   bool save(const uint8_t *data, size_t len) override {
-    // try find in pending saves and update that
-    for (auto &obj : s_pending_save) {
-      if (obj.key == key) {
-        obj.data.assign(data, data + len);
+    if (!this->pending) {
+      if (this->stored_known && this->stored_data.size() == len && memcmp(this->stored_data.data(), data, len) == 0) {
+        ESP_LOGVV(TAG, "save: key: %s not changed", key.c_str());
         return true;
       }
+      this->pending = true;
+      s_pending_save.push_back(this);
     }
-    NVSData save{};
-    save.key = key;
-    save.data.assign(data, data + len);
-    s_pending_save.emplace_back(save);
+    this->pending_data.assign(data, data + len);
     ESP_LOGVV(TAG, "s_pending_save: key: %s, len: %d", key.c_str(), len);
     return true;
   }
   bool load(uint8_t *data, size_t len) override {
-    // try find in pending saves and load from that
-    for (auto &obj : s_pending_save) {
-      if (obj.key == key) {
-        if (obj.data.size() != len) {
-          // size mismatch
-          return false;
-        }
-        memcpy(data, obj.data.data(), len);
-        return true;
+    // load the value that was not written yet
+    if (this->pending) {
+      if (this->pending_data.size() != len) {
+        // size mismatch
+        return false;
       }
+      memcpy(data, this->pending_data.data(), len);
+      return true;
+    }
+
+#ifdef USE_PREFERENCES_RTC_CACHE
+    if (rtc_cache_load(this->type, data, len)) {
+      ESP_LOGVV(TAG, "load: key: %s from RTC memory", key.c_str());
+      this->stored_data.assign(data, data + len);
+      this->stored_known = true;
+      return true;
     }
+#endif
 
     size_t actual_len;
     esp_err_t err = nvs_get_blob(nvs_handle, key.c_str(), nullptr, &actual_len);
@@ -70,8 +166,14 @@ class ESP32PreferenceBackend : public ESPPreferenceBackend {
     } else {
       ESP_LOGVV(TAG, "nvs_get_blob: key: %s, len: %d", key.c_str(), len);
     }
+    this->stored_data.assign(data, data + len);
+    this->stored_known = true;
+#ifdef USE_PREFERENCES_RTC_CACHE
+    rtc_cache_store(this->type, data, len);
+#endif
     return true;
   }
+  void set_min_write_interval(uint32_t interval_ms) override { this->min_write_interval = interval_ms; }
 };
 
 class ESP32Preferences : public ESPPreferences {
@@ -100,6 +202,7 @@ class ESP32Preferences : public ESPPreferences {
   ESPPreferenceObject make_preference(size_t length, uint32_t type) override {
     auto *pref = new ESP32PreferenceBackend();  // NOLINT(cppcoreguidelines-owning-memory)
     pref->nvs_handle = nvs_handle;
+    pref->type = type;
 
     uint32_t keyval = type;
     pref->key = str_sprintf("%" PRIu32, keyval);
@@ -107,40 +210,69 @@ class ESP32Preferences : public ESPPreferences {
     return ESPPreferenceObject(pref);
   }
 
-  bool sync() override {
+  bool sync() override { return this->sync_(false); }
+  bool flush() override { return this->sync_(true); }
+
+  bool sync_(bool force) {
     if (s_pending_save.empty())
       return true;
 
     ESP_LOGD(TAG, "Saving %d preferences to flash...", s_pending_save.size());
     // goal try write all pending saves even if one fails
-    int cached = 0, written = 0, failed = 0;
+    int cached = 0, written = 0, failed = 0, deferred = 0;
+    const uint32_t now = millis();
     esp_err_t last_err = ESP_OK;
     std::string last_key{};
+#ifdef USE_PREFERENCES_RTC_CACHE
+    // Not valid while NVS is written, in case the writes are interrupted
+    s_rtc_cache.magic = 0;
+#endif
 
     // go through vector from back to front (makes erase easier/more efficient)
     for (ssize_t i = s_pending_save.size() - 1; i >= 0; i--) {
-      const auto &save = s_pending_save[i];
+      auto &save = *s_pending_save[i];
+      if (!force && save.written && now - save.last_write < save.min_write_interval) {
+        ESP_LOGV(TAG, "Holding back %s until its minimum write interval passed", save.key.c_str());
+        deferred++;
+        continue;
+      }
       ESP_LOGVV(TAG, "Checking if NVS data %s has changed", save.key.c_str());
       if (is_changed(nvs_handle, save)) {
-        esp_err_t err = nvs_set_blob(nvs_handle, save.key.c_str(), save.data.data(), save.data.size());
-        ESP_LOGV(TAG, "sync: key: %s, len: %d", save.key.c_str(), save.data.size());
+        esp_err_t err = nvs_set_blob(nvs_handle, save.key.c_str(), save.pending_data.data(), save.pending_data.size());
+        ESP_LOGV(TAG, "sync: key: %s, len: %d", save.key.c_str(), save.pending_data.size());
         if (err != 0) {
-          ESP_LOGV(TAG, "nvs_set_blob('%s', len=%u) failed: %s", save.key.c_str(), save.data.size(),
+          ESP_LOGV(TAG, "nvs_set_blob('%s', len=%u) failed: %s", save.key.c_str(), save.pending_data.size(),
                    esp_err_to_name(err));
           failed++;
           last_err = err;
           last_key = save.key;
           continue;
         }
+        save.last_write = now;
+        save.written = true;
         written++;
       } else {
-        ESP_LOGV(TAG, "NVS data not changed skipping %s  len=%u", save.key.c_str(), save.data.size());
+        ESP_LOGV(TAG, "NVS data not changed skipping %s  len=%u", save.key.c_str(), save.pending_data.size());
         cached++;
       }
+      // The value is in NVS now, keep it to compare the next saves against
+#ifdef USE_PREFERENCES_RTC_CACHE
+      rtc_cache_store(save.type, save.pending_data.data(), save.pending_data.size());
+#endif
+      save.stored_data.swap(save.pending_data);
+      save.stored_known = true;
+      save.pending_data.clear();
+      save.pending = false;
       s_pending_save.erase(s_pending_save.begin() + i);
     }
-    ESP_LOGD(TAG, "Saving %d preferences to flash: %d cached, %d written, %d failed", cached + written + failed, cached,
-             written, failed);
+#ifdef USE_PREFERENCES_RTC_CACHE
+    s_rtc_cache.magic = RTC_CACHE_MAGIC;
+#endif
+    this->stats_.writes += written;
+    this->stats_.unchanged += cached;
+    this->stats_.deferred += deferred;
+    ESP_LOGD(TAG, "Saving %d preferences to flash: %d cached, %d written, %d failed, %d held back",
+             cached + written + failed, cached, written, failed, deferred);
     if (failed > 0) {
       ESP_LOGE(TAG, "Error saving %d preferences to flash. Last error=%s for key=%s", failed, esp_err_to_name(last_err),
                last_key.c_str());
@@ -155,26 +287,34 @@ class ESP32Preferences : public ESPPreferences {
 
     return failed == 0;
   }
-  bool is_changed(const uint32_t nvs_handle, const NVSData &to_save) {
-    NVSData stored_data{};
+  bool is_changed(const uint32_t nvs_handle, const ESP32PreferenceBackend &to_save) {
+    if (to_save.stored_known)
+      return to_save.pending_data != to_save.stored_data;
+
+    std::vector<uint8_t> stored_data;
     size_t actual_len;
     esp_err_t err = nvs_get_blob(nvs_handle, to_save.key.c_str(), nullptr, &actual_len);
     if (err != 0) {
       ESP_LOGV(TAG, "nvs_get_blob('%s'): %s - the key might not be set yet", to_save.key.c_str(), esp_err_to_name(err));
       return true;
     }
-    stored_data.data.resize(actual_len);
-    err = nvs_get_blob(nvs_handle, to_save.key.c_str(), stored_data.data.data(), &actual_len);
+    stored_data.resize(actual_len);
+    err = nvs_get_blob(nvs_handle, to_save.key.c_str(), stored_data.data(), &actual_len);
     if (err != 0) {
       ESP_LOGV(TAG, "nvs_get_blob('%s') failed: %s", to_save.key.c_str(), esp_err_to_name(err));
       return true;
     }
-    return to_save.data != stored_data.data;
+    return to_save.pending_data != stored_data;
   }
 
   bool reset() override {
     ESP_LOGD(TAG, "Cleaning up preferences in flash...");
+    for (auto *pref : s_pending_save)
+      pref->pending = false;
     s_pending_save.clear();
+#ifdef USE_PREFERENCES_RTC_CACHE
+    s_rtc_cache.magic = 0;
+#endif
 
     nvs_flash_deinit();
     nvs_flash_erase();
@@ -186,6 +326,9 @@ class ESP32Preferences : public ESPPreferences {
 
 void setup_preferences() {
   auto *prefs = new ESP32Preferences();  // NOLINT(cppcoreguidelines-owning-memory)
+#ifdef USE_PREFERENCES_RTC_CACHE
+  rtc_cache_setup();
+#endif
   prefs->open();
   global_preferences = prefs;
 }
@@ -6,10 +6,13 @@
 
 #include <freertos/task.h>
 
+#include <cinttypes>
+
 namespace esphome {
 namespace esp32_camera {
 
 static const char *const TAG = "esp32_camera";
+static const uint32_t METRICS_INTERVAL_MS = 10000;
 
 /* ---------------- public API (derivated) ---------------- */
 void ESP32Camera::setup() {
@@ -17,6 +20,7 @@ void ESP32Camera::setup() {
 
   /* initialize time to now */
   this->last_update_ = millis();
+  this->last_metrics_time_ = this->last_update_;
 
   /* initialize camera */
   esp_err_t err = esp_camera_init(&this->config_);
@@ -31,8 +35,8 @@ void ESP32Camera::setup() {
   this->update_camera_parameters();
 
   /* initialize RTOS */
-  this->framebuffer_get_queue_ = xQueueCreate(1, sizeof(camera_fb_t *));
-  this->framebuffer_return_queue_ = xQueueCreate(1, sizeof(camera_fb_t *));
+  this->framebuffer_get_queue_ = xQueueCreate(this->config_.fb_count, sizeof(camera_fb_t *));
+  this->framebuffer_return_queue_ = xQueueCreate(this->config_.fb_count, sizeof(camera_fb_t *));
   xTaskCreatePinnedToCore(&ESP32Camera::framebuffer_task,
                           "framebuffer_task",  // name
                           1024,                // stack size
@@ -153,16 +157,22 @@ void ESP32Camera::dump_config() {
 }
 
 void ESP32Camera::loop() {
-  // check if we can return the image
-  if (this->can_return_image_()) {
-    // return image
-    auto *fb = this->current_image_->get_raw_buffer();
-    xQueueSend(this->framebuffer_return_queue_, &fb, portMAX_DELAY);
-    this->current_image_.reset();
+  // return the images that all consumers are done with
+  this->return_images_();
+
+  const uint32_t now = millis();
+  if (now - this->last_metrics_time_ >= METRICS_INTERVAL_MS) {
+    if (this->metrics_frames_ > 0) {
+      const uint32_t elapsed = now - this->last_metrics_time_;
+      ESP_LOGD(TAG, "Captured %" PRIu32 " frames in %" PRIu32 " ms (%.1f fps, %" PRIu32 " kB/s)", this->metrics_frames_,
+               elapsed, this->metrics_frames_ * 1000.0f / elapsed, (uint32_t) (this->metrics_bytes_ / elapsed));
+    }
+    this->last_metrics_time_ = now;
+    this->metrics_frames_ = 0;
+    this->metrics_bytes_ = 0;
   }
 
   // request idle image every idle_update_interval
-  const uint32_t now = millis();
   if (this->idle_update_interval_ != 0 && now - this->last_idle_request_ > this->idle_update_interval_) {
     this->last_idle_request_ = now;
     this->request_image(IDLE);
@@ -171,32 +181,40 @@ void ESP32Camera::loop() {
   // Check if we should fetch a new image
   if (!this->has_requested_image_())
     return;
-  if (this->current_image_.use_count() > 1) {
-    // image is still in use
-    return;
-  }
   if (now - this->last_update_ <= this->max_update_interval_)
     return;
 
-  // request new image
-  camera_fb_t *fb;
-  if (xQueueReceive(this->framebuffer_get_queue_, &fb, 0L) != pdTRUE) {
+  // request new image, the queue is empty while all frame buffers are in use
+  camera_fb_t *fb = nullptr;
+  camera_fb_t *newer_fb;
+  while (xQueueReceive(this->framebuffer_get_queue_, &newer_fb, 0L) == pdTRUE) {
+    if (fb != nullptr) {
+      // only hand out the most recent frame
+      xQueueSend(this->framebuffer_return_queue_, &fb, portMAX_DELAY);
+    }
+    fb = newer_fb;
+    if (fb == nullptr) {
+      ESP_LOGW(TAG, "Got invalid frame from camera!");
+      xQueueSend(this->framebuffer_return_queue_, &fb, portMAX_DELAY);
+    }
+  }
+  if (fb == nullptr) {
     // no frame ready
     ESP_LOGVV(TAG, "No frame ready");
     return;
   }
 
-  if (fb == nullptr) {
-    ESP_LOGW(TAG, "Got invalid frame from camera!");
-    xQueueSend(this->framebuffer_return_queue_, &fb, portMAX_DELAY);
-    return;
-  }
-  this->current_image_ = std::make_shared<CameraImage>(fb, this->single_requesters_ | this->stream_requesters_);
+  auto image = std::make_shared<CameraImage>(fb, this->single_requesters_ | this->stream_requesters_);
+  this->images_.push_back(image);
 
-  ESP_LOGD(TAG, "Got Image: len=%u", fb->len);
-  this->new_image_callback_.call(this->current_image_);
+  ESP_LOGV(TAG, "Got Image: len=%u", fb->len);
+  this->metrics_frames_++;
+  this->metrics_bytes_ += fb->len;
+  // every consumer gets the same image, it is returned once the last of them releases it
+  this->new_image_callback_.call(std::move(image));
   this->last_update_ = now;
   this->single_requesters_ = 0;
+  this->return_images_();
 }
 
 float ESP32Camera::get_setup_priority() const { return setup_priority::DATA; }
@@ -387,14 +405,34 @@ void ESP32Camera::update_camera_parameters() {
 
 /* ---------------- Internal methods ---------------- */
 bool ESP32Camera::has_requested_image_() const { return this->single_requesters_ || this->stream_requesters_; }
-bool ESP32Camera::can_return_image_() const { return this->current_image_.use_count() == 1; }
+void ESP32Camera::return_images_() {
+  auto it = this->images_.begin();
+  while (it != this->images_.end()) {
+    if (it->use_count() == 1) {
+      auto *fb = (*it)->get_raw_buffer();
+      xQueueSend(this->framebuffer_return_queue_, &fb, portMAX_DELAY);
+      it = this->images_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
 void ESP32Camera::framebuffer_task(void *pv) {
+  const uint8_t fb_count = global_esp32_camera->config_.fb_count;
+  uint8_t in_use = 0;
   while (true) {
-    camera_fb_t *framebuffer = esp_camera_fb_get();
+    camera_fb_t *framebuffer;
+    // only block on returned frames while all frame buffers are handed out
+    TickType_t ticks_to_wait = in_use < fb_count ? 0 : portMAX_DELAY;
+    while (xQueueReceive(global_esp32_camera->framebuffer_return_queue_, &framebuffer, ticks_to_wait) == pdTRUE) {
+      // return is no-op for config with 1 fb
+      esp_camera_fb_return(framebuffer);
+      in_use--;
+      ticks_to_wait = 0;
+    }
+    framebuffer = esp_camera_fb_get();
     xQueueSend(global_esp32_camera->framebuffer_get_queue_, &framebuffer, portMAX_DELAY);
-    // return is no-op for config with 1 fb
-    xQueueReceive(global_esp32_camera->framebuffer_return_queue_, &framebuffer, portMAX_DELAY);
-    esp_camera_fb_return(framebuffer);
+    in_use++;
   }
 }
 
@@ -167,7 +167,8 @@ class ESP32Camera : public Component, public EntityBase {
  protected:
   /* internal methods */
   bool has_requested_image_() const;
-  bool can_return_image_() const;
+  /// Hand the frame buffers of the images no consumer holds anymore back to the framebuffer task.
+  void return_images_();
 
   static void framebuffer_task(void *pv);
 
@@ -199,7 +200,8 @@ class ESP32Camera : public Component, public EntityBase {
   uint32_t idle_update_interval_{15000};
 
   esp_err_t init_error_{ESP_OK};
-  std::shared_ptr<CameraImage> current_image_;
+  /// Images handed out to the consumers, up to one per frame buffer.
+  std::vector<std::shared_ptr<CameraImage>> images_;
   uint8_t single_requesters_{0};
   uint8_t stream_requesters_{0};
   QueueHandle_t framebuffer_get_queue_;
@@ -210,6 +212,10 @@ class ESP32Camera : public Component, public EntityBase {
 
   uint32_t last_idle_request_{0};
   uint32_t last_update_{0};
+
+  uint32_t last_metrics_time_{0};
+  uint32_t metrics_frames_{0};
+  uint64_t metrics_bytes_{0};
 };
 
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
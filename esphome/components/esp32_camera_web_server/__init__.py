@@ -1,11 +1,20 @@
+import logging
+
 import esphome.config_validation as cv
 import esphome.codegen as cg
+from esphome.components.esp32_camera import CONF_FRAME_BUFFER_COUNT
+import esphome.final_validate as fv
 from esphome.const import CONF_ID, CONF_PORT, CONF_MODE
 
+_LOGGER = logging.getLogger(__name__)
+
 CODEOWNERS = ["@ayufan"]
 DEPENDENCIES = ["esp32_camera"]
 MULTI_CONF = True
 
+CONF_MAX_CLIENTS = "max_clients"
+CONF_ESP32_CAMERA = "esp32_camera"
+
 esp32_camera_web_server_ns = cg.esphome_ns.namespace("esp32_camera_web_server")
 CameraWebServer = esp32_camera_web_server_ns.class_("CameraWebServer", cg.Component)
 Mode = esp32_camera_web_server_ns.enum("Mode")
@@ -17,12 +26,35 @@ CONFIG_SCHEMA = cv.Schema(
         cv.GenerateID(): cv.declare_id(CameraWebServer),
         cv.Required(CONF_PORT): cv.port,
         cv.Required(CONF_MODE): cv.enum(MODES, upper=True),
+        cv.Optional(CONF_MAX_CLIENTS, default=3): cv.int_range(min=1, max=8),
     },
 ).extend(cv.COMPONENT_SCHEMA)
 
 
+def _final_validate(config):
+    # With a single frame buffer the camera waits until every client started sending
+    # the frame, so one slow client lowers the frame rate of all of them
+    camera = fv.full_config.get().get(CONF_ESP32_CAMERA, {})
+    if (
+        config[CONF_MODE] == "STREAM"
+        and config[CONF_MAX_CLIENTS] > 1
+        and camera.get(CONF_FRAME_BUFFER_COUNT) == 1
+    ):
+        _LOGGER.warning(
+            "esp32_camera_web_server streams to up to %d clients with one frame "
+            "buffer, a slow client holds back the others. Set frame_buffer_count: 2 "
+            "in esp32_camera to capture while frames are being sent",
+            config[CONF_MAX_CLIENTS],
+        )
+    return config
+
+
+FINAL_VALIDATE_SCHEMA = _final_validate
+
+
 async def to_code(config):
     server = cg.new_Pvariable(config[CONF_ID])
     cg.add(server.set_port(config[CONF_PORT]))
     cg.add(server.set_mode(config[CONF_MODE]))
+    cg.add(server.set_max_clients(config[CONF_MAX_CLIENTS]))
     await cg.register_component(server, config)
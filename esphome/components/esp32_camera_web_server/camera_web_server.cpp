@@ -7,14 +7,17 @@
 #include "esphome/core/log.h"
 #include "esphome/core/util.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <esp_http_server.h>
+#include <unistd.h>
 #include <utility>
 
 namespace esphome {
 namespace esp32_camera_web_server {
 
 static const int IMAGE_REQUEST_TIMEOUT = 5000;
+static const uint32_t METRICS_INTERVAL_MS = 10000;
 static const char *const TAG = "esp32_camera_web_server";
 
 #define PART_BOUNDARY "123456789000000000000987654321"
@@ -27,10 +30,6 @@ static const char *const STREAM_HEADER = "HTTP/1.0 200 OK\r\n"
                                          "Content-Type: multipart/x-mixed-replace;boundary=" PART_BOUNDARY "\r\n"
                                          "\r\n"
                                          "--" PART_BOUNDARY "\r\n";
-static const char *const STREAM_ERROR = "Content-Type: text/plain\r\n"
-                                        "\r\n"
-                                        "No frames send.\r\n"
-                                        "--" PART_BOUNDARY "\r\n";
 static const char *const STREAM_PART = "Content-Type: " CONTENT_TYPE "\r\n" CONTENT_LENGTH ": %u\r\n\r\n";
 static const char *const STREAM_BOUNDARY = "\r\n"
                                            "--" PART_BOUNDARY "\r\n";
@@ -50,9 +49,17 @@ void CameraWebServer::setup() {
   httpd_config_t config = HTTPD_DEFAULT_CONFIG();
   config.server_port = this->port_;
   config.ctrl_port = this->port_;
-  config.max_open_sockets = 1;
+  // One more than the stream clients so new requests can still be answered
+  config.max_open_sockets = this->mode_ == STREAM ? this->max_clients_ + 1 : 1;
   config.backlog_conn = 2;
   config.lru_purge_enable = true;
+  // Stream clients are closed under the lock, so loop() never sends to a socket that was closed or reused meanwhile
+  config.global_user_ctx = this;
+  config.global_user_ctx_free_fn = [](void *ctx) {};
+  config.close_fn = [](httpd_handle_t hd, int sockfd) {
+    static_cast<CameraWebServer *>(httpd_get_global_user_ctx(hd))->on_session_closed_(sockfd);
+    close(sockfd);
+  };
 
   if (httpd_start(&this->httpd_, &config) != ESP_OK) {
     mark_failed();
@@ -68,7 +75,14 @@ void CameraWebServer::setup() {
   httpd_register_uri_handler(this->httpd_, &uri);
 
   esp32_camera::global_esp32_camera->add_image_callback([this](std::shared_ptr<esp32_camera::CameraImage> image) {
-    if (this->running_ && image->was_requested_by(esp32_camera::WEB_REQUESTER)) {
+    if (!image->was_requested_by(esp32_camera::WEB_REQUESTER)) {
+      return;
+    }
+    if (this->streaming_) {
+      // The same image is sent to every stream client
+      this->stream_image_ = std::move(image);
+      this->stream_image_sequence_++;
+    } else if (this->running_) {
       this->image_ = std::move(image);
       xSemaphoreGive(this->semaphore_);
     }
@@ -78,8 +92,14 @@ void CameraWebServer::setup() {
 void CameraWebServer::on_shutdown() {
   this->running_ = false;
   this->image_ = nullptr;
+  this->stream_image_ = nullptr;
+  // Closes the stream clients' sessions
   httpd_stop(this->httpd_);
   this->httpd_ = nullptr;
+  {
+    LockGuard guard(this->lock_);
+    this->stream_clients_.clear();
+  }
   vSemaphoreDelete(this->semaphore_);
   this->semaphore_ = nullptr;
 }
@@ -89,6 +109,7 @@ void CameraWebServer::dump_config() {
   ESP_LOGCONFIG(TAG, "  Port: %d", this->port_);
   if (this->mode_ == STREAM) {
     ESP_LOGCONFIG(TAG, "  Mode: stream");
+    ESP_LOGCONFIG(TAG, "  Max Clients: %u", this->max_clients_);
   } else {
     ESP_LOGCONFIG(TAG, "  Mode: snapshot");
   }
@@ -104,6 +125,150 @@ void CameraWebServer::loop() {
   if (!this->running_) {
     this->image_ = nullptr;
   }
+  if (this->mode_ != STREAM) {
+    return;
+  }
+
+  LockGuard guard(this->lock_);
+  this->remove_closed_clients_();
+
+  const bool streaming = !this->stream_clients_.empty();
+  if (streaming != this->streaming_) {
+    this->streaming_ = streaming;
+    if (streaming) {
+      esp32_camera::global_esp32_camera->start_stream(esphome::esp32_camera::WEB_REQUESTER);
+      this->high_freq_.start();
+      this->last_metrics_time_ = millis();
+      this->metrics_frames_ = 0;
+      this->metrics_bytes_ = 0;
+    } else {
+      esp32_camera::global_esp32_camera->stop_stream(esphome::esp32_camera::WEB_REQUESTER);
+      this->high_freq_.stop();
+      this->stream_image_ = nullptr;
+    }
+  }
+  if (!streaming) {
+    return;
+  }
+
+  bool all_started = true;
+  for (auto &client : this->stream_clients_) {
+    if (client->closing || client->closed) {
+      continue;
+    }
+    if (!this->send_to_client_(client.get())) {
+      // The HTTP server closes the session, the client is removed once it did
+      client->closing = true;
+      httpd_sess_trigger_close(this->httpd_, client->fd);
+      continue;
+    }
+    if (client->image_sequence != this->stream_image_sequence_) {
+      all_started = false;
+    }
+  }
+  if (all_started) {
+    // Return the frame buffer to the camera as soon as possible
+    this->stream_image_ = nullptr;
+  }
+
+  this->log_metrics_();
+}
+
+bool CameraWebServer::send_to_client_(StreamClient *client) {
+  while (true) {
+    const char *data;
+    size_t length;
+    const bool sending_pending = client->pending_offset < client->pending.size();
+    if (sending_pending) {
+      data = client->pending.data() + client->pending_offset;
+      length = client->pending.size() - client->pending_offset;
+    } else if (client->image_reader.available() > 0) {
+      data = (const char *) client->image_reader.peek_data_buffer();
+      length = client->image_reader.available();
+    } else if (this->stream_image_ != nullptr && client->image_sequence != this->stream_image_sequence_) {
+      // Continue with the latest image, skipping those captured while the previous one was sent
+      if (client->image_sequence != 0) {
+        client->skipped_frames += this->stream_image_sequence_ - client->image_sequence - 1;
+      }
+      client->image_sequence = this->stream_image_sequence_;
+      client->image_reader.set_image(this->stream_image_);
+
+      char part_buf[64];
+      size_t hlen = snprintf(part_buf, sizeof(part_buf), STREAM_PART, this->stream_image_->get_data_length());
+      client->pending.assign(part_buf, hlen);
+      client->pending_offset = 0;
+      continue;
+    } else {
+      return true;
+    }
+
+    if (client->closed) {
+      // The HTTP server closed the session, the socket may already belong to another one
+      return true;
+    }
+    int sent = httpd_socket_send(this->httpd_, client->fd, data, length, MSG_DONTWAIT);
+    if (sent == HTTPD_SOCK_ERR_TIMEOUT) {
+      // The socket's send buffer is full
+      return true;
+    }
+    if (sent < 0) {
+      return false;
+    }
+    client->bytes += sent;
+    this->metrics_bytes_ += sent;
+
+    if (sending_pending) {
+      client->pending_offset += sent;
+    } else {
+      client->image_reader.consume_data(sent);
+      if (client->image_reader.available() == 0) {
+        client->image_reader.return_image();
+        client->pending = STREAM_BOUNDARY;
+        client->pending_offset = 0;
+        client->frames++;
+        this->metrics_frames_++;
+      }
+    }
+  }
+}
+
+void CameraWebServer::on_session_closed_(int sockfd) {
+  LockGuard guard(this->lock_);
+  for (auto &client : this->stream_clients_) {
+    if (client->fd == sockfd) {
+      client->closed = true;
+    }
+  }
+}
+
+void CameraWebServer::remove_closed_clients_() {
+  auto it = this->stream_clients_.begin();
+  while (it != this->stream_clients_.end()) {
+    StreamClient *client = it->get();
+    if (!client->closed) {
+      ++it;
+      continue;
+    }
+    const uint32_t duration = std::max<uint32_t>(millis() - client->connected_at, 1);
+    ESP_LOGI(TAG, "STREAM: closed. Frames: %" PRIu32 " (%" PRIu32 " skipped), %.1f fps, %" PRIu32 " kB/s",
+             client->frames, client->skipped_frames, client->frames * 1000.0f / duration,
+             (uint32_t) (client->bytes / duration));
+    it = this->stream_clients_.erase(it);
+  }
+}
+
+void CameraWebServer::log_metrics_() {
+  const uint32_t now = millis();
+  const uint32_t elapsed = now - this->last_metrics_time_;
+  if (elapsed < METRICS_INTERVAL_MS) {
+    return;
+  }
+  ESP_LOGD(TAG, "MJPG: %zu clients, %" PRIu32 " frames sent (%.1f fps), %" PRIu32 " kB/s",
+           this->stream_clients_.size(), this->metrics_frames_, this->metrics_frames_ * 1000.0f / elapsed,
+           (uint32_t) (this->metrics_bytes_ / elapsed));
+  this->last_metrics_time_ = now;
+  this->metrics_frames_ = 0;
+  this->metrics_bytes_ = 0;
 }
 
 std::shared_ptr<esphome::esp32_camera::CameraImage> CameraWebServer::wait_for_image_() {
@@ -122,21 +287,20 @@ std::shared_ptr<esphome::esp32_camera::CameraImage> CameraWebServer::wait_for_im
 esp_err_t CameraWebServer::handler_(struct httpd_req *req) {
   esp_err_t res = ESP_FAIL;
 
-  this->image_ = nullptr;
-  this->running_ = true;
-
   switch (this->mode_) {
     case STREAM:
       res = this->streaming_handler_(req);
       break;
 
     case SNAPSHOT:
+      this->image_ = nullptr;
+      this->running_ = true;
       res = this->snapshot_handler_(req);
+      this->running_ = false;
+      this->image_ = nullptr;
       break;
   }
 
-  this->running_ = false;
-  this->image_ = nullptr;
   return res;
 }
 
@@ -155,59 +319,33 @@ static esp_err_t httpd_send_all(httpd_req_t *r, const char *buf, size_t buf_len)
 }
 
 esp_err_t CameraWebServer::streaming_handler_(struct httpd_req *req) {
-  esp_err_t res = ESP_OK;
-  char part_buf[64];
+  LockGuard guard(this->lock_);
+  size_t clients = std::count_if(this->stream_clients_.begin(), this->stream_clients_.end(),
+                                 [](const std::unique_ptr<StreamClient> &client) { return !client->closing; });
+  if (clients >= this->max_clients_) {
+    ESP_LOGW(TAG, "STREAM: refusing client, already streaming to %zu clients", clients);
+    httpd_resp_set_status(req, "503 Service Unavailable");
+    httpd_resp_send(req, nullptr, 0);
+    return ESP_OK;
+  }
 
   // This manually constructs HTTP response to avoid chunked encoding
   // which is not supported by some clients
 
-  res = httpd_send_all(req, STREAM_HEADER, strlen(STREAM_HEADER));
+  esp_err_t res = httpd_send_all(req, STREAM_HEADER, strlen(STREAM_HEADER));
   if (res != ESP_OK) {
     ESP_LOGW(TAG, "STREAM: failed to set HTTP header");
     return res;
   }
 
-  uint32_t last_frame = millis();
-  uint32_t frames = 0;
-
-  esp32_camera::global_esp32_camera->start_stream(esphome::esp32_camera::WEB_REQUESTER);
-
-  while (res == ESP_OK && this->running_) {
-    auto image = this->wait_for_image_();
+  // The frames are sent from loop(), the session stays open after returning
+  auto client = make_unique<StreamClient>();
+  client->fd = httpd_req_to_sockfd(req);
+  client->connected_at = millis();
+  this->stream_clients_.push_back(std::move(client));
 
-    if (!image) {
-      ESP_LOGW(TAG, "STREAM: failed to acquire frame");
-      res = ESP_FAIL;
-    }
-    if (res == ESP_OK) {
-      size_t hlen = snprintf(part_buf, 64, STREAM_PART, image->get_data_length());
-      res = httpd_send_all(req, part_buf, hlen);
-    }
-    if (res == ESP_OK) {
-      res = httpd_send_all(req, (const char *) image->get_data_buffer(), image->get_data_length());
-    }
-    if (res == ESP_OK) {
-      res = httpd_send_all(req, STREAM_BOUNDARY, strlen(STREAM_BOUNDARY));
-    }
-    if (res == ESP_OK) {
-      frames++;
-      int64_t frame_time = millis() - last_frame;
-      last_frame = millis();
-
-      ESP_LOGD(TAG, "MJPG: %" PRIu32 "B %" PRIu32 "ms (%.1ffps)", (uint32_t) image->get_data_length(),
-               (uint32_t) frame_time, 1000.0 / (uint32_t) frame_time);
-    }
-  }
-
-  if (!frames) {
-    res = httpd_send_all(req, STREAM_ERROR, strlen(STREAM_ERROR));
-  }
-
-  esp32_camera::global_esp32_camera->stop_stream(esphome::esp32_camera::WEB_REQUESTER);
-
-  ESP_LOGI(TAG, "STREAM: closed. Frames: %" PRIu32, frames);
-
-  return res;
+  ESP_LOGI(TAG, "STREAM: opened. Clients: %zu", clients + 1);
+  return ESP_OK;
 }
 
 esp_err_t CameraWebServer::snapshot_handler_(struct httpd_req *req) {
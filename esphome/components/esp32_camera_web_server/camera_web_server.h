@@ -2,7 +2,11 @@
 
 #ifdef USE_ESP32
 
+#include <atomic>
 #include <cinttypes>
+#include <memory>
+#include <string>
+#include <vector>
 #include <freertos/FreeRTOS.h>
 #include <freertos/semphr.h>
 
@@ -18,6 +22,28 @@ namespace esp32_camera_web_server {
 
 enum Mode { STREAM, SNAPSHOT };
 
+/// A client receiving the MJPEG stream. Frames are sent from the main loop without blocking; a client that can't keep
+/// up finishes its current frame and then continues with the latest one, skipping those in between.
+struct StreamClient {
+  int fd;
+  /// Set from the HTTP server task under the lock before the socket is closed, after which nothing is sent anymore
+  /// and the client can be removed.
+  std::atomic<bool> closed{false};
+  /// Set once sending failed and the session is being closed.
+  bool closing{false};
+  /// Part header or boundary still to be sent before or after the image data.
+  std::string pending;
+  size_t pending_offset{0};
+  esp32_camera::CameraImageReader image_reader;
+  /// Sequence number of the last image this client started sending.
+  uint32_t image_sequence{0};
+
+  uint32_t connected_at;
+  uint32_t frames{0};
+  uint32_t skipped_frames{0};
+  uint64_t bytes{0};
+};
+
 class CameraWebServer : public Component {
  public:
   CameraWebServer();
@@ -29,6 +55,7 @@ class CameraWebServer : public Component {
   float get_setup_priority() const override;
   void set_port(uint16_t port) { this->port_ = port; }
   void set_mode(Mode mode) { this->mode_ = mode; }
+  void set_max_clients(uint8_t max_clients) { this->max_clients_ = max_clients; }
   void loop() override;
 
  protected:
@@ -37,12 +64,35 @@ class CameraWebServer : public Component {
   esp_err_t streaming_handler_(struct httpd_req *req);
   esp_err_t snapshot_handler_(struct httpd_req *req);
 
+  /// @brief Sends as much to the client as its socket accepts without blocking.
+  /// @return False if the connection failed.
+  bool send_to_client_(StreamClient *client);
+  /// @brief Marks the stream client of a session the HTTP server is closing as closed, called from its task.
+  void on_session_closed_(int sockfd);
+  /// @brief Closes the connections that failed and forgets the ones the HTTP server closed.
+  void remove_closed_clients_();
+  void log_metrics_();
+
   uint16_t port_{0};
   void *httpd_{nullptr};
   SemaphoreHandle_t semaphore_;
   std::shared_ptr<esphome::esp32_camera::CameraImage> image_;
   bool running_{false};
   Mode mode_{STREAM};
+  uint8_t max_clients_{3};
+
+  /// Guards stream_clients_ against the HTTP server task.
+  Mutex lock_;
+  std::vector<std::unique_ptr<StreamClient>> stream_clients_;
+  bool streaming_{false};
+  HighFrequencyLoopRequester high_freq_;
+  /// Latest image, held until every client has started sending it.
+  std::shared_ptr<esphome::esp32_camera::CameraImage> stream_image_;
+  uint32_t stream_image_sequence_{0};
+
+  uint32_t last_metrics_time_{0};
+  uint32_t metrics_frames_{0};
+  uint64_t metrics_bytes_{0};
 };
 
 }  // namespace esp32_camera_web_server
@@ -22,6 +22,7 @@ from esphome.helpers import copy_file_if_changed
 from .const import (
     CONF_RESTORE_FROM_FLASH,
     CONF_EARLY_PIN_INIT,
+    CONF_PREFERENCES_LOG,
     KEY_BOARD,
     KEY_ESP8266,
     KEY_FLASH_SIZE,
@@ -167,6 +168,8 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(CONF_FRAMEWORK, default={}): ARDUINO_FRAMEWORK_SCHEMA,
             cv.Optional(CONF_RESTORE_FROM_FLASH, default=False): cv.boolean,
             cv.Optional(CONF_EARLY_PIN_INIT, default=True): cv.boolean,
+            # Append to the preferences sector, it is only erased when full
+            cv.Optional(CONF_PREFERENCES_LOG, default=False): cv.boolean,
             cv.Optional(CONF_BOARD_FLASH_MODE, default="dout"): cv.one_of(
                 *BUILD_FLASH_MODES, lower=True
             ),
@@ -216,6 +219,9 @@ async def to_code(config):
     if config[CONF_RESTORE_FROM_FLASH]:
         cg.add_define("USE_ESP8266_PREFERENCES_FLASH")
 
+    if config[CONF_PREFERENCES_LOG]:
+        cg.add_define("USE_ESP8266_PREFERENCES_LOG")
+
     if config[CONF_EARLY_PIN_INIT]:
         cg.add_define("USE_ESP8266_EARLY_PIN_INIT")
 
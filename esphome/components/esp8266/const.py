@@ -5,6 +5,7 @@ KEY_BOARD = "board"
 KEY_PIN_INITIAL_STATES = "pin_initial_states"
 CONF_RESTORE_FROM_FLASH = "restore_from_flash"
 CONF_EARLY_PIN_INIT = "early_pin_init"
+CONF_PREFERENCES_LOG = "preferences_log"
 KEY_FLASH_SIZE = "flash_size"
 
 # esp8266 namespace is already defined by arduino, manually prefix esphome
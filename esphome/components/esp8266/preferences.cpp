@@ -6,12 +6,15 @@ extern "C" {
 }
 
 #include "esphome/core/defines.h"
+#include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 #include "esphome/core/preferences.h"
 #include "preferences.h"
 
+#include <algorithm>
 #include <cstring>
+#include <memory>
 #include <vector>
 
 namespace esphome {
@@ -34,6 +37,15 @@ static const uint32_t ESP8266_FLASH_STORAGE_SIZE = 128;
 static const uint32_t ESP8266_FLASH_STORAGE_SIZE = 64;
 #endif
 
+#ifdef USE_ESP8266_PREFERENCES_LOG
+// The sector holds copies of the storage, each in a slot of magic, storage and CRC. Syncs write the next free slot,
+// the sector is only erased when all slots are used. The last slot with a valid CRC is loaded.
+static const uint32_t ESP8266_FLASH_LOG_MAGIC = 0x50524546;
+static const uint32_t ESP8266_FLASH_LOG_SLOT_SIZE = ESP8266_FLASH_STORAGE_SIZE + 2;  // in words
+static const uint32_t ESP8266_FLASH_LOG_SLOT_COUNT = SPI_FLASH_SEC_SIZE / 4 / ESP8266_FLASH_LOG_SLOT_SIZE;
+static uint32_t s_flash_log_next_slot = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+#endif
+
 static inline bool esp_rtc_user_mem_read(uint32_t index, uint32_t *dest) {
   if (index >= ESP_RTC_USER_MEM_SIZE_WORDS) {
     return false;
@@ -67,23 +79,35 @@ static uint32_t get_esp8266_flash_sector() {
 }
 static uint32_t get_esp8266_flash_address() { return get_esp8266_flash_sector() * SPI_FLASH_SEC_SIZE; }
 
+static inline uint32_t add_to_crc(uint32_t crc, uint32_t value) { return crc ^ ((value * 2654435769UL) >> 1); }
+
 template<class It> uint32_t calculate_crc(It first, It last, uint32_t type) {
   uint32_t crc = type;
   while (first != last) {
-    crc ^= (*first++ * 2654435769UL) >> 1;
+    crc = add_to_crc(crc, *first++);
   }
   return crc;
 }
 
-static bool save_to_flash(size_t offset, const uint32_t *data, size_t len) {
+/// Word index of the data, the last word is padded with zeros.
+static inline uint32_t get_data_word(const uint8_t *data, size_t len, size_t index) {
+  uint32_t word = 0;
+  memcpy(&word, data + index * 4, std::min<size_t>(4, len - index * 4));
+  return word;
+}
+
+static bool save_to_flash(size_t offset, const uint32_t *data, size_t len, bool *changed = nullptr) {
   for (uint32_t i = 0; i < len; i++) {
     uint32_t j = offset + i;
     if (j >= ESP8266_FLASH_STORAGE_SIZE)
       return false;
     uint32_t v = data[i];
     uint32_t *ptr = &s_flash_storage[j];
-    if (*ptr != v)
+    if (*ptr != v) {
       s_flash_dirty = true;
+      if (changed != nullptr)
+        *changed = true;
+    }
     *ptr = v;
   }
   return true;
@@ -115,53 +139,140 @@ static bool load_from_rtc(size_t offset, uint32_t *data, size_t len) {
   return true;
 }
 
+class ESP8266PreferenceBackend;
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+static std::vector<ESP8266PreferenceBackend *> s_deferred_saves;
+/// Preferences changed in the flash storage since it was last written to flash.
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+static std::vector<ESP8266PreferenceBackend *> s_unflushed_saves;
+
 class ESP8266PreferenceBackend : public ESPPreferenceBackend {
  public:
   size_t offset = 0;
   uint32_t type = 0;
   bool in_flash = false;
   size_t length_words = 0;
+  uint32_t min_write_interval = 0;
+  /// Time the value was last written to flash, the minimum write interval starts then.
+  uint32_t last_write = 0;
+  bool written = false;
+  bool unflushed = false;
+  /// Words held back by the minimum write interval, including the CRC.
+  std::unique_ptr<uint32_t[]> deferred;
+  bool is_deferred = false;
+  /// Saves that did not change the words in flash.
+  static uint32_t unchanged_saves;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 
   bool save(const uint8_t *data, size_t len) override {
     if ((len + 3) / 4 != length_words) {
       return false;
     }
-    std::vector<uint32_t> buffer;
-    buffer.resize(length_words + 1);
-    memcpy(buffer.data(), data, len);
-    buffer[buffer.size() - 1] = calculate_crc(buffer.begin(), buffer.end() - 1, type);
 
-    if (in_flash) {
-      return save_to_flash(offset, buffer.data(), buffer.size());
-    } else {
-      return save_to_rtc(offset, buffer.data(), buffer.size());
+    uint32_t *destination = nullptr;
+    // Once held back, the value is written by the next sync after the interval
+    if (this->is_deferred ||
+        (this->in_flash && this->written && millis() - this->last_write < this->min_write_interval)) {
+      if (!this->deferred)
+        this->deferred = make_unique<uint32_t[]>(length_words + 1);
+      if (!this->is_deferred) {
+        this->is_deferred = true;
+        s_deferred_saves.push_back(this);
+      }
+      destination = this->deferred.get();
     }
+
+    bool changed = false;
+    uint32_t crc = type;
+    for (size_t i = 0; i <= length_words; i++) {
+      uint32_t word = crc;
+      if (i < length_words) {
+        word = get_data_word(data, len, i);
+        crc = add_to_crc(crc, word);
+      }
+
+      if (destination != nullptr) {
+        destination[i] = word;
+      } else if (in_flash) {
+        if (!save_to_flash(offset + i, &word, 1, &changed))
+          return false;
+      } else if (!save_to_rtc(offset + i, &word, 1)) {
+        return false;
+      }
+    }
+
+    if (this->in_flash && destination == nullptr) {
+      if (changed) {
+        this->mark_unflushed_();
+      } else {
+        unchanged_saves++;
+      }
+    }
+    return true;
   }
   bool load(uint8_t *data, size_t len) override {
     if ((len + 3) / 4 != length_words) {
       return false;
     }
-    std::vector<uint32_t> buffer;
-    buffer.resize(length_words + 1);
-    bool ret;
-    if (in_flash) {
-      ret = load_from_flash(offset, buffer.data(), buffer.size());
-    } else {
-      ret = load_from_rtc(offset, buffer.data(), buffer.size());
-    }
-    if (!ret)
-      return false;
 
-    uint32_t crc = calculate_crc(buffer.begin(), buffer.end() - 1, type);
-    if (buffer[buffer.size() - 1] != crc) {
+    // Check the CRC before anything is copied to data
+    uint32_t crc = type;
+    uint32_t word = 0;
+    for (size_t i = 0; i <= length_words; i++) {
+      if (!this->load_word_(i, &word))
+        return false;
+      if (i < length_words)
+        crc = add_to_crc(crc, word);
+    }
+    if (word != crc) {
       return false;
     }
 
-    memcpy(data, buffer.data(), len);
+    for (size_t i = 0; i < length_words; i++) {
+      this->load_word_(i, &word);
+      memcpy(data + i * 4, &word, std::min<size_t>(4, len - i * 4));
+    }
     return true;
   }
+  void set_min_write_interval(uint32_t interval_ms) override { this->min_write_interval = interval_ms; }
+
+  /// Moves the words held back by the minimum write interval to the flash storage.
+  void apply_deferred() {
+    bool changed = false;
+    save_to_flash(offset, this->deferred.get(), length_words + 1, &changed);
+    if (changed)
+      this->mark_unflushed_();
+    this->is_deferred = false;
+  }
+
+  /// Called once the flash storage was written to flash.
+  void mark_flushed(uint32_t now) {
+    this->last_write = now;
+    this->written = true;
+    this->unflushed = false;
+  }
+
+ protected:
+  void mark_unflushed_() {
+    if (!this->unflushed) {
+      this->unflushed = true;
+      s_unflushed_saves.push_back(this);
+    }
+  }
+
+  bool load_word_(size_t index, uint32_t *word) {
+    if (this->is_deferred) {
+      *word = this->deferred[index];
+      return true;
+    }
+    if (in_flash)
+      return load_from_flash(offset + index, word, 1);
+    return load_from_rtc(offset + index, word, 1);
+  }
 };
 
+uint32_t ESP8266PreferenceBackend::unchanged_saves = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
 class ESP8266Preferences : public ESPPreferences {
  public:
   uint32_t current_offset = 0;
@@ -171,10 +282,14 @@ class ESP8266Preferences : public ESPPreferences {
     s_flash_storage = new uint32_t[ESP8266_FLASH_STORAGE_SIZE];  // NOLINT
     ESP_LOGVV(TAG, "Loading preferences from flash...");
 
+#ifdef USE_ESP8266_PREFERENCES_LOG
+    this->load_log_();
+#else
     {
       InterruptLock lock;
       spi_flash_read(get_esp8266_flash_address(), s_flash_storage, ESP8266_FLASH_STORAGE_SIZE * 4);
     }
+#endif
   }
 
   ESPPreferenceObject make_preference(size_t length, uint32_t type, bool in_flash) override {
@@ -229,13 +344,33 @@ class ESP8266Preferences : public ESPPreferences {
 #endif
   }
 
-  bool sync() override {
+  bool sync() override { return this->sync_(false); }
+  bool flush() override { return this->sync_(true); }
+
+  bool sync_(bool force) {
+    const uint32_t now = millis();
+    for (size_t i = 0; i < s_deferred_saves.size();) {
+      auto *pref = s_deferred_saves[i];
+      if (force || now - pref->last_write >= pref->min_write_interval) {
+        pref->apply_deferred();
+        s_deferred_saves.erase(s_deferred_saves.begin() + i);
+      } else {
+        this->stats_.deferred++;
+        i++;
+      }
+    }
+    this->stats_.unchanged = ESP8266PreferenceBackend::unchanged_saves;
+
     if (!s_flash_dirty)
       return true;
     if (s_prevent_write)
       return false;
 
     ESP_LOGD(TAG, "Saving preferences to flash...");
+#ifdef USE_ESP8266_PREFERENCES_LOG
+    if (!this->write_log_())
+      return false;
+#else
     SpiFlashOpResult erase_res, write_res = SPI_FLASH_RESULT_OK;
     {
       InterruptLock lock;
@@ -248,12 +383,18 @@ class ESP8266Preferences : public ESPPreferences {
       ESP_LOGE(TAG, "Erase ESP8266 flash failed!");
       return false;
     }
+    this->stats_.erases++;
     if (write_res != SPI_FLASH_RESULT_OK) {
       ESP_LOGE(TAG, "Write ESP8266 flash failed!");
       return false;
     }
+#endif
+    this->stats_.writes++;
 
     s_flash_dirty = false;
+    for (auto *pref : s_unflushed_saves)
+      pref->mark_flushed(now);
+    s_unflushed_saves.clear();
     return true;
   }
 
@@ -269,10 +410,112 @@ class ESP8266Preferences : public ESPPreferences {
       return false;
     }
 
+#ifdef USE_ESP8266_PREFERENCES_LOG
+    s_flash_log_next_slot = 0;
+#endif
     // Protect flash from writing till restart
     s_prevent_write = true;
     return true;
   }
+
+#ifdef USE_ESP8266_PREFERENCES_LOG
+ protected:
+  static uint32_t get_slot_address_(uint32_t slot) {
+    return get_esp8266_flash_address() + slot * ESP8266_FLASH_LOG_SLOT_SIZE * 4;
+  }
+
+  void load_log_() {
+    uint32_t magic = 0xFFFFFFFF;
+    // Slots are written in order, the first erased one is the next to write
+    s_flash_log_next_slot = 0;
+    while (s_flash_log_next_slot < ESP8266_FLASH_LOG_SLOT_COUNT) {
+      {
+        InterruptLock lock;
+        spi_flash_read(get_slot_address_(s_flash_log_next_slot), &magic, 4);
+      }
+      if (s_flash_log_next_slot == 0 && magic != ESP8266_FLASH_LOG_MAGIC) {
+        this->load_without_log_();
+        return;
+      }
+      if (magic == 0xFFFFFFFF)
+        break;
+      s_flash_log_next_slot++;
+    }
+
+    // Slots of interrupted writes have no valid CRC
+    for (uint32_t slot = s_flash_log_next_slot; slot > 0; slot--) {
+      uint32_t crc;
+      {
+        InterruptLock lock;
+        spi_flash_read(get_slot_address_(slot - 1) + 4, s_flash_storage, ESP8266_FLASH_STORAGE_SIZE * 4);
+        spi_flash_read(get_slot_address_(slot - 1) + 4 + ESP8266_FLASH_STORAGE_SIZE * 4, &crc, 4);
+      }
+      if (crc ==
+          calculate_crc(s_flash_storage, s_flash_storage + ESP8266_FLASH_STORAGE_SIZE, ESP8266_FLASH_LOG_MAGIC)) {
+        ESP_LOGVV(TAG, "Loaded preferences from slot %u", slot - 1);
+        return;
+      }
+    }
+    // Like erased flash, no preference has a valid CRC
+    memset(s_flash_storage, 0xFF, ESP8266_FLASH_STORAGE_SIZE * 4);
+  }
+
+  /// Loads a sector that is erased or was written in the layout without log.
+  void load_without_log_() {
+    {
+      InterruptLock lock;
+      spi_flash_read(get_esp8266_flash_address(), s_flash_storage, ESP8266_FLASH_STORAGE_SIZE * 4);
+    }
+    // Word 0 belongs to the first preference, which is often never saved (like the WiFi settings of networks in the
+    // configuration), so the whole storage has to be erased for the sector to be empty
+    const bool erased = std::all_of(s_flash_storage, s_flash_storage + ESP8266_FLASH_STORAGE_SIZE,
+                                    [](uint32_t word) { return word == 0xFFFFFFFF; });
+    if (erased) {
+      s_flash_log_next_slot = 0;
+      return;
+    }
+    // Keep the loaded values and start the log with the first sync, which erases the sector
+    ESP_LOGD(TAG, "Converting preferences in flash to log");
+    s_flash_log_next_slot = ESP8266_FLASH_LOG_SLOT_COUNT;
+  }
+
+  bool write_log_() {
+    uint32_t magic = ESP8266_FLASH_LOG_MAGIC;
+    uint32_t crc = calculate_crc(s_flash_storage, s_flash_storage + ESP8266_FLASH_STORAGE_SIZE, magic);
+    SpiFlashOpResult erase_res = SPI_FLASH_RESULT_OK, write_res;
+    const bool erase = s_flash_log_next_slot >= ESP8266_FLASH_LOG_SLOT_COUNT;
+    {
+      InterruptLock lock;
+      if (erase) {
+        erase_res = spi_flash_erase_sector(get_esp8266_flash_sector());
+        if (erase_res == SPI_FLASH_RESULT_OK)
+          s_flash_log_next_slot = 0;
+      }
+      // The magic is written first, so the slot counts as used even if the write is interrupted
+      const uint32_t address = get_slot_address_(s_flash_log_next_slot);
+      write_res = erase_res;
+      if (write_res == SPI_FLASH_RESULT_OK)
+        write_res = spi_flash_write(address, &magic, 4);
+      if (write_res == SPI_FLASH_RESULT_OK)
+        write_res = spi_flash_write(address + 4, s_flash_storage, ESP8266_FLASH_STORAGE_SIZE * 4);
+      if (write_res == SPI_FLASH_RESULT_OK)
+        write_res = spi_flash_write(address + 4 + ESP8266_FLASH_STORAGE_SIZE * 4, &crc, 4);
+    }
+    if (erase_res != SPI_FLASH_RESULT_OK) {
+      ESP_LOGE(TAG, "Erase ESP8266 flash failed!");
+      return false;
+    }
+    if (erase)
+      this->stats_.erases++;
+    // A failed write still used the slot
+    s_flash_log_next_slot++;
+    if (write_res != SPI_FLASH_RESULT_OK) {
+      ESP_LOGE(TAG, "Write ESP8266 flash failed!");
+      return false;
+    }
+    return true;
+  }
+#endif
 };
 
 void setup_preferences() {
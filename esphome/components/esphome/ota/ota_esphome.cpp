@@ -7,12 +7,15 @@
 #include "esphome/components/ota/ota_backend_arduino_esp8266.h"
 #include "esphome/components/ota/ota_backend_arduino_libretiny.h"
 #include "esphome/components/ota/ota_backend_arduino_rp2040.h"
+#include "esphome/components/ota/ota_backend_delta.h"
 #include "esphome/components/ota/ota_backend_esp_idf.h"
+#include "esphome/components/ota/ota_pipeline.h"
 #include "esphome/core/application.h"
 #include "esphome/core/hal.h"
 #include "esphome/core/log.h"
 #include "esphome/core/util.h"
 
+#include <algorithm>
 #include <cerrno>
 #include <cstdio>
 
@@ -26,7 +29,7 @@ void ESPHomeOTAComponent::setup() {
   ota::register_ota_platform(this);
 #endif
 
-  server_ = socket::socket_ip(SOCK_STREAM, 0);
+  server_ = socket::socket_ip_loop_monitored(SOCK_STREAM, 0);
   if (server_ == nullptr) {
     ESP_LOGW(TAG, "Could not create socket");
     this->mark_failed();
@@ -83,6 +86,8 @@ void ESPHomeOTAComponent::dump_config() {
 void ESPHomeOTAComponent::loop() { this->handle_(); }
 
 static const uint8_t FEATURE_SUPPORTS_COMPRESSION = 0x01;
+static const uint8_t FEATURE_SUPPORTS_DELTA = 0x02;
+static const uint8_t DELTA_MODE_PATCH = 0x01;
 
 void ESPHomeOTAComponent::handle_() {
   ota::OTAResponseTypes error_code = ota::OTA_RESPONSE_ERROR_UNKNOWN;
@@ -95,11 +100,27 @@ void ESPHomeOTAComponent::handle_() {
   uint8_t ota_features;
   std::unique_ptr<ota::OTABackend> backend;
   (void) ota_features;
+  // Data is written in blocks, either buf or the buffers of the pipeline
+  uint8_t *block = buf;
+  size_t block_size = sizeof(buf);
+  size_t block_length = 0;
+  uint32_t receive_start;
+  uint32_t receive_time;
+  uint32_t end_start;
+#ifdef USE_ESP32
+  // Writes to flash from a separate task while the next data is received
+  ota::OTAPipeline pipeline;
+  bool pipelined = false;
+  // The client can send a patch against the running image instead of the whole image
+  uint8_t image_hash[ota::DeltaOTABackend::IMAGE_HASH_SIZE];
+  bool delta_supported = false;
+  bool delta = false;
+#endif
 #if USE_OTA_VERSION == 2
   size_t size_acknowledged = 0;
 #endif
 
-  if (client_ == nullptr) {
+  if (client_ == nullptr && server_->ready()) {
     struct sockaddr_storage source_addr;
     socklen_t addr_len = sizeof(source_addr);
     client_ = server_->accept((struct sockaddr *) &source_addr, &addr_len);
@@ -152,6 +173,12 @@ void ESPHomeOTAComponent::handle_() {
   if ((ota_features & FEATURE_SUPPORTS_COMPRESSION) != 0 && backend->supports_compression()) {
     buf[0] = ota::OTA_RESPONSE_SUPPORTS_COMPRESSION;
   }
+#ifdef USE_ESP32
+  else if ((ota_features & FEATURE_SUPPORTS_DELTA) != 0 && ota::DeltaOTABackend::get_running_image_hash(image_hash)) {
+    buf[0] = ota::OTA_RESPONSE_SUPPORTS_DELTA;
+    delta_supported = true;
+  }
+#endif
 
   this->writeall_(buf, 1);
 
@@ -218,6 +245,23 @@ void ESPHomeOTAComponent::handle_() {
   buf[0] = ota::OTA_RESPONSE_AUTH_OK;
   this->writeall_(buf, 1);
 
+#ifdef USE_ESP32
+  if (delta_supported) {
+    // Send the hash of the running image, 32 bytes, after auth so it is only known to authorized clients
+    this->writeall_(image_hash, sizeof(image_hash));
+    // Read the mode, 1 byte: whether a patch against this image is sent
+    if (!this->readall_(buf, 1)) {
+      ESP_LOGW(TAG, "Reading delta mode failed");
+      goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
+    }
+    delta = buf[0] == DELTA_MODE_PATCH;
+    if (delta) {
+      ESP_LOGD(TAG, "Receiving a patch against the running firmware");
+      backend = make_unique<ota::DeltaOTABackend>(std::move(backend));
+    }
+  }
+#endif
+
   // Read size, 4 bytes MSB first
   if (!this->readall_(buf, 4)) {
     ESP_LOGW(TAG, "Reading size failed");
@@ -252,10 +296,44 @@ void ESPHomeOTAComponent::handle_() {
   buf[0] = ota::OTA_RESPONSE_BIN_MD5_OK;
   this->writeall_(buf, 1);
 
+#ifdef USE_ESP32
+  if (delta) {
+    // Read patch size, 4 bytes MSB first. The patch is received instead of the image
+    if (!this->readall_(buf, 4)) {
+      ESP_LOGW(TAG, "Reading patch size failed");
+      goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
+    }
+    ota_size = 0;
+    for (uint8_t i = 0; i < 4; i++) {
+      ota_size <<= 8;
+      ota_size |= buf[i];
+    }
+    ESP_LOGV(TAG, "Patch size is %u bytes", ota_size);
+  }
+#endif
+
+#ifdef USE_ESP32
+  pipelined = pipeline.start(backend.get());
+  if (pipelined) {
+    block = nullptr;
+    block_size = ota::OTAPipeline::BUFFER_SIZE;
+  }
+#endif
+
+  receive_start = millis();
   while (total < ota_size) {
+#ifdef USE_ESP32
+    if (block == nullptr) {
+      // All buffers are waiting to be written
+      block = pipeline.get_buffer(100);
+      App.feed_wdt();
+      if (block == nullptr)
+        continue;
+    }
+#endif
     // TODO: timeout check
-    size_t requested = std::min(sizeof(buf), ota_size - total);
-    ssize_t read = this->client_->read(buf, requested);
+    size_t requested = std::min(block_size - block_length, ota_size - total);
+    ssize_t read = this->client_->read(block + block_length, requested);
     if (read == -1) {
       if (errno == EAGAIN || errno == EWOULDBLOCK) {
         App.feed_wdt();
@@ -272,16 +350,32 @@ void ESPHomeOTAComponent::handle_() {
       goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
     }
 
-    error_code = backend->write(buf, read);
-    if (error_code != ota::OTA_RESPONSE_OK) {
-      ESP_LOGW(TAG, "Error writing binary data to flash!, error_code: %d", error_code);
-      goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
-    }
+    block_length += read;
     total += read;
+    if (block_length == block_size || total == ota_size) {
+#ifdef USE_ESP32
+      if (pipelined) {
+        pipeline.write(block, block_length);
+        block = nullptr;
+        // Reports the errors of earlier blocks
+        error_code = pipeline.get_error();
+      } else {
+        error_code = backend->write(block, block_length);
+      }
+#else
+      error_code = backend->write(block, block_length);
+#endif
+      block_length = 0;
+      if (error_code != ota::OTA_RESPONSE_OK) {
+        ESP_LOGW(TAG, "Error writing binary data to flash!, error_code: %d", error_code);
+        goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
+      }
+    }
 #if USE_OTA_VERSION == 2
     while (size_acknowledged + OTA_BLOCK_SIZE <= total || (total == ota_size && size_acknowledged < ota_size)) {
-      buf[0] = ota::OTA_RESPONSE_CHUNK_OK;
-      this->writeall_(buf, 1);
+      // buf may hold data that is not written yet
+      const uint8_t chunk_ok = ota::OTA_RESPONSE_CHUNK_OK;
+      this->writeall_(&chunk_ok, 1);
       size_acknowledged += OTA_BLOCK_SIZE;
     }
 #endif
@@ -300,16 +394,38 @@ void ESPHomeOTAComponent::handle_() {
     }
   }
 
+#ifdef USE_ESP32
+  if (pipelined) {
+    error_code = pipeline.finish();
+    if (error_code != ota::OTA_RESPONSE_OK) {
+      ESP_LOGW(TAG, "Error writing binary data to flash!, error_code: %d", error_code);
+      goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
+    }
+  }
+#endif
+  receive_time = millis() - receive_start;
+
   // Acknowledge receive OK - 1 byte
   buf[0] = ota::OTA_RESPONSE_RECEIVE_OK;
   this->writeall_(buf, 1);
 
+  end_start = millis();
   error_code = backend->end();
   if (error_code != ota::OTA_RESPONSE_OK) {
     ESP_LOGW(TAG, "Error ending update! error_code: %d", error_code);
     goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
   }
 
+  ESP_LOGD(TAG, "Received %zu bytes in %" PRIu32 " ms (%.1f kB/s)", total, receive_time,
+           total / 1.024f / std::max<uint32_t>(receive_time, 1));
+#ifdef USE_ESP32
+  if (pipelined) {
+    ESP_LOGD(TAG, "  Writing flash took %" PRIu32 " ms, receiving waited for it %" PRIu32 " ms",
+             pipeline.get_write_time_ms(), pipeline.get_wait_time_ms());
+  }
+#endif
+  ESP_LOGD(TAG, "  Finishing the update took %" PRIu32 " ms", millis() - end_start);
+
   // Acknowledge Update end OK - 1 byte
   buf[0] = ota::OTA_RESPONSE_UPDATE_END_OK;
   this->writeall_(buf, 1);
@@ -337,6 +453,10 @@ error:
   this->client_->close();
   this->client_ = nullptr;
 
+#ifdef USE_ESP32
+  // The write task must not use the backend anymore
+  pipeline.finish();
+#endif
   if (backend != nullptr && update_started) {
     backend->abort();
   }
@@ -50,8 +50,33 @@ Font::Font(const GlyphData *data, int data_nr, int baseline, int height, uint8_t
   glyphs_.reserve(data_nr);
   for (int i = 0; i < data_nr; ++i)
     glyphs_.emplace_back(&data[i]);
+
+  // Single byte characters map directly to their glyph, unless a longer glyph starts with the same byte.
+  for (auto &entry : this->glyph_lookup_)
+    entry = -1;
+  bool ambiguous[GLYPH_LOOKUP_SIZE] = {};
+  for (int i = 0; i < data_nr; ++i) {
+    const uint8_t *a_char = data[i].a_char;
+    if (a_char[0] == '\0' || a_char[0] >= GLYPH_LOOKUP_SIZE)
+      continue;
+    if (a_char[1] == '\0') {
+      this->glyph_lookup_[a_char[0]] = i;
+    } else {
+      ambiguous[a_char[0]] = true;
+    }
+  }
+  for (int c = 0; c != GLYPH_LOOKUP_SIZE; c++) {
+    if (ambiguous[c])
+      this->glyph_lookup_[c] = -1;
+  }
 }
 int Font::match_next_glyph(const uint8_t *str, int *match_length) {
+  if (str[0] < GLYPH_LOOKUP_SIZE && this->glyph_lookup_[str[0]] >= 0) {
+    *match_length = 1;
+    return this->glyph_lookup_[str[0]];
+  }
+  if (this->glyphs_.empty())
+    return -1;
   int lo = 0;
   int hi = this->glyphs_.size() - 1;
   while (lo != hi) {
@@ -100,10 +125,70 @@ void Font::measure(const char *str, int *width, int *x_offset, int *baseline, in
   *x_offset = min_x;
   *width = x - min_x;
 }
+void Font::decode_glyph_(const Glyph &glyph, std::vector<GlyphRun> &runs) {
+  int scan_x1, scan_y1, scan_width, scan_height;
+  glyph.scan_area(&scan_x1, &scan_y1, &scan_width, &scan_height);
+
+  const uint8_t *data = glyph.glyph_data_->data;
+  uint8_t bitmask = 0;
+  uint8_t pixel_data = 0;
+  runs.clear();
+  // The pixels are packed MSB first without padding at the end of a row.
+  for (int glyph_y = 0; glyph_y != scan_height; glyph_y++) {
+    int run_start = 0;
+    uint8_t run_value = 0;
+    for (int glyph_x = 0; glyph_x <= scan_width; glyph_x++) {
+      uint8_t pixel = 0;
+      if (glyph_x != scan_width) {
+        for (int bit_num = 0; bit_num != this->bpp_; bit_num++) {
+          if (bitmask == 0) {
+            pixel_data = progmem_read_byte(data++);
+            bitmask = 0x80;
+          }
+          pixel <<= 1;
+          if ((pixel_data & bitmask) != 0)
+            pixel |= 1;
+          bitmask >>= 1;
+        }
+      }
+      if (glyph_x != 0 && pixel == run_value)
+        continue;
+      if (run_value != 0) {
+        runs.push_back(GlyphRun{(int16_t) (scan_x1 + run_start), (int16_t) (scan_y1 + glyph_y),
+                                (uint16_t) (glyph_x - run_start), run_value});
+      }
+      run_start = glyph_x;
+      run_value = pixel;
+    }
+  }
+}
+const std::vector<GlyphRun> &Font::get_glyph_runs_(int glyph_n) {
+  this->glyph_run_counter_++;
+  GlyphRunCacheEntry *victim = &this->glyph_run_cache_[0];
+  for (auto &entry : this->glyph_run_cache_) {
+    if (entry.glyph_n == glyph_n) {
+      entry.last_used = this->glyph_run_counter_;
+      return entry.runs;
+    }
+    if (entry.last_used < victim->last_used)
+      victim = &entry;
+  }
+  // Reuse the memory of the evicted entry
+  this->decode_glyph_(this->glyphs_[glyph_n], victim->runs);
+  victim->glyph_n = glyph_n;
+  victim->last_used = this->glyph_run_counter_;
+  return victim->runs;
+}
 void Font::print(int x_start, int y_start, display::Display *display, Color color, const char *text, Color background) {
   int i = 0;
   int x_at = x_start;
-  int scan_x1, scan_y1, scan_width, scan_height;
+  const uint8_t bpp_max = (1 << this->bpp_) - 1;
+  auto diff_r = (float) color.r - (float) background.r;
+  auto diff_g = (float) color.g - (float) background.g;
+  auto diff_b = (float) color.b - (float) background.b;
+  auto b_r = (float) background.r;
+  auto b_g = (float) background.g;
+  auto b_b = (float) background.b;
   while (text[i] != '\0') {
     int match_length;
     int glyph_n = this->match_next_glyph((const uint8_t *) text + i, &match_length);
@@ -120,45 +205,17 @@ void Font::print(int x_start, int y_start, display::Display *display, Color colo
       continue;
     }
 
-    const Glyph &glyph = this->get_glyphs()[glyph_n];
-    glyph.scan_area(&scan_x1, &scan_y1, &scan_width, &scan_height);
-
-    const uint8_t *data = glyph.glyph_data_->data;
-    const int max_x = x_at + scan_x1 + scan_width;
-    const int max_y = y_start + scan_y1 + scan_height;
-
-    uint8_t bitmask = 0;
-    uint8_t pixel_data = 0;
-    uint8_t bpp_max = (1 << this->bpp_) - 1;
-    auto diff_r = (float) color.r - (float) background.r;
-    auto diff_g = (float) color.g - (float) background.g;
-    auto diff_b = (float) color.b - (float) background.b;
-    auto b_r = (float) background.r;
-    auto b_g = (float) background.g;
-    auto b_b = (float) background.g;
-    for (int glyph_y = y_start + scan_y1; glyph_y != max_y; glyph_y++) {
-      for (int glyph_x = x_at + scan_x1; glyph_x != max_x; glyph_x++) {
-        uint8_t pixel = 0;
-        for (int bit_num = 0; bit_num != this->bpp_; bit_num++) {
-          if (bitmask == 0) {
-            pixel_data = progmem_read_byte(data++);
-            bitmask = 0x80;
-          }
-          pixel <<= 1;
-          if ((pixel_data & bitmask) != 0)
-            pixel |= 1;
-          bitmask >>= 1;
-        }
-        if (pixel == bpp_max) {
-          display->draw_pixel_at(glyph_x, glyph_y, color);
-        } else if (pixel != 0) {
-          auto on = (float) pixel / (float) bpp_max;
-          auto blended =
-              Color((uint8_t) (diff_r * on + b_r), (uint8_t) (diff_g * on + b_g), (uint8_t) (diff_b * on + b_b));
-          display->draw_pixel_at(glyph_x, glyph_y, blended);
-        }
+    for (const auto &run : this->get_glyph_runs_(glyph_n)) {
+      if (run.value == bpp_max) {
+        display->horizontal_line(x_at + run.x, y_start + run.y, run.length, color);
+      } else {
+        auto on = (float) run.value / (float) bpp_max;
+        auto blended =
+            Color((uint8_t) (diff_r * on + b_r), (uint8_t) (diff_g * on + b_g), (uint8_t) (diff_b * on + b_b));
+        display->horizontal_line(x_at + run.x, y_start + run.y, run.length, blended);
       }
     }
+    const Glyph &glyph = this->get_glyphs()[glyph_n];
     x_at += glyph.glyph_data_->width + glyph.glyph_data_->offset_x;
 
     i += match_length;
@@ -12,6 +12,11 @@ namespace font {
 
 class Font;
 
+/// Number of decoded glyphs kept by each font, see Font::get_glyph_runs_().
+static const uint8_t GLYPH_RUN_CACHE_SIZE = 8;
+/// Single byte characters that can be looked up without searching the glyph list.
+static const uint8_t GLYPH_LOOKUP_SIZE = 128;
+
 struct GlyphData {
   const uint8_t *a_char;
   const uint8_t *data;
@@ -41,6 +46,14 @@ class Glyph {
   const GlyphData *glyph_data_;
 };
 
+/// A horizontal span of pixels with the same non-zero value within a glyph, relative to the glyph origin.
+struct GlyphRun {
+  int16_t x;
+  int16_t y;
+  uint16_t length;
+  uint8_t value;
+};
+
 class Font
 #ifdef USE_DISPLAY
     : public display::BaseFont
@@ -69,7 +82,24 @@ class Font
   const std::vector<Glyph, ExternalRAMAllocator<Glyph>> &get_glyphs() const { return glyphs_; }
 
  protected:
+#ifdef USE_DISPLAY
+  struct GlyphRunCacheEntry {
+    int glyph_n{-1};
+    uint32_t last_used{0};
+    std::vector<GlyphRun> runs;
+  };
+
+  /// Decode the bitmap of a glyph into horizontal runs of equal pixel values.
+  void decode_glyph_(const Glyph &glyph, std::vector<GlyphRun> &runs);
+  /// Return the runs of the given glyph, decoding it into the least recently used cache entry if necessary.
+  const std::vector<GlyphRun> &get_glyph_runs_(int glyph_n);
+
+  GlyphRunCacheEntry glyph_run_cache_[GLYPH_RUN_CACHE_SIZE];
+  uint32_t glyph_run_counter_{0};
+#endif
   std::vector<Glyph, ExternalRAMAllocator<Glyph>> glyphs_;
+  /// Glyph index for single byte characters, -1 if the glyph list has to be searched.
+  int16_t glyph_lookup_[GLYPH_LOOKUP_SIZE];
   int baseline_;
   int height_;
   uint8_t bpp_;  // bits per pixel
@@ -38,6 +38,7 @@ template<typename T> class RestoringGlobalsComponent : public Component {
 
   void setup() override {
     this->rtc_ = global_preferences->make_preference<T>(1944399030U ^ this->name_hash_);
+    this->rtc_.set_min_write_interval(this->min_write_interval_);
     this->rtc_.load(&this->value_);
     memcpy(&this->prev_value_, &this->value_, sizeof(T));
   }
@@ -49,6 +50,7 @@ template<typename T> class RestoringGlobalsComponent : public Component {
   void on_shutdown() override { store_value_(); }
 
   void set_name_hash(uint32_t name_hash) { this->name_hash_ = name_hash; }
+  void set_min_write_interval(uint32_t min_write_interval) { this->min_write_interval_ = min_write_interval; }
 
  protected:
   void store_value_() {
@@ -62,6 +64,7 @@ template<typename T> class RestoringGlobalsComponent : public Component {
   T value_{};
   T prev_value_{};
   uint32_t name_hash_{};
+  uint32_t min_write_interval_{0};
   ESPPreferenceObject rtc_;
 };
 
@@ -81,6 +84,7 @@ template<typename T, uint8_t SZ> class RestoringGlobalStringComponent : public C
   void setup() override {
     char temp[SZ];
     this->rtc_ = global_preferences->make_preference<uint8_t[SZ]>(1944399030U ^ this->name_hash_);
+    this->rtc_.set_min_write_interval(this->min_write_interval_);
     bool hasdata = this->rtc_.load(&temp);
     if (hasdata) {
       this->value_.assign(temp + 1, temp[0]);
@@ -95,6 +99,7 @@ template<typename T, uint8_t SZ> class RestoringGlobalStringComponent : public C
   void on_shutdown() override { store_value_(); }
 
   void set_name_hash(uint32_t name_hash) { this->name_hash_ = name_hash; }
+  void set_min_write_interval(uint32_t min_write_interval) { this->min_write_interval_ = min_write_interval; }
 
  protected:
   void store_value_() {
@@ -120,6 +125,7 @@ template<typename T, uint8_t SZ> class RestoringGlobalStringComponent : public C
   T value_{};
   T prev_value_{};
   uint32_t name_hash_{};
+  uint32_t min_write_interval_{0};
   ESPPreferenceObject rtc_;
 };
 
@@ -1,4 +1,5 @@
 #include "growatt_solar.h"
+#include "esphome/core/hal.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
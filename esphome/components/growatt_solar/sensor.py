@@ -1,6 +1,6 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
-from esphome.components import sensor, modbus
+from esphome.components import sensor, modbus_hub
 from esphome.const import (
     CONF_ACTIVE_POWER,
     CONF_CURRENT,
@@ -40,12 +40,12 @@ CONF_PV_ACTIVE_POWER = "pv_active_power"
 CONF_INVERTER_MODULE_TEMP = "inverter_module_temp"
 CONF_PROTOCOL_VERSION = "protocol_version"
 
-AUTO_LOAD = ["modbus"]
+AUTO_LOAD = ["modbus_hub"]
 CODEOWNERS = ["@leeuwte"]
 
 growatt_solar_ns = cg.esphome_ns.namespace("growatt_solar")
 GrowattSolar = growatt_solar_ns.class_(
-    "GrowattSolar", cg.PollingComponent, modbus.ModbusDevice
+    "GrowattSolar", cg.PollingComponent, modbus_hub.ModbusDevice
 )
 
 PHASE_SENSORS = {
@@ -152,14 +152,14 @@ CONFIG_SCHEMA = (
         }
     )
     .extend(cv.polling_component_schema("10s"))
-    .extend(modbus.modbus_device_schema(0x01))
+    .extend(modbus_hub.modbus_device_schema(0x01))
 )
 
 
 async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     await cg.register_component(var, config)
-    await modbus.register_modbus_device(var, config)
+    await modbus_hub.register_modbus_device(var, config)
 
     cg.add(var.set_protocol_version(config[CONF_PROTOCOL_VERSION]))
 
@@ -1,6 +1,6 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
-from esphome.components import sensor, modbus
+from esphome.components import sensor, modbus_hub
 from esphome.const import (
     CONF_ACTIVE_POWER,
     CONF_CURRENT,
@@ -51,12 +51,12 @@ CONF_DCI_OF_S = "dci_of_s"
 CONF_DCI_OF_T = "dci_of_t"
 
 
-AUTO_LOAD = ["modbus"]
+AUTO_LOAD = ["modbus_hub"]
 CODEOWNERS = ["@sourabhjaiswal"]
 
 havells_solar_ns = cg.esphome_ns.namespace("havells_solar")
 HavellsSolar = havells_solar_ns.class_(
-    "HavellsSolar", cg.PollingComponent, modbus.ModbusDevice
+    "HavellsSolar", cg.PollingComponent, modbus_hub.ModbusDevice
 )
 
 PHASE_SENSORS = {
@@ -201,14 +201,14 @@ CONFIG_SCHEMA = (
         }
     )
     .extend(cv.polling_component_schema("10s"))
-    .extend(modbus.modbus_device_schema(0x01))
+    .extend(modbus_hub.modbus_device_schema(0x01))
 )
 
 
 async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     await cg.register_component(var, config)
-    await modbus.register_modbus_device(var, config)
+    await modbus_hub.register_modbus_device(var, config)
 
     if CONF_FREQUENCY in config:
         sens = await sensor.new_sensor(config[CONF_FREQUENCY])
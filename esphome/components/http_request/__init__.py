@@ -42,8 +42,13 @@ CONF_REDIRECT_LIMIT = "redirect_limit"
 CONF_WATCHDOG_TIMEOUT = "watchdog_timeout"
 CONF_BUFFER_SIZE_RX = "buffer_size_rx"
 CONF_BUFFER_SIZE_TX = "buffer_size_tx"
+CONF_KEEP_ALIVE = "keep_alive"
+CONF_ASYNC_CHUNK_SIZE = "async_chunk_size"
+CONF_ASYNC_CHUNK_COUNT = "async_chunk_count"
 
 CONF_MAX_RESPONSE_BUFFER_SIZE = "max_response_buffer_size"
+CONF_MAX_RESPONSE_SIZE = "max_response_size"
+CONF_ASYNC = "async"
 CONF_ON_RESPONSE = "on_response"
 CONF_HEADERS = "headers"
 CONF_BODY = "body"
@@ -118,6 +123,15 @@ CONFIG_SCHEMA = cv.All(
             cv.SplitDefault(CONF_BUFFER_SIZE_TX, esp32_idf=512): cv.All(
                 cv.uint16_t, cv.only_with_esp_idf
             ),
+            cv.SplitDefault(CONF_KEEP_ALIVE, esp32_idf=False): cv.All(
+                cv.boolean, cv.only_with_esp_idf
+            ),
+            cv.Optional(CONF_ASYNC_CHUNK_SIZE, default=512): cv.All(
+                cv.validate_bytes, cv.int_range(min=64, max=16384)
+            ),
+            cv.Optional(CONF_ASYNC_CHUNK_COUNT, default=4): cv.int_range(
+                min=1, max=16
+            ),
         }
     ).extend(cv.COMPONENT_SCHEMA),
     cv.require_framework_version(
@@ -136,6 +150,8 @@ async def to_code(config):
     cg.add(var.set_useragent(config[CONF_USERAGENT]))
     cg.add(var.set_follow_redirects(config[CONF_FOLLOW_REDIRECTS]))
     cg.add(var.set_redirect_limit(config[CONF_REDIRECT_LIMIT]))
+    cg.add(var.set_async_chunk_size(config[CONF_ASYNC_CHUNK_SIZE]))
+    cg.add(var.set_async_chunk_count(config[CONF_ASYNC_CHUNK_COUNT]))
 
     if CORE.is_esp8266 and not config[CONF_ESP8266_DISABLE_SSL_SUPPORT]:
         cg.add_define("USE_HTTP_REQUEST_ESP8266_HTTPS")
@@ -147,6 +163,7 @@ async def to_code(config):
         if CORE.using_esp_idf:
             cg.add(var.set_buffer_size_rx(config[CONF_BUFFER_SIZE_RX]))
             cg.add(var.set_buffer_size_tx(config[CONF_BUFFER_SIZE_TX]))
+            cg.add(var.set_keep_alive(config[CONF_KEEP_ALIVE]))
 
             esp32.add_idf_sdkconfig_option(
                 "CONFIG_MBEDTLS_CERTIFICATE_BUNDLE",
@@ -186,6 +203,8 @@ HTTP_REQUEST_ACTION_SCHEMA = cv.Schema(
             {cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(HttpRequestResponseTrigger)}
         ),
         cv.Optional(CONF_MAX_RESPONSE_BUFFER_SIZE, default="1kB"): cv.validate_bytes,
+        cv.Optional(CONF_ASYNC, default=False): cv.boolean,
+        cv.Optional(CONF_MAX_RESPONSE_SIZE): cv.validate_bytes,
     }
 )
 HTTP_REQUEST_GET_ACTION_SCHEMA = automation.maybe_conf(
@@ -241,6 +260,9 @@ async def http_request_action_to_code(config, action_id, template_arg, args):
     cg.add(var.set_method(config[CONF_METHOD]))
     cg.add(var.set_capture_response(config[CONF_CAPTURE_RESPONSE]))
     cg.add(var.set_max_response_buffer_size(config[CONF_MAX_RESPONSE_BUFFER_SIZE]))
+    cg.add(var.set_async(config[CONF_ASYNC]))
+    if max_response_size := config.get(CONF_MAX_RESPONSE_SIZE):
+        cg.add(var.set_max_response_size(max_response_size))
 
     if CONF_BODY in config:
         template_ = await cg.templatable(config[CONF_BODY], args, cg.std_string)
@@ -18,6 +18,226 @@ void HttpRequestComponent::dump_config() {
   if (this->watchdog_timeout_ > 0) {
     ESP_LOGCONFIG(TAG, "  Watchdog Timeout: %" PRIu32 "ms", this->watchdog_timeout_);
   }
+  ESP_LOGCONFIG(TAG, "  Async chunks: %u x %u bytes", this->async_chunk_count_, this->async_chunk_size_);
+}
+
+#ifdef USE_ESP32
+static const uint32_t WORKER_TASK_STACK_SIZE = 8192;
+static const UBaseType_t WORKER_TASK_PRIORITY = 1;
+static const uint8_t MAX_PENDING_REQUESTS = 4;
+
+bool HttpRequestComponent::in_worker_() const {
+  return this->worker_task_handle_ != nullptr && xTaskGetCurrentTaskHandle() == this->worker_task_handle_;
+}
+
+bool HttpRequestComponent::start_async(std::unique_ptr<HttpAsyncRequest> request) {
+  if (this->worker_task_handle_ == nullptr) {
+    RAMAllocator<uint8_t> allocator(RAMAllocator<uint8_t>::ALLOW_FAILURE);
+    this->async_chunks_ = allocator.allocate(this->async_chunk_size_ * this->async_chunk_count_);
+    this->request_queue_ = xQueueCreate(MAX_PENDING_REQUESTS, sizeof(HttpAsyncRequest *));
+    this->event_queue_ = xQueueCreate(this->async_chunk_count_ + 1, sizeof(AsyncEvent));
+    this->free_chunks_ = xQueueCreate(this->async_chunk_count_, sizeof(uint8_t *));
+    if (this->async_chunks_ == nullptr || this->request_queue_ == nullptr || this->event_queue_ == nullptr ||
+        this->free_chunks_ == nullptr) {
+      ESP_LOGE(TAG, "Could not allocate async request buffers");
+      this->status_momentary_error("failed", 1000);
+      return false;
+    }
+    for (uint8_t i = 0; i < this->async_chunk_count_; i++) {
+      uint8_t *chunk = this->async_chunks_ + i * this->async_chunk_size_;
+      xQueueSend(this->free_chunks_, &chunk, 0);
+    }
+    xTaskCreate(HttpRequestComponent::worker_task, "http_request", WORKER_TASK_STACK_SIZE, (void *) this,
+                WORKER_TASK_PRIORITY, &this->worker_task_handle_);
+    if (this->worker_task_handle_ == nullptr) {
+      ESP_LOGE(TAG, "Could not start async request task");
+      this->status_momentary_error("failed", 1000);
+      return false;
+    }
+  }
+
+  HttpAsyncRequest *pending = request.get();
+  if (xQueueSend(this->request_queue_, &pending, 0) != pdTRUE) {
+    ESP_LOGW(TAG, "Too many pending requests, dropping request to %s", request->url.c_str());
+    return false;
+  }
+  // owned by the worker until it is passed back in the completion event
+  request.release();
+  return true;
+}
+
+void HttpRequestComponent::worker_task(void *params) {
+  auto *this_request = (HttpRequestComponent *) params;
+  HttpAsyncRequest *request;
+  while (true) {
+    if (xQueueReceive(this_request->request_queue_, &request, portMAX_DELAY) != pdTRUE)
+      continue;
+    auto container = this_request->begin_async_request_(request);
+    if (container == nullptr)
+      continue;
+    uint32_t last_data = millis();
+    AsyncReadState state;
+    while ((state = this_request->read_async_chunk_(request, container.get(), last_data)) == ASYNC_READ_DATA ||
+           state == ASYNC_READ_NO_DATA) {
+      if (state == ASYNC_READ_NO_DATA)
+        delay(1);
+    }
+    this_request->end_async_request_(request, std::move(container), state == ASYNC_READ_DONE);
+  }
+}
+
+void HttpRequestComponent::loop() {
+  if (this->event_queue_ == nullptr)
+    return;
+
+  AsyncEvent event;
+  while (xQueueReceive(this->event_queue_, &event, 0) == pdTRUE) {
+    if (event.chunk != nullptr) {
+      if (event.request->on_data != nullptr)
+        event.request->on_data(event.chunk, event.len);
+      xQueueSend(this->free_chunks_, &event.chunk, 0);
+      continue;
+    }
+    std::unique_ptr<HttpAsyncRequest> request(event.request);
+    if (request->on_complete != nullptr)
+      request->on_complete(std::move(request->container));
+  }
+}
+
+uint8_t *HttpRequestComponent::acquire_chunk_() {
+  uint8_t *chunk;
+  xQueueReceive(this->free_chunks_, &chunk, portMAX_DELAY);
+  return chunk;
+}
+
+void HttpRequestComponent::deliver_chunk_(HttpAsyncRequest *request, uint8_t *chunk, size_t len) {
+  AsyncEvent event{request, chunk, len};
+  xQueueSend(this->event_queue_, &event, portMAX_DELAY);
+}
+
+void HttpRequestComponent::release_chunk_(uint8_t *chunk) { xQueueSend(this->free_chunks_, &chunk, 0); }
+
+void HttpRequestComponent::complete_async_request_(HttpAsyncRequest *request) {
+  AsyncEvent event{request, nullptr, 0};
+  xQueueSend(this->event_queue_, &event, portMAX_DELAY);
+}
+#else
+static const uint8_t MAX_PENDING_REQUESTS = 4;
+
+bool HttpRequestComponent::in_worker_() const { return false; }
+
+bool HttpRequestComponent::start_async(std::unique_ptr<HttpAsyncRequest> request) {
+  if (this->pending_requests_.size() >= MAX_PENDING_REQUESTS) {
+    ESP_LOGW(TAG, "Too many pending requests, dropping request to %s", request->url.c_str());
+    return false;
+  }
+  if (this->async_chunks_ == nullptr) {
+    RAMAllocator<uint8_t> allocator(RAMAllocator<uint8_t>::ALLOW_FAILURE);
+    this->async_chunks_ = allocator.allocate(this->async_chunk_size_);
+    if (this->async_chunks_ == nullptr) {
+      ESP_LOGE(TAG, "Could not allocate async request buffer");
+      this->status_momentary_error("failed", 1000);
+      return false;
+    }
+  }
+  this->pending_requests_.push_back(std::move(request));
+  return true;
+}
+
+void HttpRequestComponent::loop() {
+  // without a worker task, read what has arrived of one request per loop iteration and resume in the next one
+  if (this->active_request_ == nullptr) {
+    if (this->pending_requests_.empty())
+      return;
+    this->active_request_ = std::move(this->pending_requests_.front());
+    this->pending_requests_.pop_front();
+    this->active_container_ = this->begin_async_request_(this->active_request_.get());
+    if (this->active_container_ == nullptr) {
+      this->active_request_ = nullptr;
+      return;
+    }
+    this->active_last_data_ = millis();
+    this->high_freq_.start();
+  }
+
+  AsyncReadState state = ASYNC_READ_DATA;
+  for (uint8_t i = 0; i < this->async_chunk_count_ && state == ASYNC_READ_DATA; i++) {
+    state = this->read_async_chunk_(this->active_request_.get(), this->active_container_.get(),
+                                    this->active_last_data_);
+  }
+  if (state == ASYNC_READ_DATA || state == ASYNC_READ_NO_DATA)
+    return;
+
+  this->high_freq_.stop();
+  this->end_async_request_(this->active_request_.get(), std::move(this->active_container_), state == ASYNC_READ_DONE);
+  this->active_request_ = nullptr;
+}
+
+uint8_t *HttpRequestComponent::acquire_chunk_() { return this->async_chunks_; }
+
+void HttpRequestComponent::deliver_chunk_(HttpAsyncRequest *request, uint8_t *chunk, size_t len) {
+  if (request->on_data != nullptr)
+    request->on_data(chunk, len);
+}
+
+void HttpRequestComponent::release_chunk_(uint8_t *chunk) {}
+
+void HttpRequestComponent::complete_async_request_(HttpAsyncRequest *request) {
+  if (request->on_complete != nullptr)
+    request->on_complete(std::move(request->container));
+}
+#endif
+
+std::shared_ptr<HttpContainer> HttpRequestComponent::begin_async_request_(HttpAsyncRequest *request) {
+  std::list<Header> headers;
+  for (const auto &header : request->headers)
+    headers.push_back(Header{header.first.c_str(), header.second.c_str()});
+
+  auto container = this->start(request->url, request->method, request->body, headers);
+  if (container == nullptr)
+    this->complete_async_request_(request);
+  return container;
+}
+
+HttpRequestComponent::AsyncReadState HttpRequestComponent::read_async_chunk_(HttpAsyncRequest *request,
+                                                                             HttpContainer *container,
+                                                                             uint32_t &last_data) {
+  if (container->get_bytes_read() >= container->content_length)
+    return ASYNC_READ_DONE;
+
+  uint8_t *chunk = this->acquire_chunk_();
+  int len = container->read(chunk, this->async_chunk_size_);
+  if (len <= 0) {
+    this->release_chunk_(chunk);
+    if (len < 0)
+      return ASYNC_READ_FAILED;
+    if (container->get_bytes_read() >= container->content_length)
+      return ASYNC_READ_DONE;
+    // fall back to the timeout if the end of a chunked response can't be detected
+    if (millis() - last_data > this->timeout_)
+      return container->content_length == SIZE_MAX ? ASYNC_READ_DONE : ASYNC_READ_FAILED;
+    return ASYNC_READ_NO_DATA;
+  }
+  last_data = millis();
+  if (request->max_response_size != 0 && container->get_bytes_read() > request->max_response_size) {
+    this->release_chunk_(chunk);
+    ESP_LOGW(TAG, "Response from %s exceeds %zu bytes, aborting", request->url.c_str(), request->max_response_size);
+    return ASYNC_READ_FAILED;
+  }
+  this->deliver_chunk_(request, chunk, len);
+  return ASYNC_READ_DATA;
+}
+
+void HttpRequestComponent::end_async_request_(HttpAsyncRequest *request, std::shared_ptr<HttpContainer> container,
+                                              bool success) {
+  container->end();
+
+  if (success) {
+    request->container = std::move(container);
+  } else {
+    this->status_momentary_error("failed", 1000);
+  }
+  this->complete_async_request_(request);
 }
 
 }  // namespace http_request
@@ -14,6 +14,12 @@
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 
+#ifdef USE_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+#endif
+
 namespace esphome {
 namespace http_request {
 
@@ -43,6 +49,24 @@ class HttpContainer : public Parented<HttpRequestComponent> {
   bool secure_{false};
 };
 
+/// A request executed in the background, see HttpRequestComponent::start_async().
+struct HttpAsyncRequest {
+  std::string url;
+  std::string method;
+  std::string body;
+  std::vector<std::pair<std::string, std::string>> headers;
+  /// The transfer is aborted when the response body is larger, 0 for no limit.
+  size_t max_response_size{0};
+  /// Called from the main loop for every received chunk of the response body.
+  std::function<void(const uint8_t *data, size_t len)> on_data;
+  /// Called from the main loop once the request is finished. The container is nullptr if the request failed, the
+  /// body has already been read and passed to on_data.
+  std::function<void(std::shared_ptr<HttpContainer> container)> on_complete;
+
+  // Set by the component when the request is done.
+  std::shared_ptr<HttpContainer> container{nullptr};
+};
+
 class HttpRequestResponseTrigger : public Trigger<std::shared_ptr<HttpContainer>, std::string &> {
  public:
   void process(std::shared_ptr<HttpContainer> container, std::string &response_body) {
@@ -53,12 +77,20 @@ class HttpRequestResponseTrigger : public Trigger<std::shared_ptr<HttpContainer>
 class HttpRequestComponent : public Component {
  public:
   void dump_config() override;
+  void loop() override;
   float get_setup_priority() const override { return setup_priority::AFTER_WIFI; }
 
   void set_useragent(const char *useragent) { this->useragent_ = useragent; }
   void set_timeout(uint16_t timeout) { this->timeout_ = timeout; }
   void set_watchdog_timeout(uint32_t watchdog_timeout) { this->watchdog_timeout_ = watchdog_timeout; }
-  uint32_t get_watchdog_timeout() const { return this->watchdog_timeout_; }
+  /// Requests running on the worker task don't block the main loop and don't need a longer watchdog timeout.
+  uint32_t get_watchdog_timeout() const { return this->in_worker_() ? 0 : this->watchdog_timeout_; }
+  void feed_wdt() {
+    if (!this->in_worker_())
+      App.feed_wdt();
+  }
+  void set_async_chunk_size(uint16_t chunk_size) { this->async_chunk_size_ = chunk_size; }
+  void set_async_chunk_count(uint8_t chunk_count) { this->async_chunk_count_ = chunk_count; }
   void set_follow_redirects(bool follow_redirects) { this->follow_redirects_ = follow_redirects; }
   void set_redirect_limit(uint16_t limit) { this->redirect_limit_ = limit; }
 
@@ -76,12 +108,64 @@ class HttpRequestComponent : public Component {
   virtual std::shared_ptr<HttpContainer> start(std::string url, std::string method, std::string body,
                                                std::list<Header> headers) = 0;
 
+  /** Execute a request without blocking the main loop.
+   *
+   * On ESP32 the request runs on a worker task and the response body is passed back in chunks of at most
+   * async_chunk_size bytes, with at most async_chunk_count chunks in flight. The worker waits for the main loop
+   * when all chunks are in use. On other platforms the response body is read from loop() as it arrives, at most
+   * async_chunk_count chunks per iteration.
+   *
+   * @return false if too many requests are pending.
+   */
+  bool start_async(std::unique_ptr<HttpAsyncRequest> request);
+
  protected:
+  /// Result of reading the next chunk of an async response body.
+  enum AsyncReadState : uint8_t {
+    ASYNC_READ_DATA,
+    ASYNC_READ_NO_DATA,
+    ASYNC_READ_DONE,
+    ASYNC_READ_FAILED,
+  };
+
+  bool in_worker_() const;
+  /// Returns nullptr if the request could not be started, the request is then already completed.
+  std::shared_ptr<HttpContainer> begin_async_request_(HttpAsyncRequest *request);
+  AsyncReadState read_async_chunk_(HttpAsyncRequest *request, HttpContainer *container, uint32_t &last_data);
+  void end_async_request_(HttpAsyncRequest *request, std::shared_ptr<HttpContainer> container, bool success);
+  uint8_t *acquire_chunk_();
+  void deliver_chunk_(HttpAsyncRequest *request, uint8_t *chunk, size_t len);
+  void release_chunk_(uint8_t *chunk);
+  void complete_async_request_(HttpAsyncRequest *request);
+
   const char *useragent_{nullptr};
   bool follow_redirects_;
   uint16_t redirect_limit_;
   uint16_t timeout_{4500};
   uint32_t watchdog_timeout_{0};
+  uint16_t async_chunk_size_{512};
+  uint8_t async_chunk_count_{4};
+  uint8_t *async_chunks_{nullptr};
+#ifdef USE_ESP32
+  static void worker_task(void *params);
+  struct AsyncEvent {
+    HttpAsyncRequest *request;
+    // nullptr when the request is complete
+    uint8_t *chunk;
+    size_t len;
+  };
+  TaskHandle_t worker_task_handle_{nullptr};
+  QueueHandle_t request_queue_{nullptr};
+  QueueHandle_t event_queue_{nullptr};
+  QueueHandle_t free_chunks_{nullptr};
+#else
+  std::list<std::unique_ptr<HttpAsyncRequest>> pending_requests_;
+  // The request whose response is being read, resumed in every loop() iteration
+  std::unique_ptr<HttpAsyncRequest> active_request_{nullptr};
+  std::shared_ptr<HttpContainer> active_container_{nullptr};
+  uint32_t active_last_data_{0};
+  HighFrequencyLoopRequester high_freq_;
+#endif
 };
 
 template<typename... Ts> class HttpRequestSendAction : public Action<Ts...> {
@@ -91,6 +175,7 @@ template<typename... Ts> class HttpRequestSendAction : public Action<Ts...> {
   TEMPLATABLE_VALUE(const char *, method)
   TEMPLATABLE_VALUE(std::string, body)
   TEMPLATABLE_VALUE(bool, capture_response)
+  TEMPLATABLE_VALUE(bool, async)
 
   void add_header(const char *key, TemplatableValue<const char *, Ts...> value) { this->headers_.insert({key, value}); }
 
@@ -103,20 +188,47 @@ template<typename... Ts> class HttpRequestSendAction : public Action<Ts...> {
   void set_max_response_buffer_size(size_t max_response_buffer_size) {
     this->max_response_buffer_size_ = max_response_buffer_size;
   }
+  void set_max_response_size(size_t max_response_size) { this->max_response_size_ = max_response_size; }
 
-  void play(Ts... x) override {
-    std::string body;
-    if (this->body_.has_value()) {
-      body = this->body_.value(x...);
+  void play_complex(Ts... x) override {
+    this->num_running_++;
+    if (!this->async_.value(x...)) {
+      this->play(x...);
+      this->play_next_(x...);
+      return;
     }
-    if (!this->json_.empty()) {
-      auto f = std::bind(&HttpRequestSendAction<Ts...>::encode_json_, this, x..., std::placeholders::_1);
-      body = json::build_json(f);
+
+    auto request = make_unique<HttpAsyncRequest>();
+    request->url = this->url_.value(x...);
+    request->method = this->method_.value(x...);
+    request->body = this->build_body_(x...);
+    for (const auto &item : this->headers_) {
+      auto val = item.second;
+      request->headers.emplace_back(item.first, val.value(x...));
     }
-    if (this->json_func_ != nullptr) {
-      auto f = std::bind(&HttpRequestSendAction<Ts...>::encode_json_func_, this, x..., std::placeholders::_1);
-      body = json::build_json(f);
+    request->max_response_size = this->max_response_size_;
+
+    auto response_body = std::make_shared<std::string>();
+    if (this->capture_response_.value(x...)) {
+      const size_t max_length = this->max_response_buffer_size_;
+      request->on_data = [response_body, max_length](const uint8_t *data, size_t len) {
+        len = std::min(len, max_length - response_body->size());
+        response_body->append((const char *) data, len);
+      };
     }
+    auto args = std::make_tuple(x...);
+    request->on_complete = [this, response_body, args](std::shared_ptr<HttpContainer> container) {
+      if (container != nullptr)
+        this->process_response_(std::move(container), *response_body);
+      // continue with the next action even if the request failed, like the synchronous request
+      this->play_next_tuple_(args);
+    };
+    if (!this->parent_->start_async(std::move(request)))
+      this->play_next_(x...);
+  }
+
+  void play(Ts... x) override {
+    std::string body = this->build_body_(x...);
     std::list<Header> headers;
     for (const auto &item : this->headers_) {
       auto val = item.second;
@@ -133,6 +245,12 @@ template<typename... Ts> class HttpRequestSendAction : public Action<Ts...> {
     }
 
     size_t content_length = container->content_length;
+    if (this->max_response_size_ != 0 && content_length != SIZE_MAX && content_length > this->max_response_size_) {
+      ESP_LOGW("http_request", "Response of %zu bytes exceeds %zu bytes, aborting", content_length,
+               this->max_response_size_);
+      container->end();
+      return;
+    }
     size_t max_length = std::min(content_length, this->max_response_buffer_size_);
 
     std::string response_body;
@@ -143,7 +261,7 @@ template<typename... Ts> class HttpRequestSendAction : public Action<Ts...> {
         size_t read_index = 0;
         while (container->get_bytes_read() < max_length) {
           int read = container->read(buf + read_index, std::min<size_t>(max_length - read_index, 512));
-          App.feed_wdt();
+          this->parent_->feed_wdt();
           yield();
           read_index += read;
         }
@@ -153,6 +271,27 @@ template<typename... Ts> class HttpRequestSendAction : public Action<Ts...> {
       }
     }
 
+    this->process_response_(container, response_body);
+    container->end();
+  }
+
+ protected:
+  std::string build_body_(Ts... x) {
+    std::string body;
+    if (this->body_.has_value()) {
+      body = this->body_.value(x...);
+    }
+    if (!this->json_.empty()) {
+      auto f = std::bind(&HttpRequestSendAction<Ts...>::encode_json_, this, x..., std::placeholders::_1);
+      body = json::build_json(f);
+    }
+    if (this->json_func_ != nullptr) {
+      auto f = std::bind(&HttpRequestSendAction<Ts...>::encode_json_func_, this, x..., std::placeholders::_1);
+      body = json::build_json(f);
+    }
+    return body;
+  }
+  void process_response_(std::shared_ptr<HttpContainer> container, std::string &response_body) {
     if (this->response_triggers_.size() == 1) {
       // if there is only one trigger, no need to copy the response body
       this->response_triggers_[0]->process(container, response_body);
@@ -165,10 +304,7 @@ template<typename... Ts> class HttpRequestSendAction : public Action<Ts...> {
         trigger->process(container, response_body_copy);
       }
     }
-    container->end();
   }
-
- protected:
   void encode_json_(Ts... x, JsonObject root) {
     for (const auto &item : this->json_) {
       auto val = item.second;
@@ -183,6 +319,7 @@ template<typename... Ts> class HttpRequestSendAction : public Action<Ts...> {
   std::vector<HttpRequestResponseTrigger *> response_triggers_;
 
   size_t max_response_buffer_size_{SIZE_MAX};
+  size_t max_response_size_{0};
 };
 
 }  // namespace http_request
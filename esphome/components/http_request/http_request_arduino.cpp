@@ -77,7 +77,7 @@ std::shared_ptr<HttpContainer> HttpRequestArduino::start(std::string url, std::s
   bool status = container->client_.begin(url.c_str());
 #endif
 
-  App.feed_wdt();
+  this->feed_wdt();
 
   if (!status) {
     ESP_LOGW(TAG, "HTTP Request failed; URL: %s", url.c_str());
@@ -142,11 +142,15 @@ int HttpContainerArduino::read(uint8_t *buf, size_t max_len) {
   int bufsize = std::min(max_len, std::min(this->content_length - this->bytes_read_, (size_t) available_data));
 
   if (bufsize == 0) {
+    if (available_data == 0 && !this->client_.connected()) {
+      // the length of chunked responses is only known once the server closes the connection
+      this->content_length = this->bytes_read_;
+    }
     this->duration_ms += (millis() - start);
     return 0;
   }
 
-  App.feed_wdt();
+  this->parent_->feed_wdt();
   int read_len = stream_ptr->readBytes(buf, bufsize);
   this->bytes_read_ += read_len;
 
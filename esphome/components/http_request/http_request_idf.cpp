@@ -18,10 +18,13 @@ namespace http_request {
 
 static const char *const TAG = "http_request.idf";
 
+static const size_t MAX_IDLE_CLIENTS = 2;
+
 void HttpRequestIDF::dump_config() {
   HttpRequestComponent::dump_config();
   ESP_LOGCONFIG(TAG, "  Buffer Size RX: %u", this->buffer_size_rx_);
   ESP_LOGCONFIG(TAG, "  Buffer Size TX: %u", this->buffer_size_tx_);
+  ESP_LOGCONFIG(TAG, "  Keep Alive: %s", YESNO(this->keep_alive_));
 }
 
 std::shared_ptr<HttpContainer> HttpRequestIDF::start(std::string url, std::string method, std::string body,
@@ -72,23 +75,51 @@ std::shared_ptr<HttpContainer> HttpRequestIDF::start(std::string url, std::strin
   config.buffer_size = this->buffer_size_rx_;
   config.buffer_size_tx = this->buffer_size_tx_;
 
+  std::string host_key;
+  if (this->keep_alive_) {
+    size_t scheme_end = url.find("://");
+    host_key = url.substr(0, scheme_end == std::string::npos ? scheme_end : url.find('/', scheme_end + 3));
+  }
+
   const uint32_t start = millis();
   watchdog::WatchdogManager wdm(this->get_watchdog_timeout());
 
-  esp_http_client_handle_t client = esp_http_client_init(&config);
+  const int body_len = body.length();
+
+  esp_http_client_handle_t client = this->acquire_client_(host_key);
+  bool reused = client != nullptr;
+  esp_err_t err;
+  while (true) {
+    if (client == nullptr) {
+      client = esp_http_client_init(&config);
+    } else {
+      esp_http_client_set_url(client, url.c_str());
+      esp_http_client_set_method(client, method_idf);
+    }
+
+    for (const auto &header : headers) {
+      esp_http_client_set_header(client, header.name, header.value);
+    }
+
+    err = esp_http_client_open(client, body_len);
+    if (err == ESP_OK || !reused)
+      break;
+    // the server has closed the idle connection in the meantime
+    ESP_LOGV(TAG, "Reconnecting to %s", host_key.c_str());
+    esp_http_client_cleanup(client);
+    client = nullptr;
+    reused = false;
+  }
 
   std::shared_ptr<HttpContainerIDF> container = std::make_shared<HttpContainerIDF>(client);
   container->set_parent(this);
 
   container->set_secure(secure);
-
+  container->host_key_ = std::move(host_key);
   for (const auto &header : headers) {
-    esp_http_client_set_header(client, header.name, header.value);
+    container->header_names_.emplace_back(header.name);
   }
 
-  const int body_len = body.length();
-
-  esp_err_t err = esp_http_client_open(client, body_len);
   if (err != ESP_OK) {
     this->status_momentary_error("failed", 1000);
     ESP_LOGE(TAG, "HTTP Request failed: %s", esp_err_to_name(err));
@@ -134,6 +165,8 @@ std::shared_ptr<HttpContainer> HttpRequestIDF::start(std::string url, std::strin
     };
     auto num_redirects = this->redirect_limit_;
     while (is_redirect(container->status_code) && num_redirects > 0) {
+      // the connection may now be to a different host
+      container->host_key_.clear();
       err = esp_http_client_set_redirection(client);
       if (err != ESP_OK) {
         ESP_LOGE(TAG, "esp_http_client_set_redirection failed: %s", esp_err_to_name(err));
@@ -187,9 +220,13 @@ int HttpContainerIDF::read(uint8_t *buf, size_t max_len) {
     return 0;
   }
 
-  App.feed_wdt();
+  this->parent_->feed_wdt();
   int read_len = esp_http_client_read(this->client_, (char *) buf, bufsize);
   this->bytes_read_ += read_len;
+  if (read_len == 0 && esp_http_client_is_complete_data_received(this->client_)) {
+    // the length of chunked responses is only known at the end
+    this->content_length = this->bytes_read_;
+  }
 
   this->duration_ms += (millis() - start);
 
@@ -199,8 +236,39 @@ int HttpContainerIDF::read(uint8_t *buf, size_t max_len) {
 void HttpContainerIDF::end() {
   watchdog::WatchdogManager wdm(this->parent_->get_watchdog_timeout());
 
-  esp_http_client_close(this->client_);
-  esp_http_client_cleanup(this->client_);
+  static_cast<HttpRequestIDF *>(this->parent_)->release_client(this);
+}
+
+esp_http_client_handle_t HttpRequestIDF::acquire_client_(const std::string &host_key) {
+  if (host_key.empty())
+    return nullptr;
+
+  LockGuard guard(this->idle_clients_lock_);
+  for (auto it = this->idle_clients_.begin(); it != this->idle_clients_.end(); ++it) {
+    if (it->first == host_key) {
+      esp_http_client_handle_t client = it->second;
+      this->idle_clients_.erase(it);
+      return client;
+    }
+  }
+  return nullptr;
+}
+
+void HttpRequestIDF::release_client(HttpContainerIDF *container) {
+  esp_http_client_handle_t client = container->client_;
+  // the connection can only be reused once the complete response has been read
+  if (!container->host_key_.empty() && esp_http_client_is_complete_data_received(client)) {
+    for (const auto &name : container->header_names_) {
+      esp_http_client_delete_header(client, name.c_str());
+    }
+    LockGuard guard(this->idle_clients_lock_);
+    if (this->idle_clients_.size() < MAX_IDLE_CLIENTS) {
+      this->idle_clients_.emplace_back(container->host_key_, client);
+      return;
+    }
+  }
+  esp_http_client_close(client);
+  esp_http_client_cleanup(client);
 }
 
 }  // namespace http_request
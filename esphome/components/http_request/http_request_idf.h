@@ -12,6 +12,8 @@
 namespace esphome {
 namespace http_request {
 
+class HttpRequestIDF;
+
 class HttpContainerIDF : public HttpContainer {
  public:
   HttpContainerIDF(esp_http_client_handle_t client) : client_(client) {}
@@ -19,7 +21,11 @@ class HttpContainerIDF : public HttpContainer {
   void end() override;
 
  protected:
+  friend class HttpRequestIDF;
   esp_http_client_handle_t client_;
+  /// Scheme, host and port of the connection, empty if the client can't be reused.
+  std::string host_key_;
+  std::vector<std::string> header_names_;
 };
 
 class HttpRequestIDF : public HttpRequestComponent {
@@ -31,8 +37,19 @@ class HttpRequestIDF : public HttpRequestComponent {
 
   void set_buffer_size_rx(uint16_t buffer_size_rx) { this->buffer_size_rx_ = buffer_size_rx; }
   void set_buffer_size_tx(uint16_t buffer_size_tx) { this->buffer_size_tx_ = buffer_size_tx; }
+  void set_keep_alive(bool keep_alive) { this->keep_alive_ = keep_alive; }
+
+  /// Keep the connection of a finished request open for the next request to the same host.
+  void release_client(HttpContainerIDF *container);
 
  protected:
+  esp_http_client_handle_t acquire_client_(const std::string &host_key);
+
+  bool keep_alive_{false};
+  /// Clients with an open connection, with the host they are connected to
+  std::vector<std::pair<std::string, esp_http_client_handle_t>> idle_clients_;
+  /// Requests are started from the main loop and the async worker task
+  Mutex idle_clients_lock_;
   // if zero ESP-IDF will use DEFAULT_HTTP_BUF_SIZE
   uint16_t buffer_size_rx_{};
   uint16_t buffer_size_tx_{};
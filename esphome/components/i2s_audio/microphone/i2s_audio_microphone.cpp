@@ -10,12 +10,60 @@
 namespace esphome {
 namespace i2s_audio {
 
-static const size_t BUFFER_SIZE = 512;
+static const size_t FRAME_LENGTH = 256;  // 16 ms at 16 kHz
+static const size_t FRAME_COUNT = 16;
+static const uint32_t READ_TIMEOUT_MS = 100;
+static const size_t TASK_STACK_SIZE = 3072;
+static const ssize_t TASK_PRIORITY = 23;
 
 static const char *const TAG = "i2s_audio.microphone";
 
+enum MicrophoneEventGroupBits : uint32_t {
+  COMMAND_STOP = (1 << 0),         // stops the read task
+  STATE_STOPPED = (1 << 1),        // set by the read task right before it deletes itself
+  WARNING_READ_FAILED = (1 << 2),  // the last read from the I2S port failed or timed out
+  ALL_BITS = 0x00FFFFFF,           // All valid FreeRTOS event group bits
+};
+
 void I2SAudioMicrophone::setup() {
   ESP_LOGCONFIG(TAG, "Setting up I2S Audio Microphone...");
+  this->event_group_ = xEventGroupCreate();
+  if (this->event_group_ == nullptr) {
+    ESP_LOGE(TAG, "Failed to create event group");
+    this->mark_failed();
+    return;
+  }
+
+  this->frame_buffer_ = make_unique<microphone::FrameBuffer>(FRAME_LENGTH, FRAME_COUNT);
+  if (!this->frame_buffer_->allocate()) {
+    ESP_LOGE(TAG, "Failed to allocate frame buffer");
+    this->mark_failed();
+    return;
+  }
+  this->read_reader_ = this->create_reader();
+  this->callback_reader_ = this->create_reader();
+
+  switch (this->bits_per_sample_) {
+    case I2S_BITS_PER_SAMPLE_8BIT:
+    case I2S_BITS_PER_SAMPLE_16BIT:
+      break;
+    case I2S_BITS_PER_SAMPLE_24BIT:
+    case I2S_BITS_PER_SAMPLE_32BIT: {
+      ExternalRAMAllocator<int32_t> allocator(ExternalRAMAllocator<int32_t>::ALLOW_FAILURE);
+      this->read_buffer_ = allocator.allocate(FRAME_LENGTH);
+      if (this->read_buffer_ == nullptr) {
+        ESP_LOGE(TAG, "Failed to allocate read buffer");
+        this->mark_failed();
+        return;
+      }
+      break;
+    }
+    default:
+      ESP_LOGE(TAG, "Unsupported bits per sample: %d", this->bits_per_sample_);
+      this->mark_failed();
+      return;
+  }
+
 #if SOC_I2S_SUPPORTS_ADC
   if (this->adc_) {
     if (this->parent_->get_port() != I2S_NUM_0) {
@@ -109,8 +157,23 @@ void I2SAudioMicrophone::start_() {
       return;
     }
   }
+  // Only hand out what is captured from now on
+  this->read_reader_->reset();
+  this->callback_reader_->reset();
+
+  xEventGroupClearBits(this->event_group_, ALL_BITS);
+  xTaskCreate(I2SAudioMicrophone::read_task, "microphone_task", TASK_STACK_SIZE, (void *) this, TASK_PRIORITY,
+              &this->read_task_handle_);
+  if (this->read_task_handle_ == nullptr) {
+    ESP_LOGW(TAG, "Failed to start read task");
+    this->status_set_error();
+    // Have the driver uninstalled again
+    xEventGroupSetBits(this->event_group_, STATE_STOPPED);
+    this->state_ = microphone::STATE_STOPPING;
+    return;
+  }
+
   this->state_ = microphone::STATE_RUNNING;
-  this->high_freq_.start();
   this->status_clear_error();
 }
 
@@ -125,6 +188,12 @@ void I2SAudioMicrophone::stop() {
 }
 
 void I2SAudioMicrophone::stop_() {
+  xEventGroupSetBits(this->event_group_, COMMAND_STOP);
+  if (!(xEventGroupGetBits(this->event_group_) & STATE_STOPPED)) {
+    return;  // Waiting for the read task to finish its current read
+  }
+  this->read_task_handle_ = nullptr;
+
   esp_err_t err;
 #if SOC_I2S_SUPPORTS_ADC
   if (this->adc_) {
@@ -150,50 +219,65 @@ void I2SAudioMicrophone::stop_() {
   }
   this->parent_->unlock();
   this->state_ = microphone::STATE_STOPPED;
-  this->high_freq_.stop();
   this->status_clear_error();
 }
 
-size_t I2SAudioMicrophone::read(int16_t *buf, size_t len) {
-  size_t bytes_read = 0;
-  esp_err_t err = i2s_read(this->parent_->get_port(), buf, len, &bytes_read, (100 / portTICK_PERIOD_MS));
-  if (err != ESP_OK) {
-    ESP_LOGW(TAG, "Error reading from I2S microphone: %s", esp_err_to_name(err));
-    this->status_set_warning();
-    return 0;
-  }
-  if (bytes_read == 0) {
-    this->status_set_warning();
-    return 0;
+void I2SAudioMicrophone::read_task(void *params) {
+  I2SAudioMicrophone *this_microphone = (I2SAudioMicrophone *) params;
+  microphone::FrameBuffer *frame_buffer = this_microphone->frame_buffer_.get();
+  const uint32_t frame_duration_us = FRAME_LENGTH * 1000000ULL / this_microphone->sample_rate_;
+
+  size_t filled = 0;
+  while (!(xEventGroupGetBits(this_microphone->event_group_) & COMMAND_STOP)) {
+    int16_t *frame = frame_buffer->get_write_frame();
+    filled += this_microphone->read_i2s_(frame + filled, FRAME_LENGTH - filled);
+    if (filled == FRAME_LENGTH) {
+      frame_buffer->commit_frame(micros() - frame_duration_us);
+      filled = 0;
+    }
   }
-  this->status_clear_warning();
+
+  xEventGroupSetBits(this_microphone->event_group_, STATE_STOPPED);
+  vTaskDelete(nullptr);
+}
+
+size_t I2SAudioMicrophone::read_i2s_(int16_t *buf, size_t len) {
   // ESP-IDF I2S implementation right-extends 8-bit data to 16 bits,
   // and 24-bit data to 32 bits.
-  switch (this->bits_per_sample_) {
-    case I2S_BITS_PER_SAMPLE_8BIT:
-    case I2S_BITS_PER_SAMPLE_16BIT:
-      return bytes_read;
-    case I2S_BITS_PER_SAMPLE_24BIT:
-    case I2S_BITS_PER_SAMPLE_32BIT: {
-      size_t samples_read = bytes_read / sizeof(int32_t);
-      for (size_t i = 0; i < samples_read; i++) {
-        int32_t temp = reinterpret_cast<int32_t *>(buf)[i] >> 14;
-        buf[i] = clamp<int16_t>(temp, INT16_MIN, INT16_MAX);
-      }
-      return samples_read * sizeof(int16_t);
+  void *dest = this->read_buffer_ != nullptr ? (void *) this->read_buffer_ : (void *) buf;
+  size_t sample_size = this->read_buffer_ != nullptr ? sizeof(int32_t) : sizeof(int16_t);
+
+  size_t bytes_read = 0;
+  esp_err_t err =
+      i2s_read(this->parent_->get_port(), dest, len * sample_size, &bytes_read, pdMS_TO_TICKS(READ_TIMEOUT_MS));
+  if (err != ESP_OK || bytes_read == 0) {
+    xEventGroupSetBits(this->event_group_, WARNING_READ_FAILED);
+    return 0;
+  }
+  xEventGroupClearBits(this->event_group_, WARNING_READ_FAILED);
+
+  size_t samples_read = bytes_read / sample_size;
+  if (this->read_buffer_ != nullptr) {
+    for (size_t i = 0; i < samples_read; i++) {
+      int32_t temp = this->read_buffer_[i] >> 14;
+      buf[i] = clamp<int16_t>(temp, INT16_MIN, INT16_MAX);
     }
-    default:
-      ESP_LOGE(TAG, "Unsupported bits per sample: %d", this->bits_per_sample_);
-      return 0;
   }
+  return samples_read;
+}
+
+size_t I2SAudioMicrophone::read(int16_t *buf, size_t len) {
+  if (this->read_reader_ == nullptr)
+    return 0;
+  return this->read_reader_->read_samples(buf, len / sizeof(int16_t), READ_TIMEOUT_MS) * sizeof(int16_t);
 }
 
 void I2SAudioMicrophone::read_() {
-  std::vector<int16_t> samples;
-  samples.resize(BUFFER_SIZE);
-  size_t bytes_read = this->read(samples.data(), BUFFER_SIZE / sizeof(int16_t));
-  samples.resize(bytes_read / sizeof(int16_t));
-  this->data_callbacks_.call(samples);
+  microphone::AudioFrame frame;
+  while (this->callback_reader_->read(frame)) {
+    this->callback_samples_.assign(frame.samples, frame.samples + frame.length);
+    this->data_callbacks_.call(this->callback_samples_);
+  }
 }
 
 void I2SAudioMicrophone::loop() {
@@ -204,6 +288,11 @@ void I2SAudioMicrophone::loop() {
       this->start_();
       break;
     case microphone::STATE_RUNNING:
+      if (xEventGroupGetBits(this->event_group_) & WARNING_READ_FAILED) {
+        this->status_set_warning();
+      } else {
+        this->status_clear_warning();
+      }
       if (this->data_callbacks_.size() > 0) {
         this->read_();
       }
@@ -4,6 +4,9 @@
 
 #include "../i2s_audio.h"
 
+#include <freertos/event_groups.h>
+#include <freertos/FreeRTOS.h>
+
 #include "esphome/components/microphone/microphone.h"
 #include "esphome/core/component.h"
 
@@ -21,6 +24,11 @@ class I2SAudioMicrophone : public I2SAudioIn, public microphone::Microphone, pub
   void set_din_pin(int8_t pin) { this->din_pin_ = pin; }
   void set_pdm(bool pdm) { this->pdm_ = pdm; }
 
+  /// @brief Copies captured audio into buf. The audio is shared with the readers from create_reader(), each of them
+  /// gets all of it.
+  /// @param buf Buffer to copy the samples into.
+  /// @param len Size of buf in bytes.
+  /// @return Number of bytes copied.
   size_t read(int16_t *buf, size_t len) override;
 
 #if SOC_I2S_SUPPORTS_ADC
@@ -31,9 +39,32 @@ class I2SAudioMicrophone : public I2SAudioIn, public microphone::Microphone, pub
 #endif
 
  protected:
+  /// @brief Function for the FreeRTOS task reading from the I2S port.
+  /// Fills the frame buffer until it receives the COMMAND_STOP signal via event_group_, then sets STATE_STOPPED and
+  /// deletes itself.
+  /// @param params I2SAudioMicrophone component
+  static void read_task(void *params);
+
   void start_();
   void stop_();
+  /// @brief Passes the captured frames to the data callbacks.
   void read_();
+  /// @brief Reads samples from the I2S port, converting them to 16 bits.
+  /// @param buf Buffer to store the samples in.
+  /// @param len Maximum number of samples to read.
+  /// @return Number of samples read.
+  size_t read_i2s_(int16_t *buf, size_t len);
+
+  TaskHandle_t read_task_handle_{nullptr};
+  EventGroupHandle_t event_group_{nullptr};
+
+  /// Holds the raw samples read from I2S if they have to be converted to 16 bits.
+  int32_t *read_buffer_{nullptr};
+
+  std::unique_ptr<microphone::FrameReader> read_reader_;
+  std::unique_ptr<microphone::FrameReader> callback_reader_;
+  /// Reused for every data callback so that passing the frames on does not allocate.
+  std::vector<int16_t> callback_samples_;
 
   int8_t din_pin_{I2S_PIN_NO_CHANGE};
 #if SOC_I2S_SUPPORTS_ADC
@@ -41,8 +72,6 @@ class I2SAudioMicrophone : public I2SAudioIn, public microphone::Microphone, pub
   bool adc_{false};
 #endif
   bool pdm_{false};
-
-  HighFrequencyLoopRequester high_freq_;
 };
 
 }  // namespace i2s_audio
@@ -4,6 +4,7 @@ from esphome.components import display, font, spi
 from esphome.components.display import validate_rotation
 import esphome.config_validation as cv
 from esphome.const import (
+    CONF_BUFFER_SIZE,
     CONF_COLOR_ORDER,
     CONF_COLOR_PALETTE,
     CONF_DC_PIN,
@@ -188,6 +189,9 @@ CONFIG_SCHEMA = cv.All(
                 }
             ),
             cv.Optional(CONF_INIT_SEQUENCE): cv.ensure_list(map_sequence),
+            cv.Optional(CONF_BUFFER_SIZE): cv.All(
+                cv.percentage, cv.Range(min=0.05)
+            ),
         }
     )
     .extend(cv.polling_component_schema("1s"))
@@ -211,6 +215,8 @@ async def to_code(config):
             sequence.extend(seq)
         cg.add(var.add_init_sequence(sequence))
 
+    if buffer_size := config.get(CONF_BUFFER_SIZE):
+        cg.add(var.set_buffer_size(buffer_size))
     if pixel_mode := config.get(CONF_PIXEL_MODE):
         cg.add(var.set_pixel_mode(pixel_mode))
     if CONF_COLOR_ORDER in config:
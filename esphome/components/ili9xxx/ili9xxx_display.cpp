@@ -57,6 +57,8 @@ void ILI9XXXDisplay::setup() {
 
   this->set_madctl();
   this->command(this->pre_invertcolors_ ? ILI9XXX_INVON : ILI9XXX_INVOFF);
+  this->buffer_rows_ = std::max(1, (int) ceilf(this->height_ * this->buffer_size_));
+  this->buffer_rows_ = std::min(this->buffer_rows_, this->height_);
   this->x_low_ = this->width_;
   this->y_low_ = this->height_;
   this->x_high_ = 0;
@@ -109,6 +111,9 @@ void ILI9XXXDisplay::dump_config() {
     ESP_LOGCONFIG(TAG, "  18-Bit Mode: YES");
   }
   ESP_LOGCONFIG(TAG, "  Data rate: %dMHz", (unsigned) (this->data_rate_ / 1000000));
+  if (this->buffer_rows_ < this->height_) {
+    ESP_LOGCONFIG(TAG, "  Buffer rows: %d of %d", this->buffer_rows_, this->height_);
+  }
 
   LOG_PIN("  Reset Pin: ", this->reset_pin_);
   LOG_PIN("  CS Pin: ", this->cs_);
@@ -133,9 +138,9 @@ void ILI9XXXDisplay::fill(Color color) {
     return;
   uint16_t new_color = 0;
   this->x_low_ = 0;
-  this->y_low_ = 0;
+  this->y_low_ = this->band_start_;
   this->x_high_ = this->get_width_internal() - 1;
-  this->y_high_ = this->get_height_internal() - 1;
+  this->y_high_ = this->band_start_ + this->buffer_rows_ - 1;
   switch (this->buffer_color_mode_) {
     case BITS_8_INDEXED:
       new_color = display::ColorUtil::color_to_index8_palette888(color, this->palette_);
@@ -148,10 +153,15 @@ void ILI9XXXDisplay::fill(Color color) {
           // Upper and lower is equal can use quicker memset operation. Takes ~20ms.
           memset(this->buffer_, (uint8_t) new_color, buffer_length_16_bits);
         } else {
-          for (uint32_t i = 0; i < buffer_length_16_bits; i = i + 2) {
+          // fill the first row and copy it to the others
+          const uint32_t row_length = this->get_width_internal() * 2;
+          for (uint32_t i = 0; i < row_length; i = i + 2) {
             this->buffer_[i] = (uint8_t) (new_color >> 8);
             this->buffer_[i + 1] = (uint8_t) new_color;
           }
+          for (uint32_t i = row_length; i < buffer_length_16_bits; i += row_length) {
+            memcpy(this->buffer_ + i, this->buffer_, row_length);
+          }
         }
       }
       return;
@@ -166,9 +176,12 @@ void HOT ILI9XXXDisplay::draw_absolute_pixel_internal(int x, int y, Color color)
   if (x >= this->get_width_internal() || x < 0 || y >= this->get_height_internal() || y < 0) {
     return;
   }
+  // only the rows of the current band are buffered
+  if (y < this->band_start_ || y >= this->band_start_ + this->buffer_rows_)
+    return;
   if (!this->check_buffer_())
     return;
-  uint32_t pos = (y * width_) + x;
+  uint32_t pos = ((y - this->band_start_) * width_) + x;
   uint16_t new_color;
   bool updated = false;
   switch (this->buffer_color_mode_) {
@@ -207,12 +220,71 @@ void HOT ILI9XXXDisplay::draw_absolute_pixel_internal(int x, int y, Color color)
   }
 }
 
+void HOT ILI9XXXDisplay::draw_absolute_row_internal(int x, int y, int w, const Color *colors) {
+  if (this->buffer_color_mode_ != BITS_16) {
+    display::DisplayBuffer::draw_absolute_row_internal(x, y, w, colors);
+    return;
+  }
+  if (y < this->band_start_ || y >= this->band_start_ + this->buffer_rows_)
+    return;
+  if (!this->check_buffer_())
+    return;
+  uint8_t *dst = this->buffer_ + ((y - this->band_start_) * this->width_ + x) * 2;
+  int first = w;
+  int last = -1;
+  for (int i = 0; i != w; i++, dst += 2) {
+    uint16_t new_color = display::ColorUtil::color_to_565(colors[i], display::ColorOrder::COLOR_ORDER_RGB);
+    if (dst[0] != (uint8_t) (new_color >> 8) || dst[1] != (uint8_t) new_color) {
+      dst[0] = new_color >> 8;
+      dst[1] = new_color;
+      first = std::min(first, i);
+      last = i;
+    }
+  }
+  if (last >= first)
+    this->mark_row_updated_(x + first, y, last - first + 1);
+}
+
+void HOT ILI9XXXDisplay::draw_absolute_rgb565_row_internal(int x, int y, int w, const uint8_t *data) {
+  if (this->buffer_color_mode_ != BITS_16) {
+    display::DisplayBuffer::draw_absolute_rgb565_row_internal(x, y, w, data);
+    return;
+  }
+  if (y < this->band_start_ || y >= this->band_start_ + this->buffer_rows_)
+    return;
+  if (!this->check_buffer_())
+    return;
+  // the buffer holds big-endian RGB565 as well
+  uint8_t *dst = this->buffer_ + ((y - this->band_start_) * this->width_ + x) * 2;
+  if (memcmp(dst, data, w * 2) != 0) {
+    memcpy(dst, data, w * 2);
+    this->mark_row_updated_(x, y, w);
+  }
+}
+
+void ILI9XXXDisplay::mark_row_updated_(int x, int y, int w) {
+  // low and high watermark may speed up drawing from buffer
+  if (x < this->x_low_)
+    this->x_low_ = x;
+  if (y < this->y_low_)
+    this->y_low_ = y;
+  if (x + w - 1 > this->x_high_)
+    this->x_high_ = x + w - 1;
+  if (y > this->y_high_)
+    this->y_high_ = y;
+}
+
 void ILI9XXXDisplay::update() {
   if (this->prossing_update_) {
     this->need_update_ = true;
     return;
   }
   this->prossing_update_ = true;
+  if (this->buffer_rows_ < this->height_) {
+    this->update_bands_();
+    this->prossing_update_ = false;
+    return;
+  }
   do {
     this->need_update_ = false;
     this->do_update_();
@@ -221,6 +293,35 @@ void ILI9XXXDisplay::update() {
   this->display_();
 }
 
+// The buffer holds only some rows, so the writer is run once for each band of rows, which is then written to the
+// display before the buffer is reused for the next band.
+void ILI9XXXDisplay::update_bands_() {
+  for (int y = 0;; y += this->buffer_rows_) {
+    // the last band overlaps the previous one rather than being shorter
+    int band_start = std::min(y, this->height_ - this->buffer_rows_);
+    do {
+      this->need_update_ = false;
+      this->start_band_(band_start, this->buffer_rows_);
+      // the buffer still holds the previous band, so it can't keep its contents between updates. A buffer that
+      // has not been allocated is not used by the writer, e.g. when drawing bypasses it.
+      if (!this->auto_clear_enabled_ && this->buffer_ != nullptr)
+        this->clear();
+      this->do_update_();
+    } while (this->need_update_);
+    this->display_();
+    if (band_start + this->buffer_rows_ >= this->height_)
+      break;
+    App.feed_wdt();
+  }
+  this->band_start_ = 0;
+}
+
+void ILI9XXXDisplay::loop() {
+  // completes the transfer of the last update once all queued writes are done
+  if (this->pending_queued_writes() == 0)
+    this->buffer_transfer_pending_ = false;
+}
+
 void ILI9XXXDisplay::display_() {
   // check if something was displayed
   if ((this->x_high_ < this->x_low_) || (this->y_high_ < this->y_low_)) {
@@ -246,15 +347,18 @@ void ILI9XXXDisplay::display_() {
     // 16 bit mode maps directly to display format
     ESP_LOGV(TAG, "Doing single write of %zu bytes", this->width_ * h * 2);
     set_addr_window_(0, this->y_low_, this->width_ - 1, this->y_high_);
-    this->write_array(this->buffer_ + this->y_low_ * this->width_ * 2, h * this->width_ * 2);
+    // the rows are written in the background, the buffer must not be changed until that has completed
+    this->queue_write_array(this->buffer_ + (this->y_low_ - this->band_start_) * this->width_ * 2,
+                            h * this->width_ * 2);
+    this->buffer_transfer_pending_ = true;
   } else {
     ESP_LOGV(TAG, "Doing multiple write");
-    uint8_t transfer_buffer[ILI9XXX_TRANSFER_BUFFER_SIZE];
+    uint8_t *transfer_buffer = this->get_transfer_block_();
     size_t rem = h * w;  // remaining number of pixels to write
     set_addr_window_(this->x_low_, this->y_low_, this->x_high_, this->y_high_);
     size_t idx = 0;    // index into transfer_buffer
     size_t pixel = 0;  // pixel number offset
-    size_t pos = this->y_low_ * this->width_ + this->x_low_;
+    size_t pos = (this->y_low_ - this->band_start_) * this->width_ + this->x_low_;
     while (rem-- != 0) {
       uint16_t color_val;
       switch (this->buffer_color_mode_) {
@@ -278,8 +382,9 @@ void ILI9XXXDisplay::display_() {
         put16_be(transfer_buffer + idx, color_val);
         idx += 2;
       }
-      if (idx == sizeof(transfer_buffer)) {
-        this->write_array(transfer_buffer, idx);
+      if (idx == ILI9XXX_TRANSFER_BLOCK_SIZE) {
+        this->write_transfer_block_(idx);
+        transfer_buffer = this->get_transfer_block_();
         idx = 0;
         App.feed_wdt();
       }
@@ -291,7 +396,7 @@ void ILI9XXXDisplay::display_() {
     }
     // flush any balance.
     if (idx != 0) {
-      this->write_array(transfer_buffer, idx);
+      this->write_transfer_block_(idx);
     }
   }
   this->end_data_();
@@ -330,7 +435,7 @@ void ILI9XXXDisplay::draw_pixels_at(int x_start, int y_start, int w, int h, cons
     }
   } else {
     // 18 bit mode
-    uint8_t transfer_buffer[ILI9XXX_TRANSFER_BUFFER_SIZE * 4];
+    uint8_t *transfer_buffer = this->get_transfer_block_();
     ESP_LOGV(TAG, "Doing multiple write");
     size_t rem = h * w;  // remaining number of pixels to write
     size_t idx = 0;      // index into transfer_buffer
@@ -342,8 +447,9 @@ void ILI9XXXDisplay::draw_pixels_at(int x_start, int y_start, int w, int h, cons
       transfer_buffer[idx++] = hi_byte & 0xF8;                     // Blue
       transfer_buffer[idx++] = ((hi_byte << 5) | (lo_byte) >> 5);  // Green
       transfer_buffer[idx++] = lo_byte << 3;                       // Red
-      if (idx == sizeof(transfer_buffer)) {
-        this->write_array(transfer_buffer, idx);
+      if (idx == ILI9XXX_TRANSFER_BLOCK_SIZE) {
+        this->write_transfer_block_(idx);
+        transfer_buffer = this->get_transfer_block_();
         idx = 0;
         App.feed_wdt();
       }
@@ -355,15 +461,84 @@ void ILI9XXXDisplay::draw_pixels_at(int x_start, int y_start, int w, int h, cons
     }
     // flush any balance.
     if (idx != 0) {
-      this->write_array(transfer_buffer, idx);
+      this->write_transfer_block_(idx);
     }
   }
   this->end_data_();
 }
 
+// note that this bypasses the buffer and writes directly to the display.
+void ILI9XXXDisplay::queue_draw_pixels_at(int x_start, int y_start, int w, int h, const uint8_t *ptr,
+                                          display::ColorOrder order, display::ColorBitness bitness, bool big_endian) {
+  if (w <= 0 || h <= 0)
+    return;
+  // only pixels in the display format can be written from the caller's buffer
+  if (this->rotation_ != display::DISPLAY_ROTATION_0_DEGREES || bitness != display::COLOR_BITNESS_565 || !big_endian ||
+      this->is_18bitdisplay_) {
+    this->draw_pixels_at(x_start, y_start, w, h, ptr, order, bitness, big_endian, 0, 0, 0);
+    return;
+  }
+  this->set_addr_window_(x_start, y_start, x_start + w - 1, y_start + h - 1);
+  this->queue_write_array(ptr, w * h * 2);
+  this->end_data_();
+}
+
+bool ILI9XXXDisplay::draw_pixels_complete(bool wait) {
+  if (wait) {
+    this->wait_queued_writes();
+    return true;
+  }
+  return this->pending_queued_writes() == 0;
+}
+
+// note that this bypasses the buffer and writes directly to the display.
+void ILI9XXXDisplay::fill_rect(int x_start, int y_start, int w, int h, Color color) {
+  // software rotation is done by the buffer
+  if (this->rotation_ != display::DISPLAY_ROTATION_0_DEGREES) {
+    this->filled_rectangle(x_start, y_start, w, h, color);
+    return;
+  }
+  int x_end = std::min(x_start + w, (int) this->width_);
+  int y_end = std::min(y_start + h, (int) this->height_);
+  x_start = std::max(x_start, 0);
+  y_start = std::max(y_start, 0);
+  if (x_end <= x_start || y_end <= y_start)
+    return;
+  this->set_addr_window_(x_start, y_start, x_end - 1, y_end - 1);
+
+  // fill one block with the color and write it as often as required, it is not changed while queued.
+  const size_t pixel_size = this->is_18bitdisplay_ ? 3 : 2;
+  uint8_t *transfer_buffer = this->get_transfer_block_();
+  uint16_t color_val = display::ColorUtil::color_to_565(color);
+  size_t rem = (size_t) (x_end - x_start) * (y_end - y_start) * pixel_size;
+  size_t block_size = std::min(rem, ILI9XXX_TRANSFER_BLOCK_SIZE);
+  for (size_t idx = 0; idx != block_size; idx += pixel_size) {
+    if (this->is_18bitdisplay_) {
+      transfer_buffer[idx] = (uint8_t) ((color_val & 0xF800) >> 8);     // Blue
+      transfer_buffer[idx + 1] = (uint8_t) ((color_val & 0x7E0) >> 3);  // Green
+      transfer_buffer[idx + 2] = (uint8_t) (color_val << 3);            // Red
+    } else {
+      put16_be(transfer_buffer + idx, color_val);
+    }
+  }
+  while (rem != 0) {
+    size_t const partial = std::min(rem, block_size);
+    this->queue_write_array(transfer_buffer, partial);
+    rem -= partial;
+  }
+  this->end_data_();
+}
+
+void ILI9XXXDisplay::write_transfer_block_(size_t length) {
+  this->queue_write_array(this->transfer_blocks_[this->transfer_block_index_], length);
+  this->transfer_block_index_ = (this->transfer_block_index_ + 1) % ILI9XXX_TRANSFER_BLOCKS;
+  // the next block can be filled once its previous contents have been written
+  this->wait_queued_writes(ILI9XXX_TRANSFER_BLOCKS - 1);
+}
+
 // should return the total size: return this->get_width_internal() * this->get_height_internal() * 2 // 16bit color
 // values per bit is huge
-uint32_t ILI9XXXDisplay::get_buffer_length_() { return this->get_width_internal() * this->get_height_internal(); }
+uint32_t ILI9XXXDisplay::get_buffer_length_() { return this->get_width_internal() * this->buffer_rows_; }
 
 void ILI9XXXDisplay::command(uint8_t value) {
   this->start_command_();
@@ -384,11 +559,14 @@ void ILI9XXXDisplay::send_command(uint8_t command_byte, const uint8_t *data_byte
   this->end_data_();
 }
 
+// queued writes have to complete before the DC pin changes.
 void ILI9XXXDisplay::start_command_() {
+  this->wait_queued_writes();
   this->dc_pin_->digital_write(false);
   this->enable();
 }
 void ILI9XXXDisplay::start_data_() {
+  this->wait_queued_writes();
   this->dc_pin_->digital_write(true);
   this->enable();
 }
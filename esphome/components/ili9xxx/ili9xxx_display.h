@@ -10,6 +10,14 @@ namespace ili9xxx {
 
 static const char *const TAG = "ili9xxx";
 const size_t ILI9XXX_TRANSFER_BUFFER_SIZE = 126;  // ensure this is divisible by 6
+#ifdef USE_ESP_IDF
+// pixels are converted into one block while the other one is written by DMA
+const size_t ILI9XXX_TRANSFER_BLOCKS = 2;
+const size_t ILI9XXX_TRANSFER_BLOCK_SIZE = 1536;  // ensure this is divisible by 6
+#else
+const size_t ILI9XXX_TRANSFER_BLOCKS = 1;
+const size_t ILI9XXX_TRANSFER_BLOCK_SIZE = ILI9XXX_TRANSFER_BUFFER_SIZE * 4;
+#endif
 
 enum ILI9XXXColorMode {
   BITS_8 = 0x08,
@@ -65,6 +73,8 @@ class ILI9XXXDisplay : public display::DisplayBuffer,
   void set_reset_pin(GPIOPin *reset) { this->reset_pin_ = reset; }
   void set_palette(const uint8_t *palette) { this->palette_ = palette; }
   void set_buffer_color_mode(ILI9XXXColorMode color_mode) { this->buffer_color_mode_ = color_mode; }
+  /// Set the fraction of the display held in the buffer. Below 1, the display is rendered in bands of rows.
+  void set_buffer_size(float buffer_size) { this->buffer_size_ = buffer_size; }
   void set_dimensions(int16_t width, int16_t height) {
     this->height_ = height;
     this->width_ = width;
@@ -84,8 +94,11 @@ class ILI9XXXDisplay : public display::DisplayBuffer,
   void set_pixel_mode(PixelMode mode) { this->pixel_mode_ = mode; }
 
   void update() override;
+  void loop() override;
 
   void fill(Color color) override;
+  /// Fill a rectangle with a single color. Note that this bypasses the buffer and writes directly to the display.
+  void fill_rect(int x_start, int y_start, int w, int h, Color color);
 
   void dump_config() override;
   void setup() override;
@@ -94,9 +107,17 @@ class ILI9XXXDisplay : public display::DisplayBuffer,
   display::DisplayType get_display_type() override { return display::DisplayType::DISPLAY_TYPE_COLOR; }
   void draw_pixels_at(int x_start, int y_start, int w, int h, const uint8_t *ptr, display::ColorOrder order,
                       display::ColorBitness bitness, bool big_endian, int x_offset, int y_offset, int x_pad) override;
+  void queue_draw_pixels_at(int x_start, int y_start, int w, int h, const uint8_t *ptr, display::ColorOrder order,
+                            display::ColorBitness bitness, bool big_endian) override;
+  bool draw_pixels_complete(bool wait) override;
 
  protected:
   inline bool check_buffer_() {
+    if (this->buffer_transfer_pending_) {
+      // the buffer is still being written to the display
+      this->wait_queued_writes();
+      this->buffer_transfer_pending_ = false;
+    }
     if (this->buffer_ == nullptr) {
       this->alloc_buffer_();
       return !this->is_failed();
@@ -105,12 +126,18 @@ class ILI9XXXDisplay : public display::DisplayBuffer,
   }
 
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
+  void draw_absolute_row_internal(int x, int y, int w, const Color *colors) override;
+  void draw_absolute_rgb565_row_internal(int x, int y, int w, const uint8_t *data) override;
+  void mark_row_updated_(int x, int y, int w);
+  void update_bands_();
   void setup_pins_();
 
   virtual void set_madctl();
   void display_();
   void init_lcd_(const uint8_t *addr);
   void set_addr_window_(uint16_t x, uint16_t y, uint16_t x2, uint16_t y2);
+  uint8_t *get_transfer_block_() { return this->transfer_blocks_[this->transfer_block_index_]; }
+  void write_transfer_block_(size_t length);
   void reset_();
 
   uint8_t const *init_sequence_{};
@@ -126,6 +153,8 @@ class ILI9XXXDisplay : public display::DisplayBuffer,
   const uint8_t *palette_{};
 
   ILI9XXXColorMode buffer_color_mode_{BITS_16};
+  float buffer_size_{1.0f};
+  int16_t buffer_rows_{0};  ///< Number of rows held by the buffer
 
   uint32_t get_buffer_length_();
   int get_width_internal() override;
@@ -141,6 +170,9 @@ class ILI9XXXDisplay : public display::DisplayBuffer,
   GPIOPin *dc_pin_{nullptr};
   GPIOPin *busy_pin_{nullptr};
 
+  uint8_t transfer_blocks_[ILI9XXX_TRANSFER_BLOCKS][ILI9XXX_TRANSFER_BLOCK_SIZE];
+  uint8_t transfer_block_index_{0};
+  bool buffer_transfer_pending_{false};
   bool prossing_update_ = false;
   bool need_update_ = false;
   bool is_18bitdisplay_ = false;
@@ -2,63 +2,107 @@
 
 #include "esphome/core/hal.h"
 
+#include <algorithm>
+
 namespace esphome {
 namespace image {
 
+/// Collects consecutive visible pixels of an image row and draws them with a single call.
+class RowSpan {
+ public:
+  RowSpan(display::Display *display, int x, int y) : display_(display), x_(x), y_(y) {}
+  ~RowSpan() { this->flush(); }
+
+  inline void add(int img_x, Color color) ESPHOME_ALWAYS_INLINE {
+    if (this->len_ == display::ROW_CHUNK_SIZE || (this->len_ != 0 && img_x != this->start_ + this->len_))
+      this->flush();
+    if (this->len_ == 0)
+      this->start_ = img_x;
+    this->colors_[this->len_++] = color;
+  }
+  void flush() {
+    if (this->len_ != 0)
+      this->display_->draw_row_at(this->x_ + this->start_, this->y_, this->len_, this->colors_);
+    this->len_ = 0;
+  }
+
+ protected:
+  display::Display *display_;
+  int x_;
+  int y_;
+  int start_{0};
+  int len_{0};
+  Color colors_[display::ROW_CHUNK_SIZE];
+};
+
 void Image::draw(int x, int y, display::Display *display, Color color_on, Color color_off) {
-  switch (type_) {
-    case IMAGE_TYPE_BINARY: {
-      for (int img_x = 0; img_x < width_; img_x++) {
-        for (int img_y = 0; img_y < height_; img_y++) {
+  // rows and columns outside the display don't have to be decoded
+  const int min_x = std::max(0, -x);
+  const int max_x = std::min(this->width_, display->get_width() - x);
+  const int min_y = std::max(0, -y);
+  const int max_y = std::min(this->height_, display->get_height() - y);
+  if (min_x >= max_x)
+    return;
+
+  for (int img_y = min_y; img_y < max_y; img_y++) {
+    if (this->type_ == IMAGE_TYPE_RGB565 && !this->transparent_) {
+      // opaque RGB565 rows are passed on as they are
+      const uint8_t *row = this->data_start_ + (img_y * this->width_ + min_x) * 2;
+#ifdef USE_ESP8266
+      // flash can't be read byte by byte on the ESP8266, copy the row in chunks
+      uint8_t buf[display::ROW_CHUNK_SIZE * 2];
+      for (int img_x = min_x; img_x < max_x; img_x += display::ROW_CHUNK_SIZE) {
+        int len = std::min(max_x - img_x, display::ROW_CHUNK_SIZE);
+        for (int i = 0; i != len * 2; i++)
+          buf[i] = progmem_read_byte(row + (img_x - min_x) * 2 + i);
+        display->draw_rgb565_row_at(x + img_x, y + img_y, len, buf);
+      }
+#else
+      display->draw_rgb565_row_at(x + min_x, y + img_y, max_x - min_x, row);
+#endif
+      continue;
+    }
+
+    RowSpan span(display, x, y + img_y);
+    switch (this->type_) {
+      case IMAGE_TYPE_BINARY:
+        for (int img_x = min_x; img_x < max_x; img_x++) {
           if (this->get_binary_pixel_(img_x, img_y)) {
-            display->draw_pixel_at(x + img_x, y + img_y, color_on);
+            span.add(img_x, color_on);
           } else if (!this->transparent_) {
-            display->draw_pixel_at(x + img_x, y + img_y, color_off);
+            span.add(img_x, color_off);
           }
         }
-      }
-      break;
-    }
-    case IMAGE_TYPE_GRAYSCALE:
-      for (int img_x = 0; img_x < width_; img_x++) {
-        for (int img_y = 0; img_y < height_; img_y++) {
+        break;
+      case IMAGE_TYPE_GRAYSCALE:
+        for (int img_x = min_x; img_x < max_x; img_x++) {
           auto color = this->get_grayscale_pixel_(img_x, img_y);
-          if (color.w >= 0x80) {
-            display->draw_pixel_at(x + img_x, y + img_y, color);
-          }
+          if (color.w >= 0x80)
+            span.add(img_x, color);
         }
-      }
-      break;
-    case IMAGE_TYPE_RGB565:
-      for (int img_x = 0; img_x < width_; img_x++) {
-        for (int img_y = 0; img_y < height_; img_y++) {
+        break;
+      case IMAGE_TYPE_RGB565:
+        for (int img_x = min_x; img_x < max_x; img_x++) {
           auto color = this->get_rgb565_pixel_(img_x, img_y);
-          if (color.w >= 0x80) {
-            display->draw_pixel_at(x + img_x, y + img_y, color);
-          }
+          if (color.w >= 0x80)
+            span.add(img_x, color);
         }
-      }
-      break;
-    case IMAGE_TYPE_RGB24:
-      for (int img_x = 0; img_x < width_; img_x++) {
-        for (int img_y = 0; img_y < height_; img_y++) {
+        break;
+      case IMAGE_TYPE_RGB24:
+        for (int img_x = min_x; img_x < max_x; img_x++) {
           auto color = this->get_rgb24_pixel_(img_x, img_y);
-          if (color.w >= 0x80) {
-            display->draw_pixel_at(x + img_x, y + img_y, color);
-          }
+          if (color.w >= 0x80)
+            span.add(img_x, color);
         }
-      }
-      break;
-    case IMAGE_TYPE_RGBA:
-      for (int img_x = 0; img_x < width_; img_x++) {
-        for (int img_y = 0; img_y < height_; img_y++) {
+        break;
+      case IMAGE_TYPE_RGBA:
+        for (int img_x = min_x; img_x < max_x; img_x++) {
           auto color = this->get_rgba_pixel_(img_x, img_y);
-          if (color.w >= 0x80) {
-            display->draw_pixel_at(x + img_x, y + img_y, color);
-          }
+          if (color.w >= 0x80)
+            span.add(img_x, color);
         }
-      }
-      break;
+        break;
+    }
   }
 }
 Color Image::get_pixel(int x, int y, Color color_on, Color color_off) const {
@@ -150,10 +194,7 @@ Color Image::get_rgb565_pixel_(int x, int y) const {
   const uint32_t pos = (x + y * this->width_) * 2;
   uint16_t rgb565 =
       progmem_read_byte(this->data_start_ + pos + 0) << 8 | progmem_read_byte(this->data_start_ + pos + 1);
-  auto r = (rgb565 & 0xF800) >> 11;
-  auto g = (rgb565 & 0x07E0) >> 5;
-  auto b = rgb565 & 0x001F;
-  Color color = Color((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2));
+  Color color = display::ColorUtil::rgb565_to_color(rgb565);
   if (rgb565 == 0x0020 && transparent_) {
     // darkest green has been defined as transparent color for transparent RGB565 images.
     color.w = 0;
@@ -1,4 +1,5 @@
 #include "kuntze.h"
+#include "esphome/core/hal.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
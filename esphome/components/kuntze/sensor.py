@@ -1,6 +1,6 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
-from esphome.components import sensor, modbus
+from esphome.components import sensor, modbus_hub
 from esphome.const import (
     CONF_ID,
     CONF_EC,
@@ -18,10 +18,10 @@ from esphome.const import (
 
 CODEOWNERS = ["@ssieb"]
 
-AUTO_LOAD = ["modbus"]
+AUTO_LOAD = ["modbus_hub"]
 
 kuntze_ns = cg.esphome_ns.namespace("kuntze")
-Kuntze = kuntze_ns.class_("Kuntze", cg.PollingComponent, modbus.ModbusDevice)
+Kuntze = kuntze_ns.class_("Kuntze", cg.PollingComponent, modbus_hub.ModbusDevice)
 
 CONF_DIS1 = "dis1"
 CONF_DIS2 = "dis2"
@@ -84,14 +84,14 @@ CONFIG_SCHEMA = (
         }
     )
     .extend(cv.polling_component_schema("60s"))
-    .extend(modbus.modbus_device_schema(0x01))
+    .extend(modbus_hub.modbus_device_schema(0x01))
 )
 
 
 async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     await cg.register_component(var, config)
-    await modbus.register_modbus_device(var, config)
+    await modbus_hub.register_modbus_device(var, config)
 
     if CONF_PH in config:
         conf = config[CONF_PH]
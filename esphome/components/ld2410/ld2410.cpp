@@ -15,6 +15,7 @@ namespace esphome {
 namespace ld2410 {
 
 static const char *const TAG = "ld2410";
+static const size_t MAX_LINE_LENGTH = 80;
 
 LD2410Component::LD2410Component() {}
 
@@ -79,6 +80,21 @@ void LD2410Component::dump_config() {
 
 void LD2410Component::setup() {
   ESP_LOGCONFIG(TAG, "Setting up LD2410...");
+  // Both data and ACK frames are "header, 2 byte little endian length, payload, footer"
+  uart::UARTFrameConfig frame_config;
+  frame_config.mode = uart::UART_FRAME_LENGTH;
+  frame_config.length_offset = 4;
+  frame_config.length_size = 2;
+  frame_config.length_little_endian = true;
+  frame_config.length_overhead = 10;
+  frame_config.headers = {{0xF4, 0xF3, 0xF2, 0xF1}, {0xFD, 0xFC, 0xFB, 0xFA}};
+  frame_config.max_frame_size = MAX_LINE_LENGTH;
+  frame_config.buffer_size = 4 * MAX_LINE_LENGTH;
+  this->frame_receiver_ = this->start_frame_receiver(frame_config, [this](uint8_t *data, size_t len) {
+    if (len < 4)
+      return;
+    this->handle_frame_(data, len);
+  });
   this->read_all_info();
   ESP_LOGCONFIG(TAG, "Mac Address : %s", const_cast<char *>(this->mac_.c_str()));
   ESP_LOGCONFIG(TAG, "Firmware Version : %s", const_cast<char *>(this->version_.c_str()));
@@ -108,11 +124,14 @@ void LD2410Component::restart_and_read_all_info() {
 }
 
 void LD2410Component::loop() {
-  const int max_line_length = 80;
-  static uint8_t buffer[max_line_length];
+  // frames are delivered by the UART frame receiver callback
+  if (this->frame_receiver_)
+    return;
+
+  static uint8_t buffer[MAX_LINE_LENGTH];
 
   while (available()) {
-    this->readline_(read(), buffer, max_line_length);
+    this->readline_(read(), buffer, MAX_LINE_LENGTH);
   }
 }
 
@@ -485,24 +504,27 @@ void LD2410Component::readline_(int readch, uint8_t *buffer, int len) {
     } else {
       pos = 0;
     }
-    if (pos >= 4) {
-      if (buffer[pos - 4] == 0xF8 && buffer[pos - 3] == 0xF7 && buffer[pos - 2] == 0xF6 && buffer[pos - 1] == 0xF5) {
-        ESP_LOGV(TAG, "Will handle Periodic Data");
-        this->handle_periodic_data_(buffer, pos);
-        pos = 0;  // Reset position index ready for next time
-      } else if (buffer[pos - 4] == 0x04 && buffer[pos - 3] == 0x03 && buffer[pos - 2] == 0x02 &&
-                 buffer[pos - 1] == 0x01) {
-        ESP_LOGV(TAG, "Will handle ACK Data");
-        if (this->handle_ack_data_(buffer, pos)) {
-          pos = 0;  // Reset position index ready for next time
-        } else {
-          ESP_LOGV(TAG, "ACK Data incomplete");
-        }
-      }
+    if (pos >= 4 && this->handle_frame_(buffer, pos)) {
+      pos = 0;  // Reset position index ready for next time
     }
   }
 }
 
+bool LD2410Component::handle_frame_(uint8_t *buffer, int len) {
+  if (buffer[len - 4] == 0xF8 && buffer[len - 3] == 0xF7 && buffer[len - 2] == 0xF6 && buffer[len - 1] == 0xF5) {
+    ESP_LOGV(TAG, "Will handle Periodic Data");
+    this->handle_periodic_data_(buffer, len);
+    return true;
+  }
+  if (buffer[len - 4] == 0x04 && buffer[len - 3] == 0x03 && buffer[len - 2] == 0x02 && buffer[len - 1] == 0x01) {
+    ESP_LOGV(TAG, "Will handle ACK Data");
+    if (this->handle_ack_data_(buffer, len))
+      return true;
+    ESP_LOGV(TAG, "ACK Data incomplete");
+  }
+  return false;
+}
+
 void LD2410Component::set_config_mode_(bool enable) {
   uint8_t cmd = enable ? CMD_ENABLE_CONF : CMD_DISABLE_CONF;
   uint8_t cmd_value[2] = {0x01, 0x00};
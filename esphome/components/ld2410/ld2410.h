@@ -208,6 +208,7 @@ class LD2410Component : public Component, public uart::UARTDevice {
   void handle_periodic_data_(uint8_t *buffer, int len);
   bool handle_ack_data_(uint8_t *buffer, int len);
   void readline_(int readch, uint8_t *buffer, int len);
+  bool handle_frame_(uint8_t *buffer, int len);
   void query_parameters_();
   void get_version_();
   void get_mac_();
@@ -215,6 +216,7 @@ class LD2410Component : public Component, public uart::UARTDevice {
   void get_light_control_();
   void restart_();
 
+  bool frame_receiver_{false};
   int32_t last_periodic_millis_ = millis();
   int32_t last_engineering_mode_change_millis_ = millis();
   uint16_t throttle_;
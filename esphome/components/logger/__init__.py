@@ -169,6 +169,8 @@ LoggerMessageTrigger = logger_ns.class_(
     automation.Trigger.template(cg.int_, cg.const_char_ptr, cg.const_char_ptr),
 )
 
+CONF_ASYNC_BUFFER_SIZE = "async_buffer_size"
+CONF_BINARY_FORMAT = "binary_format"
 CONF_ESP8266_STORE_LOG_STRINGS_IN_FLASH = "esp8266_store_log_strings_in_flash"
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
@@ -177,6 +179,12 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(CONF_BAUD_RATE, default=115200): cv.positive_int,
             cv.Optional(CONF_TX_BUFFER_SIZE, default=512): cv.validate_bytes,
             cv.Optional(CONF_DEASSERT_RTS_DTR, default=False): cv.boolean,
+            # Queue messages and output them from the main loop
+            cv.Optional(CONF_ASYNC_BUFFER_SIZE): cv.All(
+                cv.only_on_esp32,
+                cv.validate_bytes,
+                cv.int_range(min=512, max=32768),
+            ),
             cv.SplitDefault(
                 CONF_HARDWARE_UART,
                 esp8266=UART0,
@@ -202,6 +210,19 @@ CONFIG_SCHEMA = cv.All(
                 uart_selection,
             ),
             cv.Optional(CONF_LEVEL, default="DEBUG"): is_log_level,
+            # Formatted by `esphome logs` from the firmware, see binary_log.py
+            cv.Optional(CONF_BINARY_FORMAT): cv.All(
+                cv.only_on(
+                    [
+                        PLATFORM_ESP8266,
+                        PLATFORM_ESP32,
+                        PLATFORM_RP2040,
+                        PLATFORM_BK72XX,
+                        PLATFORM_RTL87XX,
+                    ]
+                ),
+                cv.boolean,
+            ),
             cv.Optional(CONF_LOGS, default={}): cv.Schema(
                 {
                     cv.string: is_log_level,
@@ -232,6 +253,12 @@ async def to_code(config):
                 HARDWARE_UART_TO_UART_SELECTION[config[CONF_HARDWARE_UART]]
             )
         )
+    if CONF_ASYNC_BUFFER_SIZE in config:
+        cg.add_define("USE_LOGGER_ASYNC")
+        cg.add(log.init_log_buffer(config[CONF_ASYNC_BUFFER_SIZE]))
+    if config.get(CONF_BINARY_FORMAT):
+        cg.add_define("USE_LOGGER_BINARY")
+        cg.add(log.init_binary_format())
     cg.add(log.pre_setup())
 
     for tag, level in config[CONF_LOGS].items():
@@ -0,0 +1,196 @@
+"""Decoding of the messages logged with `binary_format: true`.
+
+The device sends the addresses of the tag and the format string together with the raw
+arguments. The strings are read back from the firmware ELF file and formatted here.
+"""
+
+from __future__ import annotations
+
+import base64
+import binascii
+import logging
+from pathlib import Path
+import re
+import struct
+from typing import Any
+
+from esphome.const import CONF_LOGGER
+
+from . import CONF_BINARY_FORMAT
+
+_LOGGER = logging.getLogger(__name__)
+
+# Must match BINARY_LOG_PREFIX in logger.cpp
+BINARY_LOG_PREFIX = "~L"
+
+SHT_PROGBITS = 1
+SHF_ALLOC = 2
+
+LOG_LEVEL_COLORS = [
+    "",
+    "\033[1;31m",  # ERROR
+    "\033[0;33m",  # WARNING
+    "\033[0;32m",  # INFO
+    "\033[0;35m",  # CONFIG
+    "\033[0;36m",  # DEBUG
+    "\033[0;37m",  # VERBOSE
+    "\033[0;38m",  # VERY_VERBOSE
+]
+LOG_LEVEL_LETTERS = ["", "E", "W", "I", "C", "D", "V", "VV"]
+LOG_RESET_COLOR = "\033[0m"
+
+FORMAT_SPECIFIER_RE = re.compile(
+    r"%(?P<flags>[-+ #0]*)(?P<width>\*|\d+)?(?:\.(?P<precision>\*|\d*))?"
+    r"(?P<length>hh|h|ll|l|L|j|z|t)?(?P<conversion>[diouxXeEfFgGaAcspn%])"
+)
+
+
+class ElfStrings:
+    """Reads null terminated strings from the loaded sections of an ELF file."""
+
+    def __init__(self, path: str | Path) -> None:
+        data = Path(path).read_bytes()
+        if data[:4] != b"\x7fELF":
+            raise ValueError(f"{path} is not an ELF file")
+        if data[4] == 2:
+            (shoff,) = struct.unpack_from("<Q", data, 0x28)
+            shentsize, shnum = struct.unpack_from("<HH", data, 0x3A)
+            section_format = "<IIQQQQ"
+        else:
+            (shoff,) = struct.unpack_from("<I", data, 0x20)
+            shentsize, shnum = struct.unpack_from("<HH", data, 0x2E)
+            section_format = "<IIIIII"
+
+        self._sections: list[tuple[int, bytes]] = []
+        for i in range(shnum):
+            _, sh_type, sh_flags, sh_addr, sh_offset, sh_size = struct.unpack_from(
+                section_format, data, shoff + i * shentsize
+            )
+            if sh_type == SHT_PROGBITS and sh_flags & SHF_ALLOC and sh_addr != 0:
+                self._sections.append(
+                    (sh_addr, data[sh_offset : sh_offset + sh_size])
+                )
+
+    def read_string(self, address: int) -> str | None:
+        for start, content in self._sections:
+            if start <= address < start + len(content):
+                end = content.find(b"\0", address - start)
+                if end == -1:
+                    end = len(content)
+                return content[address - start : end].decode("utf8", "backslashreplace")
+        return None
+
+
+class _Arguments:
+    def __init__(self, data: bytes) -> None:
+        self._data = data
+        self._offset = 0
+
+    def unpack(self, fmt: str) -> Any:
+        size = struct.calcsize(fmt)
+        if self._offset + size > len(self._data):
+            raise IndexError
+        (value,) = struct.unpack_from(fmt, self._data, self._offset)
+        self._offset += size
+        return value
+
+    def string(self) -> str:
+        if self._offset >= len(self._data):
+            raise IndexError
+        end = self._data.find(b"\0", self._offset)
+        if end == -1:
+            end = len(self._data)
+        value = self._data[self._offset : end]
+        self._offset = end + 1
+        return value.decode("utf8", "backslashreplace")
+
+
+def _format_argument(match: re.Match, args: _Arguments) -> str:
+    conversion = match["conversion"]
+    if conversion == "%":
+        return "%"
+
+    # Arguments are laid out like in the 32 bit targets
+    width = match["width"] or ""
+    if width == "*":
+        width = str(args.unpack("<i"))
+    precision = match["precision"]
+    if precision == "*":
+        precision = str(args.unpack("<i"))
+    spec = f"%{match['flags']}{width}"
+    if precision is not None:
+        spec += f".{precision}"
+
+    wide = match["length"] in ("ll", "j")
+    if conversion in "di":
+        return (spec + "d") % args.unpack("<q" if wide else "<i")
+    if conversion in "ouxX":
+        return (spec + conversion.replace("u", "d")) % args.unpack(
+            "<Q" if wide else "<I"
+        )
+    if conversion == "c":
+        return (spec + "c") % (args.unpack("<Q" if wide else "<I") & 0xFF)
+    if conversion in "aA":
+        return args.unpack("<d").hex()
+    if conversion in "eEfFgG":
+        return (spec + conversion) % args.unpack("<d")
+    if conversion == "p":
+        return f"0x{args.unpack('<I'):08x}"
+    if conversion == "s":
+        return (spec + "s") % args.string()
+    raise IndexError
+
+
+class BinaryLogDecoder:
+    def __init__(self, elf_path: str | Path) -> None:
+        self._strings = ElfStrings(elf_path)
+
+    def decode(self, line: str) -> str:
+        """Format a binary log line, other lines are returned unchanged."""
+        if not line.startswith(BINARY_LOG_PREFIX):
+            return line
+        try:
+            data = base64.b64decode(line[len(BINARY_LOG_PREFIX) :], validate=True)
+            level, line_number, tag_address, format_address = struct.unpack_from(
+                "<BHII", data
+            )
+        except (binascii.Error, struct.error):
+            return line
+
+        tag = self._strings.read_string(tag_address)
+        format_ = self._strings.read_string(format_address)
+        if tag is None or format_ is None:
+            return f"{line} (format not found, is the firmware up to date?)"
+
+        args = _Arguments(data[struct.calcsize("<BHII") :])
+        missing = False
+
+        def replace(match: re.Match) -> str:
+            nonlocal missing
+            if missing:
+                return "?"
+            try:
+                return _format_argument(match, args)
+            except (IndexError, ValueError, TypeError, OverflowError):
+                missing = True
+                return "?"
+
+        message = FORMAT_SPECIFIER_RE.sub(replace, format_)
+        level = min(level, len(LOG_LEVEL_LETTERS) - 1)
+        color = LOG_LEVEL_COLORS[level]
+        letter = LOG_LEVEL_LETTERS[level]
+        return f"{color}[{letter}][{tag}:{line_number:03}]: {message}{LOG_RESET_COLOR}"
+
+
+def get_decoder(config: dict[str, Any]) -> BinaryLogDecoder | None:
+    """Return a decoder if the logger of this configuration uses the binary format."""
+    from esphome import platformio_api
+
+    if not config.get(CONF_LOGGER, {}).get(CONF_BINARY_FORMAT):
+        return None
+    idedata = platformio_api.get_idedata(config)
+    try:
+        return BinaryLogDecoder(idedata.firmware_elf_path)
+    except (OSError, ValueError, struct.error) as err:
+        _LOGGER.warning("Can't decode binary log messages: %s", err)
+        return None
@@ -0,0 +1,98 @@
+#include "log_ring_buffer.h"
+
+#ifdef USE_LOGGER_ASYNC
+
+#include <cstring>
+
+namespace esphome {
+namespace logger {
+
+static const uint32_t STATE_SIZE_MASK = 0xFFFF;
+static const uint32_t STATE_LEVEL_SHIFT = 16;
+static const uint32_t STATE_FLAG_PUBLISHED = 1 << 24;
+static const uint32_t STATE_FLAG_PADDING = 1 << 25;
+static const uint32_t STATE_OUTPUTS_SHIFT = 26;
+// Sizes must fit in the state
+static const size_t MAX_BUFFER_SIZE = 32768;
+
+LogRingBuffer::LogRingBuffer(size_t size) {
+  this->size_ = 1;
+  while (this->size_ * 2 <= size && this->size_ * 2 <= MAX_BUFFER_SIZE)
+    this->size_ *= 2;
+  this->buffer_ = new uint8_t[this->size_];  // NOLINT(cppcoreguidelines-owning-memory)
+  memset(this->buffer_, 0, this->size_);
+}
+
+LogRingBuffer::~LogRingBuffer() { delete[] this->buffer_; }  // NOLINT(cppcoreguidelines-owning-memory)
+
+size_t LogRingBuffer::record_size_(size_t message_length) {
+  const size_t size = sizeof(LogRecord) + message_length + 1;
+  return (size + alignof(LogRecord) - 1) & ~(alignof(LogRecord) - 1);
+}
+
+LogRecord *LogRingBuffer::reserve(size_t message_length) {
+  const size_t size = record_size_(message_length);
+  if (size > this->size_)
+    return nullptr;
+
+  uint32_t head = this->head_.load(std::memory_order_relaxed);
+  while (true) {
+    const uint32_t tail = this->tail_.load(std::memory_order_acquire);
+    // Records are never split, a record that doesn't fit before the end of the buffer starts at its beginning
+    const size_t contiguous = this->size_ - (head & (this->size_ - 1));
+    const size_t needed = size <= contiguous ? size : contiguous + size;
+    if (needed > this->size_ - (head - tail))
+      return nullptr;
+    if (this->head_.compare_exchange_weak(head, head + needed, std::memory_order_acq_rel, std::memory_order_relaxed))
+      break;
+  }
+
+  const size_t contiguous = this->size_ - (head & (this->size_ - 1));
+  if (size > contiguous) {
+    this->record_at_(head)->state.store(contiguous | STATE_FLAG_PADDING, std::memory_order_release);
+    head += contiguous;
+  }
+  return this->record_at_(head);
+}
+
+void LogRingBuffer::publish(LogRecord *record, size_t message_length, uint8_t level, const char *tag,
+                            uint8_t outputs) {
+  record->tag = tag;
+  record->state.store(record_size_(message_length) | (uint32_t(level) << STATE_LEVEL_SHIFT) |
+                          (uint32_t(outputs) << STATE_OUTPUTS_SHIFT) | STATE_FLAG_PUBLISHED,
+                      std::memory_order_release);
+}
+
+LogRecord *LogRingBuffer::front() {
+  uint32_t tail = this->tail_.load(std::memory_order_relaxed);
+  while (tail != this->head_.load(std::memory_order_acquire)) {
+    LogRecord *record = this->record_at_(tail);
+    const uint32_t state = record->state.load(std::memory_order_acquire);
+    if (state == 0) {
+      // Reserved but still being written
+      return nullptr;
+    }
+    if ((state & STATE_FLAG_PADDING) == 0)
+      return record;
+
+    const size_t size = state & STATE_SIZE_MASK;
+    memset(static_cast<void *>(record), 0, size);
+    tail += size;
+    this->tail_.store(tail, std::memory_order_release);
+  }
+  return nullptr;
+}
+
+void LogRingBuffer::pop() {
+  const uint32_t tail = this->tail_.load(std::memory_order_relaxed);
+  LogRecord *record = this->record_at_(tail);
+  const size_t size = record->state.load(std::memory_order_relaxed) & STATE_SIZE_MASK;
+  // Space is handed out zeroed, so unpublished records can be told apart
+  memset(static_cast<void *>(record), 0, size);
+  this->tail_.store(tail + size, std::memory_order_release);
+}
+
+}  // namespace logger
+}  // namespace esphome
+
+#endif  // USE_LOGGER_ASYNC
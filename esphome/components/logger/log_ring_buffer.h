@@ -0,0 +1,84 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_LOGGER_ASYNC
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace logger {
+
+/// A formatted log message stored in a LogRingBuffer.
+struct LogRecord {
+  /// 0 while the message is being written, see LogRingBuffer for the layout of the other values.
+  std::atomic<uint32_t> state;
+  const char *tag;
+
+  uint8_t get_level() const { return (this->state.load(std::memory_order_relaxed) >> 16) & 0xFF; }
+  /// Where the message is written to, the LogOutput flags passed to publish().
+  uint8_t get_outputs() const { return (this->state.load(std::memory_order_relaxed) >> 26) & 0x3; }
+  /// The null terminated message, including the header and color codes.
+  const char *get_message() const { return reinterpret_cast<const char *>(this + 1); }
+  char *get_message() { return reinterpret_cast<char *>(this + 1); }
+};
+
+/**
+ * @brief Lock-free ring of log messages with any number of producers and a single consumer.
+ *
+ * Producers reserve space for a message by advancing the head with a compare-and-swap, write the message and then
+ * publish it by setting its state. A producer never waits: if the consumer fell behind, the message is dropped and
+ * counted instead. The consumer takes the messages in the order they were reserved, and stops at a message that is
+ * still being written.
+ *
+ * The state of a record holds its size in the lower 16 bits, its log level in the next 8 bits, then the flags and the
+ * outputs of the message. Consumed space is zeroed, so a record that was reserved but not yet published reads as
+ * state 0.
+ */
+class LogRingBuffer {
+ public:
+  /// @param size Size of the buffer in bytes, rounded down to a power of two.
+  explicit LogRingBuffer(size_t size);
+  ~LogRingBuffer();
+
+  /**
+   * @brief Reserve space for a message.
+   *
+   * @param message_length Maximum length of the message, without the null terminator.
+   * @return The record to write the message into, or nullptr if the buffer is full. Must be passed to publish().
+   */
+  LogRecord *reserve(size_t message_length);
+  /// Make a reserved record available to the consumer. message_length must be the one passed to reserve().
+  void publish(LogRecord *record, size_t message_length, uint8_t level, const char *tag, uint8_t outputs);
+
+  /// Oldest published record, or nullptr if there is none. Only to be called by the consumer.
+  LogRecord *front();
+  /// Release the record returned by front(). Only to be called by the consumer.
+  void pop();
+
+  /// Count a message that could not be stored.
+  void add_dropped() { this->dropped_.fetch_add(1, std::memory_order_relaxed); }
+  /// Number of messages dropped since the buffer was created.
+  uint32_t get_dropped() const { return this->dropped_.load(std::memory_order_relaxed); }
+  size_t get_size() const { return this->size_; }
+
+ protected:
+  static size_t record_size_(size_t message_length);
+  LogRecord *record_at_(uint32_t position) const {
+    return reinterpret_cast<LogRecord *>(this->buffer_ + (position & (this->size_ - 1)));
+  }
+
+  uint8_t *buffer_{nullptr};
+  size_t size_;
+  /// Positions increase monotonically, wrapping around together with the 32 bit counter.
+  std::atomic<uint32_t> head_{0};
+  std::atomic<uint32_t> tail_{0};
+  std::atomic<uint32_t> dropped_{0};
+};
+
+}  // namespace logger
+}  // namespace esphome
+
+#endif  // USE_LOGGER_ASYNC
@@ -1,4 +1,5 @@
 #include "logger.h"
+#include <algorithm>
 #include <cinttypes>
 
 #include "esphome/core/hal.h"
@@ -58,12 +59,170 @@ void Logger::write_header_(int level, const char *tag, int line) {
   }
 }
 
+#ifdef USE_LOGGER_BINARY
+// Must match BINARY_LOG_PREFIX in binary_log.py
+static const char *const BINARY_LOG_PREFIX = "~L";
+static const char *const BASE64_CHARS = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+void HOT Logger::log_binary_(int level, const char *tag, int line, const char *format, va_list args) {
+  // Only the serial port gets the binary form. The callbacks (API, MQTT, web_server, on_message) pass the message on
+  // to consumers that can't decode it, so they get it as text.
+  va_list text_args;
+  va_copy(text_args, args);
+  if (this->baud_rate_ > 0) {
+    this->write_binary_message_(level, tag, line, format, args);
+    this->log_message_(level, tag, 0, LOG_OUTPUT_SERIAL);
+  }
+  if (this->log_callback_.size() > 0) {
+    this->reset_buffer_();
+    this->write_header_(level, tag, line);
+    this->vprintf_to_buffer_(format, text_args);
+    this->write_footer_();
+    this->log_message_(level, tag, 0, LOG_OUTPUT_CALLBACKS);
+  }
+  va_end(text_args);
+}
+
+void HOT Logger::write_binary_message_(int level, const char *tag, int line, const char *format, va_list args) {
+  // Layout: level (u8), line (u16), tag address (u32), format address (u32), then the arguments as they appear in the
+  // format. Integers take 4 bytes or 8 for 64 bit ones, floats 8 bytes and strings are null terminated.
+  uint8_t *out = this->binary_buffer_;
+  uint8_t *const end = this->binary_buffer_ + this->binary_buffer_size_;
+  auto put = [&out, end](const void *data, size_t length) {
+    if (length > static_cast<size_t>(end - out))
+      return false;
+    memcpy(out, data, length);
+    out += length;
+    return true;
+  };
+  auto put_u32 = [&put](uint32_t value) { return put(&value, sizeof(value)); };
+
+  const uint8_t level_u8 = level;
+  const uint16_t line_u16 = line;
+  bool ok = put(&level_u8, sizeof(level_u8)) && put(&line_u16, sizeof(line_u16)) &&
+            put_u32(reinterpret_cast<uintptr_t>(tag)) && put_u32(reinterpret_cast<uintptr_t>(format));
+
+  for (const char *p = format; ok && *p != '\0'; p++) {
+    if (*p != '%')
+      continue;
+    p++;
+    while (*p != '\0' && strchr("-+ #0", *p) != nullptr)
+      p++;
+    // Width and precision
+    for (int i = 0; i < 2; i++) {
+      if (i == 1) {
+        if (*p != '.')
+          break;
+        p++;
+      }
+      if (*p == '*') {
+        ok = ok && put_u32(va_arg(args, int));
+        p++;
+      }
+      while (*p >= '0' && *p <= '9')
+        p++;
+    }
+    uint8_t longs = 0;
+    while (*p != '\0' && strchr("hlLjzt", *p) != nullptr) {
+      if (*p == 'l' || *p == 'j')
+        longs += *p == 'j' ? 2 : 1;
+      p++;
+    }
+    switch (*p) {
+      case '%':
+        break;
+      case 'c':
+      case 'd':
+      case 'i':
+      case 'o':
+      case 'u':
+      case 'x':
+      case 'X':
+        if (longs >= 2) {
+          const uint64_t value = va_arg(args, unsigned long long);  // NOLINT(google-runtime-int)
+          ok = ok && put(&value, sizeof(value));
+        } else if (longs == 1) {
+          ok = ok && put_u32(va_arg(args, unsigned long));  // NOLINT(google-runtime-int)
+        } else {
+          ok = ok && put_u32(va_arg(args, unsigned int));
+        }
+        break;
+      case 'a':
+      case 'A':
+      case 'e':
+      case 'E':
+      case 'f':
+      case 'F':
+      case 'g':
+      case 'G': {
+        const double value = va_arg(args, double);
+        ok = ok && put(&value, sizeof(value));
+        break;
+      }
+      case 'p':
+        ok = ok && put_u32(reinterpret_cast<uintptr_t>(va_arg(args, void *)));
+        break;
+      case 's': {
+        const char *value = va_arg(args, const char *);
+        if (value == nullptr)
+          value = "(null)";
+        const size_t length = strlen(value);
+        if (length + 1 > static_cast<size_t>(end - out)) {
+          // Keep as much of the string as fits, the decoder stops at the end of the data
+          memcpy(out, value, end - out);
+          out = end;
+          ok = false;
+        } else {
+          ok = put(value, length + 1);
+        }
+        break;
+      }
+      default:
+        // Unsupported conversion, the arguments after it can't be found
+        ok = false;
+        break;
+    }
+    if (*p == '\0')
+      break;
+  }
+
+  this->write_to_buffer_(BINARY_LOG_PREFIX, strlen(BINARY_LOG_PREFIX));
+  const size_t length = out - this->binary_buffer_;
+  for (size_t i = 0; i < length; i += 3) {
+    uint32_t triple = this->binary_buffer_[i] << 16;
+    if (i + 1 < length)
+      triple |= this->binary_buffer_[i + 1] << 8;
+    if (i + 2 < length)
+      triple |= this->binary_buffer_[i + 2];
+    this->write_to_buffer_(BASE64_CHARS[(triple >> 18) & 0x3F]);
+    this->write_to_buffer_(BASE64_CHARS[(triple >> 12) & 0x3F]);
+    this->write_to_buffer_(i + 1 < length ? BASE64_CHARS[(triple >> 6) & 0x3F] : '=');
+    this->write_to_buffer_(i + 2 < length ? BASE64_CHARS[triple & 0x3F] : '=');
+  }
+}
+#endif
+
 void HOT Logger::log_vprintf_(int level, const char *tag, int line, const char *format, va_list args) {  // NOLINT
-  if (level > this->level_for(tag) || recursion_guard_)
+#ifdef USE_LOGGER_ASYNC
+  if (this->log_buffer_ != nullptr && xTaskGetCurrentTaskHandle() != this->main_task_) {
+    // Other tasks don't share tx_buffer_ with the main task
+    if (this->is_level_enabled_(level, tag))
+      this->log_vprintf_from_task_(level, tag, line, format, args);
+    return;
+  }
+#endif
+  if (!this->is_level_enabled_(level, tag) || recursion_guard_)
     return;
 
   recursion_guard_ = true;
   this->reset_buffer_();
+#ifdef USE_LOGGER_BINARY
+  if (this->binary_buffer_ != nullptr) {
+    this->log_binary_(level, tag, line, format, args);
+    recursion_guard_ = false;
+    return;
+  }
+#endif
   this->write_header_(level, tag, line);
   this->vprintf_to_buffer_(format, args);
   this->write_footer_();
@@ -73,7 +232,7 @@ void HOT Logger::log_vprintf_(int level, const char *tag, int line, const char *
 #ifdef USE_STORE_LOG_STR_IN_FLASH
 void Logger::log_vprintf_(int level, const char *tag, int line, const __FlashStringHelper *format,
                           va_list args) {  // NOLINT
-  if (level > this->level_for(tag) || recursion_guard_)
+  if (!this->is_level_enabled_(level, tag) || recursion_guard_)
     return;
 
   recursion_guard_ = true;
@@ -101,19 +260,33 @@ void Logger::log_vprintf_(int level, const char *tag, int line, const __FlashStr
 }
 #endif
 
+static uint32_t tag_hash(const char *tag) {
+  // FNV-1a
+  uint32_t hash = 2166136261UL;
+  while (*tag != '\0') {
+    hash ^= static_cast<uint8_t>(*tag++);
+    hash *= 16777619UL;
+  }
+  return hash;
+}
+
 int HOT Logger::level_for(const char *tag) {
-  // Uses std::vector<> for low memory footprint, though the vector
-  // could be sorted to minimize lookup times. This feature isn't used that
-  // much anyway so it doesn't matter too much.
-  for (auto &it : this->log_levels_) {
-    if (it.tag == tag) {
-      return it.level;
-    }
+  if (this->log_levels_.empty())
+    return ESPHOME_LOG_LEVEL;
+
+  // Tags are not always string constants, so they are matched by content and not by address. The hash makes that a
+  // binary search with a single string comparison.
+  const uint32_t hash = tag_hash(tag);
+  auto it = std::lower_bound(this->log_levels_.begin(), this->log_levels_.end(), hash,
+                             [](const LogLevelOverride &other, uint32_t key) { return other.hash < key; });
+  for (; it != this->log_levels_.end() && it->hash == hash; ++it) {
+    if (it->tag == tag)
+      return it->level;
   }
   return ESPHOME_LOG_LEVEL;
 }
 
-void HOT Logger::log_message_(int level, const char *tag, int offset) {
+void HOT Logger::log_message_(int level, const char *tag, int offset, uint8_t outputs) {
   // remove trailing newline
   if (this->tx_buffer_[this->tx_buffer_at_ - 1] == '\n') {
     this->tx_buffer_at_--;
@@ -123,7 +296,17 @@ void HOT Logger::log_message_(int level, const char *tag, int offset) {
 
   const char *msg = this->tx_buffer_ + offset;
 
-  if (this->baud_rate_ > 0) {
+#ifdef USE_LOGGER_ASYNC
+  if (this->log_buffer_ != nullptr) {
+    this->defer_message_(level, tag, msg, outputs);
+    return;
+  }
+#endif
+  this->output_message_(level, tag, msg, outputs);
+}
+
+void HOT Logger::output_message_(int level, const char *tag, const char *msg, uint8_t outputs) {
+  if (this->baud_rate_ > 0 && (outputs & LOG_OUTPUT_SERIAL)) {
     this->write_msg_(msg);
   }
 
@@ -137,7 +320,8 @@ void HOT Logger::log_message_(int level, const char *tag, int offset) {
     return;
 #endif
 
-  this->log_callback_.call(level, tag, msg);
+  if (outputs & LOG_OUTPUT_CALLBACKS)
+    this->log_callback_.call(level, tag, msg);
 }
 
 Logger::Logger(uint32_t baud_rate, size_t tx_buffer_size) : baud_rate_(baud_rate), tx_buffer_size_(tx_buffer_size) {
@@ -148,9 +332,13 @@ Logger::Logger(uint32_t baud_rate, size_t tx_buffer_size) : baud_rate_(baud_rate
 #endif
 }
 
-#ifdef USE_LOGGER_USB_CDC
+#if defined(USE_LOGGER_USB_CDC) || defined(USE_LOGGER_ASYNC)
 void Logger::loop() {
-#ifdef USE_ARDUINO
+#ifdef USE_LOGGER_ASYNC
+  if (this->log_buffer_ != nullptr)
+    this->process_log_buffer_();
+#endif
+#if defined(USE_LOGGER_USB_CDC) && defined(USE_ARDUINO)
   if (this->uart_ != UART_SELECTION_USB_CDC) {
     return;
   }
@@ -166,9 +354,120 @@ void Logger::loop() {
 }
 #endif
 
+#ifdef USE_LOGGER_BINARY
+void Logger::init_binary_format() {
+  // Leave room in tx_buffer_ for the prefix and the base64 encoding
+  this->binary_buffer_size_ = (this->tx_buffer_size_ - strlen(BINARY_LOG_PREFIX)) / 4 * 3;
+  this->binary_buffer_ = new uint8_t[this->binary_buffer_size_];  // NOLINT
+}
+#endif
+
+#ifdef USE_LOGGER_ASYNC
+void Logger::init_log_buffer(size_t size) { this->log_buffer_ = make_unique<LogRingBuffer>(size); }
+
+uint32_t Logger::get_dropped_messages() const {
+  if (this->log_buffer_ == nullptr)
+    return 0;
+  return this->log_buffer_->get_dropped();
+}
+
+void HOT Logger::log_vprintf_from_task_(int level, const char *tag, int line, const char *format,
+                                        va_list args) {  // NOLINT
+  if (level < 0)
+    level = 0;
+  if (level > 7)
+    level = 7;
+
+  const char *color = LOG_LEVEL_COLORS[level];
+  const char *letter = LOG_LEVEL_LETTERS[level];
+  const char *thread_name = pcTaskGetName(nullptr);
+  const char *thread_color = ESPHOME_LOG_BOLD(ESPHOME_LOG_COLOR_RED);
+  const char *const header_format = "%s[%s][%s:%03u]%s[%s]%s: ";
+
+  // Measure the message first, so that it takes no more space in the buffer than it needs
+  va_list args_copy;
+  va_copy(args_copy, args);
+  int header_length = snprintf(nullptr, 0, header_format, color, letter, tag, line, thread_color, thread_name, color);
+  int body_length = vsnprintf(nullptr, 0, format, args_copy);
+  va_end(args_copy);
+  if (header_length < 0 || body_length < 0)
+    return;
+  const size_t footer_length = strlen(ESPHOME_LOG_RESET_COLOR);
+  const size_t length =
+      std::min<size_t>(header_length + body_length + footer_length, std::max(this->tx_buffer_size_, header_length));
+
+  LogRecord *record = this->log_buffer_->reserve(length);
+  if (record == nullptr) {
+    this->log_buffer_->add_dropped();
+    return;
+  }
+  char *msg = record->get_message();
+  snprintf(msg, length + 1, header_format, color, letter, tag, line, thread_color, thread_name, color);
+  if (static_cast<size_t>(header_length) < length) {
+    vsnprintf(msg + header_length, length + 1 - header_length, format, args);
+  }
+  // The footer always fits, a message that was too long for the buffer is cut before it
+  const size_t body_end = std::min(length - footer_length, static_cast<size_t>(header_length + body_length));
+  if (body_end > 0 && msg[body_end - 1] == '\n') {
+    memcpy(msg + body_end - 1, ESPHOME_LOG_RESET_COLOR, footer_length + 1);
+  } else {
+    memcpy(msg + body_end, ESPHOME_LOG_RESET_COLOR, footer_length + 1);
+  }
+  this->log_buffer_->publish(record, length, level, tag, LOG_OUTPUT_ALL);
+}
+
+void HOT Logger::defer_message_(int level, const char *tag, const char *msg, uint8_t outputs) {
+  const size_t length = strlen(msg);
+  LogRecord *record = this->log_buffer_->reserve(length);
+  if (record == nullptr) {
+    // The main task is the consumer, so rather than dropping its own message it makes room
+    this->process_log_buffer_();
+    record = this->log_buffer_->reserve(length);
+  }
+  if (record == nullptr) {
+    // Still no room, either the message is larger than the buffer or another task is writing to it
+    this->output_message_(level, tag, msg, outputs);
+    return;
+  }
+  memcpy(record->get_message(), msg, length + 1);
+  this->log_buffer_->publish(record, length, level, tag, outputs);
+}
+
+void Logger::process_log_buffer_() {
+  const bool was_guarded = this->recursion_guard_;
+  // Messages logged by the sinks are dropped, as they are when logging synchronously
+  this->recursion_guard_ = true;
+  LogRecord *record;
+  while ((record = this->log_buffer_->front()) != nullptr) {
+    this->output_message_(record->get_level(), record->tag, record->get_message(), record->get_outputs());
+    this->log_buffer_->pop();
+  }
+  this->recursion_guard_ = was_guarded;
+
+  const uint32_t dropped = this->log_buffer_->get_dropped();
+  if (dropped != this->reported_dropped_ && !was_guarded) {
+    ESP_LOGW(TAG, "Log buffer full, dropped %" PRIu32 " messages", dropped - this->reported_dropped_);
+    this->reported_dropped_ = dropped;
+  }
+}
+#endif
+
 void Logger::set_baud_rate(uint32_t baud_rate) { this->baud_rate_ = baud_rate; }
 void Logger::set_log_level(const std::string &tag, int log_level) {
-  this->log_levels_.push_back(LogLevelOverride{tag, log_level});
+  const uint32_t hash = tag_hash(tag.c_str());
+  auto it = std::lower_bound(this->log_levels_.begin(), this->log_levels_.end(), hash,
+                             [](const LogLevelOverride &other, uint32_t key) { return other.hash < key; });
+  while (it != this->log_levels_.end() && it->hash == hash && it->tag != tag)
+    ++it;
+  if (it != this->log_levels_.end() && it->tag == tag) {
+    it->level = log_level;
+  } else {
+    this->log_levels_.insert(it, LogLevelOverride{hash, tag, log_level});
+  }
+
+  this->min_tag_level_ = ESPHOME_LOG_LEVEL;
+  for (auto &other : this->log_levels_)
+    this->min_tag_level_ = std::min(this->min_tag_level_, other.level);
 }
 
 #if defined(USE_ESP32) || defined(USE_ESP8266) || defined(USE_RP2040) || defined(USE_LIBRETINY)
@@ -188,6 +487,15 @@ void Logger::dump_config() {
   ESP_LOGCONFIG(TAG, "  Log Baud Rate: %" PRIu32, this->baud_rate_);
   ESP_LOGCONFIG(TAG, "  Hardware UART: %s", get_uart_selection_());
 #endif
+#ifdef USE_LOGGER_BINARY
+  ESP_LOGCONFIG(TAG, "  Binary Format: %s", YESNO(this->binary_buffer_ != nullptr));
+#endif
+#ifdef USE_LOGGER_ASYNC
+  if (this->log_buffer_ != nullptr) {
+    ESP_LOGCONFIG(TAG, "  Async Buffer Size: %zu bytes", this->log_buffer_->get_size());
+    ESP_LOGCONFIG(TAG, "  Dropped Messages: %" PRIu32, this->log_buffer_->get_dropped());
+  }
+#endif
 
   for (auto &it : this->log_levels_) {
     ESP_LOGCONFIG(TAG, "  Level for '%s': %s", it.tag.c_str(), LOG_LEVELS[it.level]);
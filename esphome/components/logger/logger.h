@@ -1,12 +1,17 @@
 #pragma once
 
 #include <cstdarg>
+#include <memory>
 #include <vector>
 #include "esphome/core/automation.h"
 #include "esphome/core/component.h"
 #include "esphome/core/defines.h"
 #include "esphome/core/helpers.h"
 
+#ifdef USE_LOGGER_ASYNC
+#include "log_ring_buffer.h"
+#endif
+
 #ifdef USE_ARDUINO
 #if defined(USE_ESP8266) || defined(USE_ESP32)
 #include <HardwareSerial.h>
@@ -25,6 +30,14 @@ namespace esphome {
 
 namespace logger {
 
+/// Where a log message is written to.
+enum LogOutput : uint8_t {
+  LOG_OUTPUT_SERIAL = 1 << 0,
+  /// The callbacks added with add_on_log_callback(), like the API, MQTT and web_server.
+  LOG_OUTPUT_CALLBACKS = 1 << 1,
+  LOG_OUTPUT_ALL = LOG_OUTPUT_SERIAL | LOG_OUTPUT_CALLBACKS,
+};
+
 #if defined(USE_ESP32) || defined(USE_ESP8266) || defined(USE_RP2040) || defined(USE_LIBRETINY)
 /** Enum for logging UART selection
  *
@@ -56,7 +69,7 @@ enum UARTSelection {
 class Logger : public Component {
  public:
   explicit Logger(uint32_t baud_rate, size_t tx_buffer_size);
-#ifdef USE_LOGGER_USB_CDC
+#if defined(USE_LOGGER_USB_CDC) || defined(USE_LOGGER_ASYNC)
   void loop() override;
 #endif
   /// Manually set the baud rate for serial, set to 0 to disable.
@@ -77,6 +90,17 @@ class Logger : public Component {
   /// Set the log level of the specified tag.
   void set_log_level(const std::string &tag, int log_level);
 
+#ifdef USE_LOGGER_ASYNC
+  /// Defer the output of log messages through a buffer of the given size in bytes, drained in loop().
+  void init_log_buffer(size_t size);
+  /// Number of messages that were dropped because the buffer was full.
+  uint32_t get_dropped_messages() const;
+#endif
+#ifdef USE_LOGGER_BINARY
+  /// Log messages as format string addresses and raw arguments, to be formatted by the logs tooling.
+  void init_binary_format();
+#endif
+
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
   /// Set up this component.
@@ -98,8 +122,28 @@ class Logger : public Component {
  protected:
   void write_header_(int level, const char *tag, int line);
   void write_footer_();
-  void log_message_(int level, const char *tag, int offset = 0);
+  void log_message_(int level, const char *tag, int offset = 0, uint8_t outputs = LOG_OUTPUT_ALL);
+  /// Send a finished message to the serial port and/or the callbacks, see LogOutput.
+  void output_message_(int level, const char *tag, const char *msg, uint8_t outputs = LOG_OUTPUT_ALL);
   void write_msg_(const char *msg);
+  /// Whether a message of this level and tag should be logged.
+  inline bool is_level_enabled_(int level, const char *tag) {
+    return level <= this->min_tag_level_ || level <= this->level_for(tag);
+  }
+#ifdef USE_LOGGER_ASYNC
+  /// Format a message from a task other than the main task directly into the log buffer.
+  void log_vprintf_from_task_(int level, const char *tag, int line, const char *format, va_list args);
+  /// Queue a message formatted by the main task. Drains the buffer first if it is full.
+  void defer_message_(int level, const char *tag, const char *msg, uint8_t outputs);
+  /// Output all published messages in the log buffer. Must be called from the main task.
+  void process_log_buffer_();
+#endif
+#ifdef USE_LOGGER_BINARY
+  /// Log a message in binary form to the serial port, and as text to the callbacks.
+  void log_binary_(int level, const char *tag, int line, const char *format, va_list args);
+  /// Encode a message in binary form, then write it base64 encoded to tx_buffer_.
+  void write_binary_message_(int level, const char *tag, int line, const char *format, va_list args);
+#endif
 
   inline bool is_buffer_full_() const { return this->tx_buffer_at_ >= this->tx_buffer_size_; }
   inline int buffer_remaining_capacity_() const { return this->tx_buffer_size_ - this->tx_buffer_at_; }
@@ -160,10 +204,22 @@ class Logger : public Component {
   uart_port_t uart_num_;
 #endif
   struct LogLevelOverride {
+    uint32_t hash;
     std::string tag;
     int level;
   };
+  /// Sorted by hash.
   std::vector<LogLevelOverride> log_levels_;
+  /// Lowest level of all tags, messages at or below it are logged without looking up their tag.
+  int min_tag_level_{ESPHOME_LOG_LEVEL};
+#ifdef USE_LOGGER_ASYNC
+  std::unique_ptr<LogRingBuffer> log_buffer_;
+  uint32_t reported_dropped_{0};
+#endif
+#ifdef USE_LOGGER_BINARY
+  uint8_t *binary_buffer_{nullptr};
+  size_t binary_buffer_size_{0};
+#endif
   CallbackManager<void(int, const char *, const char *)> log_callback_{};
   /// Prevents recursive log calls, if true a log message is already being processed.
   bool recursion_guard_ = false;
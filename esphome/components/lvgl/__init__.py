@@ -165,6 +165,8 @@ def final_validation(config):
                 "Using auto_clear_enabled: true in display config not compatible with LVGL"
             )
     buffer_frac = config[CONF_BUFFER_SIZE]
+    if config[df.CONF_DOUBLE_BUFFER]:
+        buffer_frac *= 2
     if CORE.is_esp32 and buffer_frac > 0.5 and "psram" not in global_config:
         LOGGER.warning("buffer_size: may need to be reduced without PSRAM")
     for image_id in lv_images_used:
@@ -240,6 +242,7 @@ async def to_code(config):
         config[df.CONF_FULL_REFRESH],
         config[df.CONF_DRAW_ROUNDING],
         config[df.CONF_RESUME_ON_INPUT],
+        config[df.CONF_DOUBLE_BUFFER],
     )
     await cg.register_component(lv_component, config)
     Widget.create(config[CONF_ID], lv_component, obj_spec, config)
@@ -334,6 +337,7 @@ CONFIG_SCHEMA = (
             cv.Optional(df.CONF_FULL_REFRESH, default=False): cv.boolean,
             cv.Optional(df.CONF_DRAW_ROUNDING, default=2): cv.positive_int,
             cv.Optional(CONF_BUFFER_SIZE, default="100%"): cv.percentage,
+            cv.Optional(df.CONF_DOUBLE_BUFFER, default=False): cv.boolean,
             cv.Optional(df.CONF_LOG_LEVEL, default="WARN"): cv.one_of(
                 *df.LV_LOG_LEVELS, upper=True
             ),
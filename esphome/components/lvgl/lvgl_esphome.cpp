@@ -87,6 +87,7 @@ void LvglComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "  Display width/height: %d x %d", this->disp_drv_.hor_res, this->disp_drv_.ver_res);
   ESP_LOGCONFIG(TAG, "  Rotation: %d", this->rotation);
   ESP_LOGCONFIG(TAG, "  Draw rounding: %d", (int) this->draw_rounding);
+  ESP_LOGCONFIG(TAG, "  Double buffer: %s", YESNO(this->double_buffer_));
 }
 void LvglComponent::set_paused(bool paused, bool show_snow) {
   this->paused_ = paused;
@@ -138,7 +139,11 @@ void LvglComponent::show_prev_page(lv_scr_load_anim_t anim, uint32_t time) {
   } while (this->pages_[this->current_page_]->skip);  // skip empty pages()
   this->show_page(this->current_page_, anim, time);
 }
-void LvglComponent::draw_buffer_(const lv_area_t *area, lv_color_t *ptr) {
+// Rotating by 90 degrees reads the source by rows and writes the destination by columns, so it is done in square
+// tiles small enough for both to stay in the cache.
+static const lv_coord_t ROTATE_TILE_SIZE = 16;
+
+void LvglComponent::draw_buffer_(const lv_area_t *area, lv_color_t *ptr, bool queue) {
   auto width = lv_area_get_width(area);
   auto height = lv_area_get_height(area);
   auto x1 = area->x1;
@@ -146,9 +151,16 @@ void LvglComponent::draw_buffer_(const lv_area_t *area, lv_color_t *ptr) {
   lv_color_t *dst = this->rotate_buf_;
   switch (this->rotation) {
     case display::DISPLAY_ROTATION_90_DEGREES:
-      for (lv_coord_t x = height; x-- != 0;) {
-        for (lv_coord_t y = 0; y != width; y++) {
-          dst[y * height + x] = *ptr++;
+      // source row y becomes destination column height - 1 - y
+      for (lv_coord_t ty = 0; ty < height; ty += ROTATE_TILE_SIZE) {
+        auto y_end = std::min<lv_coord_t>(ty + ROTATE_TILE_SIZE, height);
+        for (lv_coord_t tx = 0; tx < width; tx += ROTATE_TILE_SIZE) {
+          auto x_end = std::min<lv_coord_t>(tx + ROTATE_TILE_SIZE, width);
+          for (lv_coord_t x = tx; x != x_end; x++) {
+            lv_color_t *dst_row = dst + x * height + height - 1;
+            for (lv_coord_t y = ty; y != y_end; y++)
+              dst_row[-y] = ptr[y * width + x];
+          }
         }
       }
       y1 = x1;
@@ -168,9 +180,16 @@ void LvglComponent::draw_buffer_(const lv_area_t *area, lv_color_t *ptr) {
       break;
 
     case display::DISPLAY_ROTATION_270_DEGREES:
-      for (lv_coord_t x = 0; x != height; x++) {
-        for (lv_coord_t y = width; y-- != 0;) {
-          dst[y * height + x] = *ptr++;
+      // source column x becomes destination row width - 1 - x
+      for (lv_coord_t ty = 0; ty < height; ty += ROTATE_TILE_SIZE) {
+        auto y_end = std::min<lv_coord_t>(ty + ROTATE_TILE_SIZE, height);
+        for (lv_coord_t tx = 0; tx < width; tx += ROTATE_TILE_SIZE) {
+          auto x_end = std::min<lv_coord_t>(tx + ROTATE_TILE_SIZE, width);
+          for (lv_coord_t x = tx; x != x_end; x++) {
+            lv_color_t *dst_row = dst + (width - 1 - x) * height;
+            for (lv_coord_t y = ty; y != y_end; y++)
+              dst_row[y] = ptr[y * width + x];
+          }
         }
       }
       x1 = y1;
@@ -185,20 +204,53 @@ void LvglComponent::draw_buffer_(const lv_area_t *area, lv_color_t *ptr) {
   }
   for (auto *display : this->displays_) {
     ESP_LOGV(TAG, "draw buffer x1=%d, y1=%d, width=%d, height=%d", x1, y1, width, height);
-    display->draw_pixels_at(x1, y1, width, height, (const uint8_t *) dst, display::COLOR_ORDER_RGB, LV_BITNESS,
-                            LV_COLOR_16_SWAP);
+    if (queue) {
+      display->queue_draw_pixels_at(x1, y1, width, height, (const uint8_t *) dst, display::COLOR_ORDER_RGB,
+                                    LV_BITNESS, LV_COLOR_16_SWAP);
+    } else {
+      display->draw_pixels_at(x1, y1, width, height, (const uint8_t *) dst, display::COLOR_ORDER_RGB, LV_BITNESS,
+                              LV_COLOR_16_SWAP);
+    }
   }
 }
 
 void LvglComponent::flush_cb_(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color_p) {
   if (!this->paused_) {
-    auto now = millis();
+    auto now = micros();
+    this->flush_count_++;
+    if (this->double_buffer_) {
+      // LVGL renders into the other buffer while this one is written to the displays.
+      this->draw_buffer_(area, color_p, true);
+      this->flush_pending_ = true;
+      this->flush_time_ += micros() - now;
+      this->complete_flush_(false);
+      return;
+    }
     this->draw_buffer_(area, color_p);
-    ESP_LOGVV(TAG, "flush_cb, area=%d/%d, %d/%d took %dms", area->x1, area->y1, lv_area_get_width(area),
-              lv_area_get_height(area), (int) (millis() - now));
+    this->flush_time_ += micros() - now;
+    ESP_LOGVV(TAG, "flush_cb, area=%d/%d, %d/%d took %uus", area->x1, area->y1, lv_area_get_width(area),
+              lv_area_get_height(area), (unsigned) (micros() - now));
   }
   lv_disp_flush_ready(disp_drv);
 }
+
+bool LvglComponent::complete_flush_(bool wait) {
+  if (!this->flush_pending_)
+    return true;
+  auto now = micros();
+  bool complete = true;
+  for (auto *display : this->displays_) {
+    if (!display->draw_pixels_complete(wait))
+      complete = false;
+  }
+  if (wait)
+    this->flush_time_ += micros() - now;
+  if (!complete)
+    return false;
+  this->flush_pending_ = false;
+  lv_disp_flush_ready(&this->disp_drv_);
+  return true;
+}
 IdleTrigger::IdleTrigger(LvglComponent *parent, TemplatableValue<uint32_t> timeout) : timeout_(std::move(timeout)) {
   parent->add_on_idle_callback([this](uint32_t idle_time) {
     if (!this->is_idle_ && idle_time > this->timeout_.value()) {
@@ -397,14 +449,17 @@ void LvglComponent::write_random_() {
  *                      multiple of 2, and so on.
  * @param resume_on_input if true, this component will resume rendering when the user
  *                         presses a key or clicks on the screen.
+ * @param double_buffer if true, a second draw buffer is allocated so that LVGL can render
+ *                      while the previous area is still being written to the displays.
  */
 LvglComponent::LvglComponent(std::vector<display::Display *> displays, float buffer_frac, bool full_refresh,
-                             int draw_rounding, bool resume_on_input)
+                             int draw_rounding, bool resume_on_input, bool double_buffer)
     : draw_rounding(draw_rounding),
       displays_(std::move(displays)),
       buffer_frac_(buffer_frac),
       full_refresh_(full_refresh),
-      resume_on_input_(resume_on_input) {
+      resume_on_input_(resume_on_input),
+      double_buffer_(double_buffer) {
   lv_init();
   lv_update_event = static_cast<lv_event_code_t>(lv_event_register_id());
   lv_api_event = static_cast<lv_event_code_t>(lv_event_register_id());
@@ -420,12 +475,21 @@ LvglComponent::LvglComponent(std::vector<display::Display *> displays, float buf
   auto *buf = lv_custom_mem_alloc(buf_bytes);  // NOLINT
   if (buf == nullptr)
     return;
-  lv_disp_draw_buf_init(&this->draw_buf_, buf, nullptr, buffer_pixels);
+  void *buf2 = nullptr;
+  if (this->double_buffer_) {
+    buf2 = lv_custom_mem_alloc(buf_bytes);  // NOLINT
+    if (buf2 == nullptr) {
+      // a single buffer still works
+      this->double_buffer_ = false;
+    }
+  }
+  lv_disp_draw_buf_init(&this->draw_buf_, buf, buf2, buffer_pixels);
   lv_disp_drv_init(&this->disp_drv_);
   this->disp_drv_.draw_buf = &this->draw_buf_;
   this->disp_drv_.user_data = this;
   this->disp_drv_.full_refresh = this->full_refresh_;
   this->disp_drv_.flush_cb = static_flush_cb;
+  this->disp_drv_.wait_cb = static_wait_cb;
   this->disp_drv_.rounder_cb = rounder_cb;
   this->disp_drv_.hor_res = (lv_coord_t) display->get_width();
   this->disp_drv_.ver_res = (lv_coord_t) display->get_height();
@@ -463,13 +527,25 @@ void LvglComponent::update() {
     return;
   }
   this->idle_callbacks_.call(lv_disp_get_inactive_time(this->disp_));
+  this->last_render_time_ = this->render_time_;
+  this->last_flush_time_ = this->flush_time_;
+  this->last_flush_count_ = this->flush_count_;
+  this->render_time_ = this->flush_time_ = this->flush_count_ = 0;
+  if (this->last_flush_count_ != 0) {
+    ESP_LOGV(TAG, "Flushed %u areas, render time %uus, flush time %uus", (unsigned) this->last_flush_count_,
+             (unsigned) this->last_render_time_, (unsigned) this->last_flush_time_);
+  }
 }
 void LvglComponent::loop() {
+  this->complete_flush_(false);
   if (this->paused_) {
-    if (this->show_snow_)
+    if (this->show_snow_ && this->complete_flush_(true))
       this->write_random_();
   }
+  auto now = micros();
+  auto flush_time = this->flush_time_;
   lv_timer_handler_run_in_period(5);
+  this->render_time_ += micros() - now - (this->flush_time_ - flush_time);
 }
 
 #ifdef USE_LVGL_ANIMIMG
@@ -484,6 +560,10 @@ void lv_animimg_stop(lv_obj_t *obj) {
 void LvglComponent::static_flush_cb(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color_p) {
   reinterpret_cast<LvglComponent *>(disp_drv->user_data)->flush_cb_(disp_drv, area, color_p);
 }
+// called by LVGL while it waits for a flush to complete
+void LvglComponent::static_wait_cb(lv_disp_drv_t *disp_drv) {
+  reinterpret_cast<LvglComponent *>(disp_drv->user_data)->complete_flush_(true);
+}
 }  // namespace lvgl
 }  // namespace esphome
 
@@ -119,8 +119,9 @@ class LvglComponent : public PollingComponent {
 
  public:
   LvglComponent(std::vector<display::Display *> displays, float buffer_frac, bool full_refresh, int draw_rounding,
-                bool resume_on_input);
+                bool resume_on_input, bool double_buffer = false);
   static void static_flush_cb(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color_p);
+  static void static_wait_cb(lv_disp_drv_t *disp_drv);
 
   float get_setup_priority() const override { return setup_priority::PROCESSOR; }
   void setup() override;
@@ -139,6 +140,10 @@ class LvglComponent : public PollingComponent {
   // @param show_snow If true, show the snow effect when paused.
   void set_paused(bool paused, bool show_snow);
   bool is_paused() const { return this->paused_; }
+  // Time in microseconds spent rendering and flushing, and the number of areas flushed, during the last update interval
+  uint32_t get_render_time() const { return this->last_render_time_; }
+  uint32_t get_flush_time() const { return this->last_flush_time_; }
+  uint32_t get_flush_count() const { return this->last_flush_count_; }
   // If the display is paused and we have resume_on_input_ set to true, resume the display.
   void maybe_wakeup() {
     if (this->paused_ && this->resume_on_input_) {
@@ -169,13 +174,17 @@ class LvglComponent : public PollingComponent {
 
  protected:
   void write_random_();
-  void draw_buffer_(const lv_area_t *area, lv_color_t *ptr);
+  void draw_buffer_(const lv_area_t *area, lv_color_t *ptr, bool queue = false);
   void flush_cb_(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color_p);
+  // signal LVGL when a queued flush has been drawn by all displays, return true if no flush is pending
+  bool complete_flush_(bool wait);
 
   std::vector<display::Display *> displays_{};
   size_t buffer_frac_{1};
   bool full_refresh_{};
   bool resume_on_input_{};
+  bool double_buffer_{};
+  bool flush_pending_{};
 
   lv_disp_draw_buf_t draw_buf_{};
   lv_disp_drv_t disp_drv_{};
@@ -190,6 +199,13 @@ class LvglComponent : public PollingComponent {
   CallbackManager<void(uint32_t)> idle_callbacks_{};
   CallbackManager<void(bool)> pause_callbacks_{};
   lv_color_t *rotate_buf_{};
+
+  uint32_t render_time_{};
+  uint32_t flush_time_{};
+  uint32_t flush_count_{};
+  uint32_t last_render_time_{};
+  uint32_t last_flush_time_{};
+  uint32_t last_flush_count_{};
 };
 
 class IdleTrigger : public Trigger<> {
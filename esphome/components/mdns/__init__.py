@@ -16,6 +16,14 @@ from esphome.core import CORE, coroutine_with_priority
 CODEOWNERS = ["@esphome/core"]
 DEPENDENCIES = ["network"]
 
+
+def AUTO_LOAD():
+    # The host responder uses a UDP socket
+    if CORE.is_host:
+        return ["socket"]
+    return []
+
+
 mdns_ns = cg.esphome_ns.namespace("mdns")
 MDNSComponent = mdns_ns.class_("MDNSComponent", cg.Component)
 MDNSTXTRecord = mdns_ns.struct("MDNSTXTRecord")
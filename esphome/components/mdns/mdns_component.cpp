@@ -5,6 +5,8 @@
 #include "esphome/core/application.h"
 #include "esphome/core/log.h"
 
+#include <cstring>
+
 #ifdef USE_API
 #include "esphome/components/api/api_server.h"
 #endif
@@ -21,81 +23,73 @@ static const char *const TAG = "mdns";
 #define USE_WEBSERVER_PORT 80  // NOLINT
 #endif
 
-void MDNSComponent::compile_records_() {
-  this->hostname_ = App.get_name();
-
-  this->services_.clear();
 #ifdef USE_API
-  if (api::global_api_server != nullptr) {
-    MDNSService service{};
-    service.service_type = "_esphomelib";
-    service.proto = "_tcp";
-    service.port = api::global_api_server->get_port();
-    if (!App.get_friendly_name().empty()) {
-      service.txt_records.push_back({"friendly_name", App.get_friendly_name()});
-    }
-    service.txt_records.push_back({"version", ESPHOME_VERSION});
-    service.txt_records.push_back({"mac", get_mac_address()});
-    const char *platform = nullptr;
+struct StaticTXTRecord {
+  const char *key;
+  const char *value;
+};
+
+// The records of the API service that are known at compile time
+static const StaticTXTRecord API_TXT_RECORDS[] = {  // NOLINT(cppcoreguidelines-avoid-c-arrays)
+    {"version", ESPHOME_VERSION},
 #ifdef USE_ESP8266
-    platform = "ESP8266";
+    {"platform", "ESP8266"},
 #endif
 #ifdef USE_ESP32
-    platform = "ESP32";
+    {"platform", "ESP32"},
 #endif
 #ifdef USE_RP2040
-    platform = "RP2040";
+    {"platform", "RP2040"},
 #endif
-#ifdef USE_LIBRETINY
-    platform = lt_cpu_get_model_name();
-#endif
-    if (platform != nullptr) {
-      service.txt_records.push_back({"platform", platform});
-    }
-
-    service.txt_records.push_back({"board", ESPHOME_BOARD});
-
+    {"board", ESPHOME_BOARD},
 #if defined(USE_WIFI)
-    service.txt_records.push_back({"network", "wifi"});
+    {"network", "wifi"},
 #elif defined(USE_ETHERNET)
-    service.txt_records.push_back({"network", "ethernet"});
+    {"network", "ethernet"},
 #endif
-
 #ifdef USE_API_NOISE
-    service.txt_records.push_back({"api_encryption", "Noise_NNpsk0_25519_ChaChaPoly_SHA256"});
+    {"api_encryption", "Noise_NNpsk0_25519_ChaChaPoly_SHA256"},
 #endif
-
 #ifdef ESPHOME_PROJECT_NAME
-    service.txt_records.push_back({"project_name", ESPHOME_PROJECT_NAME});
-    service.txt_records.push_back({"project_version", ESPHOME_PROJECT_VERSION});
+    {"project_name", ESPHOME_PROJECT_NAME},
+    {"project_version", ESPHOME_PROJECT_VERSION},
 #endif  // ESPHOME_PROJECT_NAME
+};
+#endif  // USE_API
 
+void MDNSComponent::compile_records_() {
+  this->hostname_ = App.get_name();
+
+  this->services_.clear();
+  this->services_.reserve(3 + this->services_extra_.size());
+#ifdef USE_API
+  if (api::global_api_server != nullptr) {
+    MDNSService service{"_esphomelib", "_tcp", api::global_api_server->get_port(), {}};
+    // Room for the records only known at runtime
+    service.txt_records.reserve(sizeof(API_TXT_RECORDS) / sizeof(API_TXT_RECORDS[0]) + 4);
+    if (!App.get_friendly_name().empty()) {
+      service.txt_records.push_back({"friendly_name", App.get_friendly_name()});
+    }
+    for (const auto &record : API_TXT_RECORDS) {
+      service.txt_records.push_back({record.key, record.value});
+    }
+    service.txt_records.push_back({"mac", get_mac_address()});
+#ifdef USE_LIBRETINY
+    service.txt_records.push_back({"platform", lt_cpu_get_model_name()});
+#endif
 #ifdef USE_DASHBOARD_IMPORT
     service.txt_records.push_back({"package_import_url", dashboard_import::get_package_import_url()});
 #endif
-
-    this->services_.push_back(service);
+    this->services_.push_back(std::move(service));
   }
 #endif  // USE_API
 
 #ifdef USE_PROMETHEUS
-  {
-    MDNSService service{};
-    service.service_type = "_prometheus-http";
-    service.proto = "_tcp";
-    service.port = USE_WEBSERVER_PORT;
-    this->services_.push_back(service);
-  }
+  this->services_.push_back({"_prometheus-http", "_tcp", USE_WEBSERVER_PORT, {}});
 #endif
 
 #ifdef USE_WEBSERVER
-  {
-    MDNSService service{};
-    service.service_type = "_http";
-    service.proto = "_tcp";
-    service.port = USE_WEBSERVER_PORT;
-    this->services_.push_back(service);
-  }
+  this->services_.push_back({"_http", "_tcp", USE_WEBSERVER_PORT, {}});
 #endif
 
   this->services_.insert(this->services_.end(), this->services_extra_.begin(), this->services_extra_.end());
@@ -103,13 +97,36 @@ void MDNSComponent::compile_records_() {
   if (this->services_.empty()) {
     // Publish "http" service if not using native API
     // This is just to have *some* mDNS service so that .local resolution works
-    MDNSService service{};
-    service.service_type = "_http";
-    service.proto = "_tcp";
-    service.port = USE_WEBSERVER_PORT;
-    service.txt_records.push_back({"version", ESPHOME_VERSION});
-    this->services_.push_back(service);
+    this->services_.push_back({"_http", "_tcp", USE_WEBSERVER_PORT, {{"version", ESPHOME_VERSION}}});
+  }
+}
+
+bool MDNSComponent::set_txt_record(const char *service_type, const char *proto, const char *key,
+                                   const std::string &value) {
+  for (auto &service : this->services_) {
+    if (strcmp(service.service_type, service_type) != 0 || strcmp(service.proto, proto) != 0)
+      continue;
+    MDNSTXTRecord *record = nullptr;
+    for (auto &it : service.txt_records) {
+      if (strcmp(it.key, key) == 0) {
+        record = &it;
+        break;
+      }
+    }
+    if (record == nullptr) {
+      service.txt_records.push_back({key, value});
+      record = &service.txt_records.back();
+    } else if (record->value == value) {
+      return true;
+    } else {
+      record->value = value;
+    }
+    ESP_LOGD(TAG, "Updating TXT record %s of %s.%s", key, service_type, proto);
+    this->publish_txt_record_(service, *record);
+    return true;
   }
+  ESP_LOGW(TAG, "No service %s.%s to set TXT record %s for", service_type, proto, key);
+  return false;
 }
 
 void MDNSComponent::dump_config() {
@@ -117,9 +134,9 @@ void MDNSComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "  Hostname: %s", this->hostname_.c_str());
   ESP_LOGV(TAG, "  Services:");
   for (const auto &service : this->services_) {
-    ESP_LOGV(TAG, "  - %s, %s, %d", service.service_type.c_str(), service.proto.c_str(), service.port);
+    ESP_LOGV(TAG, "  - %s, %s, %d", service.service_type, service.proto, service.port);
     for (const auto &record : service.txt_records) {
-      ESP_LOGV(TAG, "    TXT: %s = %s", record.key.c_str(), record.value.c_str());
+      ESP_LOGV(TAG, "    TXT: %s = %s", record.key, record.value.c_str());
     }
   }
 }
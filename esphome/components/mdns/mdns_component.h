@@ -5,21 +5,26 @@
 #include <vector>
 #include "esphome/core/component.h"
 
+#ifdef USE_HOST
+#include "esphome/components/socket/socket.h"
+#endif
+
 namespace esphome {
 namespace mdns {
 
 struct MDNSTXTRecord {
-  std::string key;
+  // keys are string literals, from the fixed records or the generated code
+  const char *key;
   std::string value;
 };
 
 struct MDNSService {
   // service name _including_ underscore character prefix
   // as defined in RFC6763 Section 7
-  std::string service_type;
+  const char *service_type;
   // second label indicating protocol _including_ underscore character prefix
   // as defined in RFC6763 Section 7, like "_tcp" or "_udp"
-  std::string proto;
+  const char *proto;
   uint16_t port;
   std::vector<MDNSTXTRecord> txt_records;
 };
@@ -29,13 +34,23 @@ class MDNSComponent : public Component {
   void setup() override;
   void dump_config() override;
 
-#if (defined(USE_ESP8266) || defined(USE_RP2040)) && defined(USE_ARDUINO)
+#if ((defined(USE_ESP8266) || defined(USE_RP2040)) && defined(USE_ARDUINO)) || defined(USE_HOST)
   void loop() override;
 #endif
   float get_setup_priority() const override { return setup_priority::AFTER_WIFI; }
 
   void add_extra_service(MDNSService service) { services_extra_.push_back(std::move(service)); }
 
+  /** Set a TXT record of a service, adding it if the service does not have it yet.
+   *
+   * Only this record is updated in the responder instead of registering all services again. Must be called after
+   * setup(), the records are compiled there.
+   *
+   * @param key The key of the record, it must stay valid, like a string literal.
+   * @return false if there is no such service.
+   */
+  bool set_txt_record(const char *service_type, const char *proto, const char *key, const std::string &value);
+
   void on_shutdown() override;
 
  protected:
@@ -43,6 +58,18 @@ class MDNSComponent : public Component {
   std::vector<MDNSService> services_{};
   std::string hostname_;
   void compile_records_();
+  /// Update a changed TXT record of a service in the platform's responder.
+  void publish_txt_record_(const MDNSService &service, const MDNSTXTRecord &record);
+
+#ifdef USE_HOST
+  /// Send the records of all services, with a TTL of 0 when they are removed.
+  void announce_(bool goodbye);
+  /// Send a response to addr, or to the mDNS group if it is nullptr.
+  void send_response_(const std::vector<uint8_t> &packet, const struct sockaddr *addr, socklen_t addr_len);
+  void handle_query_(const uint8_t *data, size_t len, const struct sockaddr_storage &source, socklen_t source_len);
+
+  std::unique_ptr<socket::Socket> socket_;
+#endif
 };
 
 }  // namespace mdns
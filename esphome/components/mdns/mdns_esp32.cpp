@@ -26,29 +26,31 @@ void MDNSComponent::setup() {
   mdns_instance_name_set(this->hostname_.c_str());
 
   for (const auto &service : this->services_) {
+    // mdns_service_add() copies the records, the pointers only need to be valid during the call
     std::vector<mdns_txt_item_t> txt_records;
+    txt_records.reserve(service.txt_records.size());
     for (const auto &record : service.txt_records) {
       mdns_txt_item_t it{};
-      // dup strings to ensure the pointer is valid even after the record loop
-      it.key = strdup(record.key.c_str());
-      it.value = strdup(record.value.c_str());
+      it.key = record.key;
+      it.value = record.value.c_str();
       txt_records.push_back(it);
     }
-    err = mdns_service_add(nullptr, service.service_type.c_str(), service.proto.c_str(), service.port,
-                           txt_records.data(), txt_records.size());
-
-    // free records
-    for (const auto &it : txt_records) {
-      delete it.key;    // NOLINT(cppcoreguidelines-owning-memory)
-      delete it.value;  // NOLINT(cppcoreguidelines-owning-memory)
-    }
+    err = mdns_service_add(nullptr, service.service_type, service.proto, service.port, txt_records.data(),
+                           txt_records.size());
 
     if (err != ESP_OK) {
-      ESP_LOGW(TAG, "Failed to register mDNS service %s: %s", service.service_type.c_str(), esp_err_to_name(err));
+      ESP_LOGW(TAG, "Failed to register mDNS service %s: %s", service.service_type, esp_err_to_name(err));
     }
   }
 }
 
+void MDNSComponent::publish_txt_record_(const MDNSService &service, const MDNSTXTRecord &record) {
+  esp_err_t err = mdns_service_txt_item_set(service.service_type, service.proto, record.key, record.value.c_str());
+  if (err != ESP_OK) {
+    ESP_LOGW(TAG, "Failed to update mDNS TXT record %s: %s", record.key, esp_err_to_name(err));
+  }
+}
+
 void MDNSComponent::on_shutdown() {
   mdns_free();
   delay(40);  // Allow the mdns packets announcing service removal to be sent
@@ -6,12 +6,408 @@
 #include "esphome/core/log.h"
 #include "mdns_component.h"
 
+#include <arpa/inet.h>
+#include <ifaddrs.h>
+#include <net/if.h>
+#include <netinet/in.h>
+#include <strings.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <vector>
+
 namespace esphome {
 namespace mdns {
 
-void MDNSComponent::setup() { this->compile_records_(); }
+static const char *const TAG = "mdns";
+
+static const uint16_t MDNS_PORT = 5353;
+static const char *const MDNS_GROUP = "224.0.0.251";
+
+static const uint16_t TYPE_A = 1;
+static const uint16_t TYPE_PTR = 12;
+static const uint16_t TYPE_TXT = 16;
+static const uint16_t TYPE_SRV = 33;
+static const uint16_t TYPE_ANY = 255;
+static const uint16_t CLASS_IN = 1;
+/// Set in the class of answers that replace all cached records of the name and type (RFC 6762 section 10.2).
+static const uint16_t CLASS_CACHE_FLUSH = 0x8000;
+/// Set in the class of questions that ask for a unicast response (RFC 6762 section 5.4).
+static const uint16_t CLASS_UNICAST_RESPONSE = 0x8000;
+
+// TTLs recommended by RFC 6762 section 10
+static const uint32_t HOST_TTL = 120;
+static const uint32_t SERVICE_TTL = 4500;
+/// Maximum TTL of responses to queries that are not from port 5353 (RFC 6762 section 6.7).
+static const uint32_t LEGACY_UNICAST_TTL = 10;
+
+static const char *const SERVICES_NAME = "_services._dns-sd._udp.local";
+
+/// Builds the answers and additional records of a response.
+class ResponseBuilder {
+ public:
+  /// Legacy unicast responses limit the TTLs and don't set the cache flush bit (RFC 6762 section 6.7).
+  ResponseBuilder(uint32_t max_ttl, bool legacy_unicast = false) : max_ttl_(max_ttl), legacy_unicast_(legacy_unicast) {}
+
+  static void write_u16(std::vector<uint8_t> &out, uint16_t value) {
+    out.push_back(value >> 8);
+    out.push_back(value);
+  }
+  static void write_u32(std::vector<uint8_t> &out, uint32_t value) {
+    write_u16(out, value >> 16);
+    write_u16(out, value);
+  }
+  /// Write a dotted name as labels, without compression.
+  static void write_name(std::vector<uint8_t> &out, const std::string &name) {
+    size_t start = 0;
+    while (start < name.size()) {
+      size_t end = name.find('.', start);
+      if (end == std::string::npos)
+        end = name.size();
+      size_t length = std::min<size_t>(end - start, 63);
+      out.push_back(length);
+      out.insert(out.end(), name.begin() + start, name.begin() + start + length);
+      start = end + 1;
+    }
+    out.push_back(0);
+  }
+
+  void add(bool answer, const std::string &name, uint16_t type, bool cache_flush, uint32_t ttl,
+           const std::vector<uint8_t> &rdata) {
+    std::vector<uint8_t> &out = answer ? this->answers_ : this->additionals_;
+    write_name(out, name);
+    write_u16(out, type);
+    write_u16(out, CLASS_IN | (cache_flush && !this->legacy_unicast_ ? CLASS_CACHE_FLUSH : 0));
+    write_u32(out, std::min(ttl, this->max_ttl_));
+    write_u16(out, rdata.size());
+    out.insert(out.end(), rdata.begin(), rdata.end());
+    (answer ? this->answer_count_ : this->additional_count_)++;
+  }
+
+  bool empty() const { return this->answer_count_ == 0; }
+
+  /// The response packet, questions are only included in responses to legacy unicast queries.
+  std::vector<uint8_t> build(uint16_t id, const std::vector<uint8_t> &questions, uint16_t question_count) const {
+    std::vector<uint8_t> packet;
+    packet.reserve(12 + questions.size() + this->answers_.size() + this->additionals_.size());
+    write_u16(packet, id);
+    write_u16(packet, 0x8400);  // response, authoritative answer
+    write_u16(packet, question_count);
+    write_u16(packet, this->answer_count_);
+    write_u16(packet, 0);
+    write_u16(packet, this->additional_count_);
+    packet.insert(packet.end(), questions.begin(), questions.end());
+    packet.insert(packet.end(), this->answers_.begin(), this->answers_.end());
+    packet.insert(packet.end(), this->additionals_.begin(), this->additionals_.end());
+    return packet;
+  }
+
+ protected:
+  uint32_t max_ttl_;
+  bool legacy_unicast_;
+  std::vector<uint8_t> answers_;
+  std::vector<uint8_t> additionals_;
+  uint16_t answer_count_{0};
+  uint16_t additional_count_{0};
+};
+
+/// Read a possibly compressed name at offset, which is moved past it.
+static bool read_name(const uint8_t *data, size_t len, size_t &offset, std::string &name) {
+  name.clear();
+  size_t position = offset;
+  bool jumped = false;
+  // Limits the pointers followed, so that a loop of pointers ends
+  for (int labels = 0; labels < 128; labels++) {
+    if (position >= len)
+      return false;
+    uint8_t length = data[position];
+    if (length == 0) {
+      if (!jumped)
+        offset = position + 1;
+      return true;
+    }
+    if ((length & 0xC0) == 0xC0) {
+      if (position + 1 >= len)
+        return false;
+      if (!jumped)
+        offset = position + 2;
+      jumped = true;
+      position = ((length & 0x3F) << 8) | data[position + 1];
+      continue;
+    }
+    if (position + 1 + length > len)
+      return false;
+    if (!name.empty())
+      name += '.';
+    name.append(reinterpret_cast<const char *>(data + position + 1), length);
+    position += 1 + length;
+  }
+  return false;
+}
+
+/// The IPv4 addresses of the interfaces, the loopback address only if there are no others.
+static std::vector<in_addr> get_ipv4_addresses() {
+  std::vector<in_addr> addresses;
+  in_addr loopback{};
+  bool has_loopback = false;
+  struct ifaddrs *interfaces;
+  if (getifaddrs(&interfaces) != 0)
+    return addresses;
+  for (struct ifaddrs *it = interfaces; it != nullptr; it = it->ifa_next) {
+    if (it->ifa_addr == nullptr || it->ifa_addr->sa_family != AF_INET || (it->ifa_flags & IFF_UP) == 0)
+      continue;
+    in_addr address = reinterpret_cast<struct sockaddr_in *>(it->ifa_addr)->sin_addr;
+    if (it->ifa_flags & IFF_LOOPBACK) {
+      loopback = address;
+      has_loopback = true;
+    } else {
+      addresses.push_back(address);
+    }
+  }
+  freeifaddrs(interfaces);
+  if (addresses.empty() && has_loopback)
+    addresses.push_back(loopback);
+  return addresses;
+}
+
+static std::string service_name(const MDNSService &service) {
+  return std::string(service.service_type) + "." + service.proto + ".local";
+}
+
+static std::vector<uint8_t> txt_rdata(const MDNSService &service) {
+  std::vector<uint8_t> rdata;
+  for (const auto &record : service.txt_records) {
+    std::string item = std::string(record.key) + "=" + record.value;
+    item.resize(std::min<size_t>(item.size(), 255));
+    rdata.push_back(item.size());
+    rdata.insert(rdata.end(), item.begin(), item.end());
+  }
+  if (rdata.empty())
+    rdata.push_back(0);  // a TXT record has at least one string
+  return rdata;
+}
+
+static std::vector<uint8_t> name_rdata(const std::string &name) {
+  std::vector<uint8_t> rdata;
+  ResponseBuilder::write_name(rdata, name);
+  return rdata;
+}
+
+static void add_host_records(ResponseBuilder &response, bool answer, const std::string &host_name) {
+  for (const auto &address : get_ipv4_addresses()) {
+    const auto *bytes = reinterpret_cast<const uint8_t *>(&address.s_addr);
+    response.add(answer, host_name, TYPE_A, true, HOST_TTL, std::vector<uint8_t>(bytes, bytes + 4));
+  }
+}
+
+static void add_srv_record(ResponseBuilder &response, bool answer, const std::string &instance,
+                           const MDNSService &service, const std::string &host_name) {
+  std::vector<uint8_t> rdata;
+  ResponseBuilder::write_u16(rdata, 0);  // priority
+  ResponseBuilder::write_u16(rdata, 0);  // weight
+  ResponseBuilder::write_u16(rdata, service.port);
+  ResponseBuilder::write_name(rdata, host_name);
+  response.add(answer, instance, TYPE_SRV, true, HOST_TTL, rdata);
+}
+
+void MDNSComponent::setup() {
+  this->compile_records_();
+
+  this->socket_ = socket::socket_loop_monitored(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+  if (this->socket_ == nullptr) {
+    ESP_LOGW(TAG, "Could not create socket");
+    this->mark_failed();
+    return;
+  }
+  int enable = 1;
+  this->socket_->setsockopt(SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+#ifdef SO_REUSEPORT
+  // Share the port with the mDNS responder of the host
+  this->socket_->setsockopt(SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable));
+#endif
+
+  struct sockaddr_in server {};
+  server.sin_family = AF_INET;
+  server.sin_addr.s_addr = htonl(INADDR_ANY);
+  server.sin_port = htons(MDNS_PORT);
+  if (this->socket_->bind(reinterpret_cast<struct sockaddr *>(&server), sizeof(server)) != 0) {
+    ESP_LOGW(TAG, "Socket unable to bind: errno %d", errno);
+    this->mark_failed();
+    return;
+  }
+
+  struct ip_mreq membership {};
+  membership.imr_multiaddr.s_addr = inet_addr(MDNS_GROUP);
+  membership.imr_interface.s_addr = htonl(INADDR_ANY);
+  if (this->socket_->setsockopt(IPPROTO_IP, IP_ADD_MEMBERSHIP, &membership, sizeof(membership)) != 0) {
+    ESP_LOGW(TAG, "Socket unable to join the mDNS group: errno %d", errno);
+    this->mark_failed();
+    return;
+  }
+  uint8_t ttl = 255;
+  this->socket_->setsockopt(IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl));
+  this->socket_->setblocking(false);
+
+  // Announce twice, one second apart (RFC 6762 section 8.3)
+  this->announce_(false);
+  this->set_timeout(1000, [this]() { this->announce_(false); });
+}
+
+void MDNSComponent::loop() {
+  if (this->socket_ == nullptr)
+    return;
+  uint8_t buf[1500];
+  while (this->socket_->ready()) {
+    struct sockaddr_storage source;
+    socklen_t source_len = sizeof(source);
+    ssize_t len = this->socket_->recvfrom(buf, sizeof(buf), reinterpret_cast<struct sockaddr *>(&source), &source_len);
+    if (len <= 0)
+      break;
+    this->handle_query_(buf, len, source, source_len);
+  }
+}
+
+void MDNSComponent::handle_query_(const uint8_t *data, size_t len, const struct sockaddr_storage &source,
+                                  socklen_t source_len) {
+  if (len < 12 || source.ss_family != AF_INET)
+    return;
+  const uint16_t id = (data[0] << 8) | data[1];
+  const uint16_t flags = (data[2] << 8) | data[3];
+  const uint16_t question_count = (data[4] << 8) | data[5];
+  if (flags & 0x8000)
+    return;  // a response of another responder
+  const auto &source_in = reinterpret_cast<const struct sockaddr_in &>(source);
+  const bool legacy_unicast = ntohs(source_in.sin_port) != MDNS_PORT;
+
+  const std::string host_name = this->hostname_ + ".local";
+  std::vector<std::string> instances;
+  instances.reserve(this->services_.size());
+  for (const auto &service : this->services_)
+    instances.push_back(this->hostname_ + "." + service_name(service));
+
+  ResponseBuilder response(legacy_unicast ? LEGACY_UNICAST_TTL : SERVICE_TTL, legacy_unicast);
+  std::vector<uint8_t> questions;
+  uint16_t answered_questions = 0;
+  bool unicast_response = legacy_unicast;
+  // Which records were added, so that the additional records don't repeat them
+  bool host_added = false;
+  std::vector<bool> srv_added(this->services_.size()), txt_added(this->services_.size());
+
+  size_t offset = 12;
+  for (uint16_t q = 0; q < question_count; q++) {
+    std::string name;
+    if (!read_name(data, len, offset, name) || offset + 4 > len)
+      return;
+    const uint16_t type = (data[offset] << 8) | data[offset + 1];
+    const uint16_t qclass = (data[offset + 2] << 8) | data[offset + 3];
+    offset += 4;
+    const bool any = type == TYPE_ANY;
+    bool answered = false;
+
+    if ((any || type == TYPE_A) && strcasecmp(name.c_str(), host_name.c_str()) == 0 && !host_added) {
+      add_host_records(response, true, host_name);
+      host_added = answered = true;
+    }
+    for (size_t i = 0; i < this->services_.size(); i++) {
+      const auto &service = this->services_[i];
+      const std::string type_name = service_name(service);
+      if ((any || type == TYPE_PTR) && strcasecmp(name.c_str(), SERVICES_NAME) == 0) {
+        response.add(true, SERVICES_NAME, TYPE_PTR, false, SERVICE_TTL, name_rdata(type_name));
+        answered = true;
+      }
+      if ((any || type == TYPE_PTR) && strcasecmp(name.c_str(), type_name.c_str()) == 0) {
+        response.add(true, type_name, TYPE_PTR, false, SERVICE_TTL, name_rdata(instances[i]));
+        answered = true;
+      } else if (strcasecmp(name.c_str(), instances[i].c_str()) != 0) {
+        continue;
+      }
+      // The PTR is answered with the SRV and TXT records of the instance, they are answers if asked for
+      const bool instance_question = strcasecmp(name.c_str(), instances[i].c_str()) == 0;
+      if (!srv_added[i] && (!instance_question || any || type == TYPE_SRV)) {
+        add_srv_record(response, instance_question, instances[i], service, host_name);
+        srv_added[i] = true;
+        answered = true;
+      }
+      if (!txt_added[i] && (!instance_question || any || type == TYPE_TXT)) {
+        response.add(instance_question, instances[i], TYPE_TXT, true, SERVICE_TTL, txt_rdata(service));
+        txt_added[i] = true;
+        answered = true;
+      }
+    }
+
+    if (answered) {
+      answered_questions++;
+      if (legacy_unicast) {
+        ResponseBuilder::write_name(questions, name);
+        ResponseBuilder::write_u16(questions, type);
+        ResponseBuilder::write_u16(questions, qclass);
+      }
+      if (qclass & CLASS_UNICAST_RESPONSE)
+        unicast_response = true;
+    }
+  }
+  if (response.empty())
+    return;
+  if (!host_added && std::any_of(srv_added.begin(), srv_added.end(), [](bool added) { return added; }))
+    add_host_records(response, false, host_name);
+
+  std::vector<uint8_t> packet =
+      response.build(legacy_unicast ? id : 0, questions, legacy_unicast ? answered_questions : 0);
+  if (unicast_response) {
+    this->send_response_(packet, reinterpret_cast<const struct sockaddr *>(&source), source_len);
+  } else {
+    this->send_response_(packet, nullptr, 0);
+  }
+}
+
+void MDNSComponent::send_response_(const std::vector<uint8_t> &packet, const struct sockaddr *addr,
+                                   socklen_t addr_len) {
+  struct sockaddr_in group {};
+  if (addr == nullptr) {
+    group.sin_family = AF_INET;
+    group.sin_addr.s_addr = inet_addr(MDNS_GROUP);
+    group.sin_port = htons(MDNS_PORT);
+    addr = reinterpret_cast<const struct sockaddr *>(&group);
+    addr_len = sizeof(group);
+  }
+  if (this->socket_->sendto(packet.data(), packet.size(), 0, addr, addr_len) < 0)
+    ESP_LOGV(TAG, "Sending response failed: errno %d", errno);
+}
+
+void MDNSComponent::announce_(bool goodbye) {
+  if (this->socket_ == nullptr)
+    return;
+  ResponseBuilder response(goodbye ? 0 : SERVICE_TTL);
+  const std::string host_name = this->hostname_ + ".local";
+  for (const auto &service : this->services_) {
+    const std::string type_name = service_name(service);
+    const std::string instance = this->hostname_ + "." + type_name;
+    response.add(true, SERVICES_NAME, TYPE_PTR, false, SERVICE_TTL, name_rdata(type_name));
+    response.add(true, type_name, TYPE_PTR, false, SERVICE_TTL, name_rdata(instance));
+    add_srv_record(response, true, instance, service, host_name);
+    response.add(true, instance, TYPE_TXT, true, SERVICE_TTL, txt_rdata(service));
+  }
+  add_host_records(response, true, host_name);
+
+  this->send_response_(response.build(0, {}, 0), nullptr, 0);
+}
+
+void MDNSComponent::publish_txt_record_(const MDNSService &service, const MDNSTXTRecord &record) {
+  if (this->socket_ == nullptr)
+    return;
+  // Only the TXT record of the service is announced, the cache flush bit replaces the old one
+  ResponseBuilder response(SERVICE_TTL);
+  response.add(true, this->hostname_ + "." + service_name(service), TYPE_TXT, true, SERVICE_TTL,
+               txt_rdata(service));
+  this->send_response_(response.build(0, {}, 0), nullptr, 0);
+}
 
-void MDNSComponent::on_shutdown() {}
+void MDNSComponent::on_shutdown() {
+  // Tell the other hosts to remove the records from their caches
+  this->announce_(true);
+}
 
 }  // namespace mdns
 }  // namespace esphome
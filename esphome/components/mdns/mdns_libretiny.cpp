@@ -11,6 +11,8 @@
 namespace esphome {
 namespace mdns {
 
+static const char *const TAG = "mdns";
+
 void MDNSComponent::setup() {
   this->compile_records_();
 
@@ -21,21 +23,25 @@ void MDNSComponent::setup() {
     // part of the wire protocol to have an underscore, and for example ESP-IDF
     // expects the underscore to be there, the ESP8266 implementation always adds
     // the underscore itself.
-    auto *proto = service.proto.c_str();
+    const auto *proto = service.proto;
     while (*proto == '_') {
       proto++;
     }
-    auto *service_type = service.service_type.c_str();
+    const auto *service_type = service.service_type;
     while (*service_type == '_') {
       service_type++;
     }
     MDNS.addService(service_type, proto, service.port);
     for (const auto &record : service.txt_records) {
-      MDNS.addServiceTxt(service_type, proto, record.key.c_str(), record.value.c_str());
+      MDNS.addServiceTxt(service_type, proto, record.key, record.value.c_str());
     }
   }
 }
 
+void MDNSComponent::publish_txt_record_(const MDNSService &service, const MDNSTXTRecord &record) {
+  ESP_LOGW(TAG, "Updating mDNS TXT records is not supported on this platform, %s is not updated", record.key);
+}
+
 void MDNSComponent::on_shutdown() {}
 
 }  // namespace mdns
@@ -11,31 +11,40 @@
 namespace esphome {
 namespace mdns {
 
-void MDNSComponent::setup() {
-  this->compile_records_();
-
-  MDNS.begin(this->hostname_.c_str());
+static void register_services(const std::string &hostname, const std::vector<MDNSService> &services) {
+  MDNS.begin(hostname.c_str());
 
-  for (const auto &service : this->services_) {
+  for (const auto &service : services) {
     // Strip the leading underscore from the proto and service_type. While it is
     // part of the wire protocol to have an underscore, and for example ESP-IDF
     // expects the underscore to be there, the ESP8266 implementation always adds
     // the underscore itself.
-    auto *proto = service.proto.c_str();
+    const auto *proto = service.proto;
     while (*proto == '_') {
       proto++;
     }
-    auto *service_type = service.service_type.c_str();
+    const auto *service_type = service.service_type;
     while (*service_type == '_') {
       service_type++;
     }
     MDNS.addService(service_type, proto, service.port);
     for (const auto &record : service.txt_records) {
-      MDNS.addServiceTxt(service_type, proto, record.key.c_str(), record.value.c_str());
+      MDNS.addServiceTxt(service_type, proto, record.key, record.value.c_str());
     }
   }
 }
 
+void MDNSComponent::setup() {
+  this->compile_records_();
+  register_services(this->hostname_, this->services_);
+}
+
+void MDNSComponent::publish_txt_record_(const MDNSService &service, const MDNSTXTRecord &record) {
+  // Records can only be added, so a changed one requires registering the services again
+  MDNS.close();
+  register_services(this->hostname_, this->services_);
+}
+
 void MDNSComponent::loop() { MDNS.update(); }
 
 void MDNSComponent::on_shutdown() {
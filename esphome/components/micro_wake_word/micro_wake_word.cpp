@@ -21,10 +21,19 @@ namespace micro_wake_word {
 
 static const char *const TAG = "micro_wake_word";
 
-static const size_t SAMPLE_RATE_HZ = 16000;  // 16 kHz
-static const size_t BUFFER_LENGTH = 64;      // 0.064 seconds
-static const size_t BUFFER_SIZE = SAMPLE_RATE_HZ / 1000 * BUFFER_LENGTH;
-static const size_t INPUT_BUFFER_SIZE = 16 * SAMPLE_RATE_HZ / 1000;  // 16ms * 16kHz / 1000ms
+static const uint32_t MICROPHONE_READ_TIMEOUT_MS = 100;
+// Feature slices kept for the wake word models to catch up on once the VAD model detects voice
+static const uint32_t VAD_LOOKBACK_MS = 300;
+static const size_t INFERENCE_TASK_STACK_SIZE = 3072;
+static const ssize_t INFERENCE_TASK_PRIORITY = 3;
+
+enum EventGroupBits : uint32_t {
+  COMMAND_STOP = (1 << 0),                 // stops the inference task
+  STATE_STOPPED = (1 << 1),                // set by the inference task right before it deletes itself
+  WAKE_WORD_DETECTED = (1 << 2),           // detected_wake_word_ holds the wake word, the task stops itself
+  WARNING_MICROPHONE_OVERFLOW = (1 << 3),  // audio frames were missed since the warning was last logged
+  ALL_BITS = 0x00FFFFFF,                   // All valid FreeRTOS event group bits
+};
 
 float MicroWakeWord::get_setup_priority() const { return setup_priority::AFTER_CONNECTION; }
 
@@ -49,6 +58,7 @@ static const LogString *micro_wake_word_state_to_string(State state) {
 
 void MicroWakeWord::dump_config() {
   ESP_LOGCONFIG(TAG, "microWakeWord:");
+  ESP_LOGCONFIG(TAG, "  Inference stride: %u", this->inference_stride_);
   ESP_LOGCONFIG(TAG, "  models:");
   for (auto &model : this->wake_word_models_) {
     model.log_model_config();
@@ -66,6 +76,13 @@ void MicroWakeWord::setup() {
     return;
   }
 
+  this->event_group_ = xEventGroupCreate();
+  if (this->event_group_ == nullptr) {
+    ESP_LOGE(TAG, "Failed to create event group");
+    this->mark_failed();
+    return;
+  }
+
   ESP_LOGCONFIG(TAG, "Micro Wake Word initialized");
 
   this->frontend_config_.window.size_ms = FEATURE_DURATION_MS;
@@ -107,34 +124,57 @@ void MicroWakeWord::loop() {
       ESP_LOGD(TAG, "Starting Microphone");
       this->microphone_->start();
       this->set_state_(State::STARTING_MICROPHONE);
-      this->high_freq_.start();
       break;
     case State::STARTING_MICROPHONE:
       if (this->microphone_->is_running()) {
-        this->set_state_(State::DETECTING_WAKE_WORD);
+        // The microphone may have been running for someone else already
+        this->microphone_reader_->reset();
+        if (this->start_inference_task_()) {
+          this->set_state_(State::DETECTING_WAKE_WORD);
+        } else {
+          ESP_LOGE(TAG, "Failed to start inference task");
+          this->status_set_error();
+          this->set_state_(State::STOP_MICROPHONE);
+        }
       }
       break;
-    case State::DETECTING_WAKE_WORD:
-      while (!this->has_enough_samples_()) {
-        this->read_microphone_();
+    case State::DETECTING_WAKE_WORD: {
+      const EventBits_t event_bits = xEventGroupGetBits(this->event_group_);
+      if (event_bits & WARNING_MICROPHONE_OVERFLOW) {
+        xEventGroupClearBits(this->event_group_, WARNING_MICROPHONE_OVERFLOW);
+        ESP_LOGW(TAG, "Missed audio frames from the microphone. Wake word detection accuracy will be reduced.");
       }
-      this->update_model_probabilities_();
-      if (this->detect_wake_words_()) {
+      if (event_bits & WAKE_WORD_DETECTED) {
         ESP_LOGD(TAG, "Wake Word '%s' Detected", (this->detected_wake_word_).c_str());
         this->detected_ = true;
         this->set_state_(State::STOP_MICROPHONE);
       }
       break;
+    }
     case State::STOP_MICROPHONE:
       ESP_LOGD(TAG, "Stopping Microphone");
+      xEventGroupSetBits(this->event_group_, COMMAND_STOP);
       this->microphone_->stop();
       this->set_state_(State::STOPPING_MICROPHONE);
-      this->high_freq_.stop();
-      this->unload_models_();
-      this->deallocate_buffers_();
       break;
     case State::STOPPING_MICROPHONE:
+      if (this->inference_task_handle_ != nullptr) {
+        if (!(xEventGroupGetBits(this->event_group_) & STATE_STOPPED)) {
+          break;  // Waiting for the inference task to finish its current step
+        }
+        this->inference_task_handle_ = nullptr;
+        for (auto &model : this->wake_word_models_) {
+          model.log_inference_metrics();
+        }
+#ifdef USE_MICRO_WAKE_WORD_VAD
+        this->vad_model_->log_inference_metrics();
+        ESP_LOGD(TAG, "Wake word models were paused for %" PRIu32 " of %" PRIu32 " feature slices without voice",
+                 this->vad_skipped_slices_, this->features_generated_);
+#endif
+      }
       if (this->microphone_->is_stopped()) {
+        this->unload_models_();
+        this->deallocate_buffers_();
         this->set_state_(State::IDLE);
         if (this->detected_) {
           this->wake_word_detected_trigger_->trigger(this->detected_wake_word_);
@@ -157,6 +197,15 @@ void MicroWakeWord::start() {
     return;
   }
 
+  if (this->microphone_reader_ == nullptr) {
+    this->microphone_reader_ = this->microphone_->create_reader();
+    if (this->microphone_reader_ == nullptr) {
+      ESP_LOGE(TAG, "The microphone does not support frame readers");
+      this->status_set_error();
+      return;
+    }
+  }
+
   if (!this->load_models_() || !this->allocate_buffers_()) {
     ESP_LOGE(TAG, "Failed to load the wake word model(s) or allocate buffers");
     this->status_set_error();
@@ -196,37 +245,40 @@ void MicroWakeWord::set_state_(State state) {
   this->state_ = state;
 }
 
-size_t MicroWakeWord::read_microphone_() {
-  size_t bytes_read = this->microphone_->read(this->input_buffer_, INPUT_BUFFER_SIZE * sizeof(int16_t));
-  if (bytes_read == 0) {
-    return 0;
-  }
+bool MicroWakeWord::start_inference_task_() {
+  xEventGroupClearBits(this->event_group_, ALL_BITS);
+  xTaskCreate(MicroWakeWord::inference_task, "mww_task", INFERENCE_TASK_STACK_SIZE, (void *) this,
+              INFERENCE_TASK_PRIORITY, &this->inference_task_handle_);
+  return this->inference_task_handle_ != nullptr;
+}
+
+void MicroWakeWord::inference_task(void *params) {
+  MicroWakeWord *this_mww = (MicroWakeWord *) params;
 
-  size_t bytes_free = this->ring_buffer_->free();
+  while (!(xEventGroupGetBits(this_mww->event_group_) & COMMAND_STOP)) {
+    if (!this_mww->update_model_probabilities_()) {
+      continue;
+    }
 
-  if (bytes_free < bytes_read) {
-    ESP_LOGW(TAG,
-             "Not enough free bytes in ring buffer to store incoming audio data (free bytes=%d, incoming bytes=%d). "
-             "Resetting the ring buffer. Wake word detection accuracy will be reduced.",
-             bytes_free, bytes_read);
+    uint32_t overflow_count = this_mww->microphone_reader_->get_overflow_count();
+    if (overflow_count != this_mww->microphone_overflow_count_) {
+      this_mww->microphone_overflow_count_ = overflow_count;
+      xEventGroupSetBits(this_mww->event_group_, WARNING_MICROPHONE_OVERFLOW);
+    }
 
-    this->ring_buffer_->reset();
+    if (this_mww->detect_wake_words_()) {
+      xEventGroupSetBits(this_mww->event_group_, WAKE_WORD_DETECTED);
+      break;
+    }
   }
 
-  return this->ring_buffer_->write((void *) this->input_buffer_, bytes_read);
+  xEventGroupSetBits(this_mww->event_group_, STATE_STOPPED);
+  vTaskDelete(nullptr);
 }
 
 bool MicroWakeWord::allocate_buffers_() {
   ExternalRAMAllocator<int16_t> audio_samples_allocator(ExternalRAMAllocator<int16_t>::ALLOW_FAILURE);
 
-  if (this->input_buffer_ == nullptr) {
-    this->input_buffer_ = audio_samples_allocator.allocate(INPUT_BUFFER_SIZE * sizeof(int16_t));
-    if (this->input_buffer_ == nullptr) {
-      ESP_LOGE(TAG, "Could not allocate input buffer");
-      return false;
-    }
-  }
-
   if (this->preprocessor_audio_buffer_ == nullptr) {
     this->preprocessor_audio_buffer_ = audio_samples_allocator.allocate(this->new_samples_to_get_());
     if (this->preprocessor_audio_buffer_ == nullptr) {
@@ -235,10 +287,15 @@ bool MicroWakeWord::allocate_buffers_() {
     }
   }
 
-  if (this->ring_buffer_ == nullptr) {
-    this->ring_buffer_ = RingBuffer::create(BUFFER_SIZE * sizeof(int16_t));
-    if (this->ring_buffer_ == nullptr) {
-      ESP_LOGE(TAG, "Could not allocate ring buffer");
+  if (this->features_buffer_ == nullptr) {
+    ExternalRAMAllocator<int8_t> features_allocator(ExternalRAMAllocator<int8_t>::ALLOW_FAILURE);
+    this->features_buffer_slices_ = this->inference_stride_;
+#ifdef USE_MICRO_WAKE_WORD_VAD
+    this->features_buffer_slices_ += VAD_LOOKBACK_MS / this->features_step_size_;
+#endif
+    this->features_buffer_ = features_allocator.allocate(this->features_buffer_slices_ * PREPROCESSOR_FEATURE_SIZE);
+    if (this->features_buffer_ == nullptr) {
+      ESP_LOGE(TAG, "Could not allocate the feature buffer.");
       return false;
     }
   }
@@ -248,10 +305,12 @@ bool MicroWakeWord::allocate_buffers_() {
 
 void MicroWakeWord::deallocate_buffers_() {
   ExternalRAMAllocator<int16_t> audio_samples_allocator(ExternalRAMAllocator<int16_t>::ALLOW_FAILURE);
-  audio_samples_allocator.deallocate(this->input_buffer_, INPUT_BUFFER_SIZE * sizeof(int16_t));
-  this->input_buffer_ = nullptr;
   audio_samples_allocator.deallocate(this->preprocessor_audio_buffer_, this->new_samples_to_get_());
   this->preprocessor_audio_buffer_ = nullptr;
+
+  ExternalRAMAllocator<int8_t> features_allocator(ExternalRAMAllocator<int8_t>::ALLOW_FAILURE);
+  features_allocator.deallocate(this->features_buffer_, this->features_buffer_slices_ * PREPROCESSOR_FEATURE_SIZE);
+  this->features_buffer_ = nullptr;
 }
 
 bool MicroWakeWord::load_models_() {
@@ -290,23 +349,47 @@ void MicroWakeWord::unload_models_() {
 #endif
 }
 
-void MicroWakeWord::update_model_probabilities_() {
-  int8_t audio_features[PREPROCESSOR_FEATURE_SIZE];
+bool MicroWakeWord::update_model_probabilities_() {
+  for (uint8_t i = 0; i < this->inference_stride_; i++) {
+    const size_t slice = this->features_generated_ % this->features_buffer_slices_;
+    int8_t *features = &this->features_buffer_[slice * PREPROCESSOR_FEATURE_SIZE];
+    while (!this->generate_features_for_window_(features)) {
+      if (xEventGroupGetBits(this->event_group_) & COMMAND_STOP) {
+        return false;
+      }
+    }
+    ++this->features_generated_;
 
-  if (!this->generate_features_for_window_(audio_features)) {
-    return;
+    // Increase the counter since the last positive detection
+    this->ignore_windows_ = std::min(this->ignore_windows_ + 1, 0);
   }
 
-  // Increase the counter since the last positive detection
-  this->ignore_windows_ = std::min(this->ignore_windows_ + 1, 0);
+#ifdef USE_MICRO_WAKE_WORD_VAD
+  this->feed_model_(*this->vad_model_);
+  if (!this->vad_model_->determine_detected()) {
+    // The wake word models catch up on the buffered slices once there is voice
+    this->vad_skipped_slices_ += this->inference_stride_;
+    return true;
+  }
+#endif
 
   for (auto &model : this->wake_word_models_) {
-    // Perform inference
-    model.perform_streaming_inference(audio_features);
+    this->feed_model_(model);
   }
-#ifdef USE_MICRO_WAKE_WORD_VAD
-  this->vad_model_->perform_streaming_inference(audio_features);
-#endif
+  return true;
+}
+
+void MicroWakeWord::feed_model_(StreamingModel &model) {
+  uint32_t position = model.get_features_processed();
+  if (this->features_generated_ - position > this->features_buffer_slices_) {
+    // The oldest slices were already overwritten
+    position = this->features_generated_ - this->features_buffer_slices_;
+  }
+  for (; position != this->features_generated_; ++position) {
+    model.perform_streaming_inference(
+        &this->features_buffer_[(position % this->features_buffer_slices_) * PREPROCESSOR_FEATURE_SIZE]);
+  }
+  model.set_features_processed(position);
 }
 
 bool MicroWakeWord::detect_wake_words_() {
@@ -337,28 +420,15 @@ bool MicroWakeWord::detect_wake_words_() {
   return false;
 }
 
-bool MicroWakeWord::has_enough_samples_() {
-  return this->ring_buffer_->available() >=
-         (this->features_step_size_ * (AUDIO_SAMPLE_FREQUENCY / 1000)) * sizeof(int16_t);
-}
-
 bool MicroWakeWord::generate_features_for_window_(int8_t features[PREPROCESSOR_FEATURE_SIZE]) {
-  // Ensure we have enough new audio samples in the ring buffer for a full window
-  if (!this->has_enough_samples_()) {
-    return false;
-  }
-
-  size_t bytes_read = this->ring_buffer_->read((void *) (this->preprocessor_audio_buffer_),
-                                               this->new_samples_to_get_() * sizeof(int16_t), pdMS_TO_TICKS(200));
-
-  if (bytes_read == 0) {
-    ESP_LOGE(TAG, "Could not read data from Ring Buffer");
-  } else if (bytes_read < this->new_samples_to_get_() * sizeof(int16_t)) {
-    ESP_LOGD(TAG, "Partial Read of Data by Model");
-    ESP_LOGD(TAG, "Could only read %d bytes when required %d bytes ", bytes_read,
-             (int) (this->new_samples_to_get_() * sizeof(int16_t)));
+  // Collect a full step of new audio samples, which may take several reads
+  this->preprocessor_audio_samples_ += this->microphone_reader_->read_samples(
+      this->preprocessor_audio_buffer_ + this->preprocessor_audio_samples_,
+      this->new_samples_to_get_() - this->preprocessor_audio_samples_, MICROPHONE_READ_TIMEOUT_MS);
+  if (this->preprocessor_audio_samples_ < this->new_samples_to_get_()) {
     return false;
   }
+  this->preprocessor_audio_samples_ = 0;
 
   size_t num_samples_read;
   struct FrontendOutput frontend_output = FrontendProcessSamples(
@@ -397,7 +467,9 @@ bool MicroWakeWord::generate_features_for_window_(int8_t features[PREPROCESSOR_F
 
 void MicroWakeWord::reset_states_() {
   ESP_LOGD(TAG, "Resetting buffers and probabilities");
-  this->ring_buffer_->reset();
+  this->preprocessor_audio_samples_ = 0;
+  this->features_generated_ = 0;
+  this->vad_skipped_slices_ = 0;
   this->ignore_windows_ = -MIN_SLICES_BEFORE_DETECTION;
   for (auto &model : this->wake_word_models_) {
     model.reset_probabilities();
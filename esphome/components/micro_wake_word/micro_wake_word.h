@@ -7,12 +7,15 @@
 
 #include "esphome/core/automation.h"
 #include "esphome/core/component.h"
-#include "esphome/core/ring_buffer.h"
 
 #include "esphome/components/microphone/microphone.h"
 
 #include <frontend_util.h>
 
+#include <freertos/FreeRTOS.h>
+#include <freertos/event_groups.h>
+#include <freertos/task.h>
+
 #include <tensorflow/lite/core/c/common.h>
 #include <tensorflow/lite/micro/micro_interpreter.h>
 #include <tensorflow/lite/micro/micro_mutable_op_resolver.h>
@@ -46,6 +49,10 @@ class MicroWakeWord : public Component {
 
   void set_features_step_size(uint8_t step_size) { this->features_step_size_ = step_size; }
 
+  /// @brief Sets how many feature slices are generated before the models are run. Higher values wake the inference
+  /// task less often at the cost of detection latency.
+  void set_inference_stride(uint8_t inference_stride) { this->inference_stride_ = inference_stride; }
+
   void set_microphone(microphone::Microphone *microphone) { this->microphone_ = microphone; }
 
   Trigger<std::string> *get_wake_word_detected_trigger() const { return this->wake_word_detected_trigger_; }
@@ -62,9 +69,9 @@ class MicroWakeWord : public Component {
   microphone::Microphone *microphone_{nullptr};
   Trigger<std::string> *wake_word_detected_trigger_ = new Trigger<std::string>();
   State state_{State::IDLE};
-  HighFrequencyLoopRequester high_freq_;
 
-  std::unique_ptr<RingBuffer> ring_buffer_;
+  TaskHandle_t inference_task_handle_{nullptr};
+  EventGroupHandle_t event_group_{nullptr};
 
   std::vector<WakeWordModel> wake_word_models_;
 
@@ -83,35 +90,44 @@ class MicroWakeWord : public Component {
   int16_t ignore_windows_{-MIN_SLICES_BEFORE_DETECTION};
 
   uint8_t features_step_size_;
+  uint8_t inference_stride_{1};
 
-  // Stores audio read from the microphone before being added to the ring buffer.
-  int16_t *input_buffer_{nullptr};
+  // Reads the frames captured by the microphone without copying them.
+  std::unique_ptr<microphone::FrameReader> microphone_reader_;
+  uint32_t microphone_overflow_count_{0};
   // Stores audio to be fed into the audio frontend for generating features.
   int16_t *preprocessor_audio_buffer_{nullptr};
+  size_t preprocessor_audio_samples_{0};
+
+  // Ring of the most recent feature slices, shared by all models. Each model keeps its own position in it, so a model
+  // that was skipped can catch up on the slices it missed as long as they have not been overwritten.
+  int8_t *features_buffer_{nullptr};
+  size_t features_buffer_slices_{0};
+  uint32_t features_generated_{0};
+
+  // Feature slices on which the wake word models were not run as the VAD model detected no voice
+  uint32_t vad_skipped_slices_{0};
 
   bool detected_{false};
   std::string detected_wake_word_{""};
 
   void set_state_(State state);
 
-  /// @brief Tests if there are enough samples in the ring buffer to generate new features.
-  /// @return True if enough samples, false otherwise.
-  bool has_enough_samples_();
+  /// @brief Function for the FreeRTOS task that generates features and runs the models.
+  /// Runs until a wake word is detected or it receives the COMMAND_STOP signal via event_group_, then sets
+  /// STATE_STOPPED and deletes itself.
+  /// @param params MicroWakeWord component
+  static void inference_task(void *params);
 
-  /** Reads audio from microphone into the ring buffer
-   *
-   * Audio data (16000 kHz with int16 samples) is read into the input_buffer_.
-   * Verifies the ring buffer has enough space for all audio data. If not, it logs
-   * a warning and resets the ring buffer entirely.
-   * @return Number of bytes written to the ring buffer
-   */
-  size_t read_microphone_();
+  /// @brief Starts the inference task
+  /// @return True if successful, false otherwise
+  bool start_inference_task_();
 
-  /// @brief Allocates memory for input_buffer_, preprocessor_audio_buffer_, and ring_buffer_
+  /// @brief Allocates memory for preprocessor_audio_buffer_ and features_buffer_
   /// @return True if successful, false otherwise
   bool allocate_buffers_();
 
-  /// @brief Frees memory allocated for input_buffer_ and preprocessor_audio_buffer_
+  /// @brief Frees memory allocated for preprocessor_audio_buffer_ and features_buffer_
   void deallocate_buffers_();
 
   /// @brief Loads streaming models and prepares the feature generation frontend
@@ -124,10 +140,14 @@ class MicroWakeWord : public Component {
 
   /** Performs inference with each configured model
    *
-   * If enough audio samples are available, it will generate one slice of new features.
-   * It then loops through and performs inference with each of the loaded models.
+   * Generates inference_stride_ new feature slices, then runs every model on the slices it hasn't processed yet. With a
+   * VAD model, the wake word models are skipped while it detects no voice.
+   * @return True if new features were generated, false if the task was asked to stop first.
    */
-  void update_model_probabilities_();
+  bool update_model_probabilities_();
+
+  /// @brief Runs a model on the slices in features_buffer_ it hasn't processed yet.
+  void feed_model_(StreamingModel &model);
 
   /** Checks every model's recent probabilities to determine if the wake word has been predicted
    *
@@ -139,14 +159,14 @@ class MicroWakeWord : public Component {
 
   /** Generates features for a window of audio samples
    *
-   * Reads samples from the ring buffer and feeds them into the preprocessor frontend.
+   * Reads samples from the microphone and feeds them into the preprocessor frontend.
    * Adapted from TFLite microspeech frontend.
    * @param features int8_t array to store the audio features
-   * @return True if successful, false otherwise.
+   * @return True if successful, false if there is not enough audio yet.
    */
   bool generate_features_for_window_(int8_t features[PREPROCESSOR_FEATURE_SIZE]);
 
-  /// @brief Resets the ring buffer, ignore_windows_, and sliding window probabilities
+  /// @brief Resets the feature buffer, ignore_windows_, and sliding window probabilities
   void reset_states_();
 
   /// @brief Returns true if successfully registered the streaming model's TensorFlow operations
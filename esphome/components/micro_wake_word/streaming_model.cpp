@@ -23,6 +23,15 @@ void VADModel::log_model_config() {
   ESP_LOGCONFIG(TAG, "      Sliding window size: %d", this->sliding_window_size_);
 }
 
+void StreamingModel::log_inference_metrics_(const char *name) {
+  if (this->inference_count_ == 0) {
+    ESP_LOGD(TAG, "The '%s' model was not invoked", name);
+    return;
+  }
+  ESP_LOGD(TAG, "The '%s' model was invoked %" PRIu32 " times, taking %" PRIu32 " us on average", name,
+           this->inference_count_, this->inference_time_us_ / this->inference_count_);
+}
+
 bool StreamingModel::load_model(tflite::MicroMutableOpResolver<20> &op_resolver) {
   ExternalRAMAllocator<uint8_t> arena_allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
 
@@ -112,7 +121,10 @@ bool StreamingModel::perform_streaming_inference(const int8_t features[PREPROCES
     if (this->current_stride_step_ >= stride) {
       this->current_stride_step_ = 0;
 
+      const uint32_t start = micros();
       TfLiteStatus invoke_status = this->interpreter_->Invoke();
+      this->inference_time_us_ += micros() - start;
+      ++this->inference_count_;
       if (invoke_status != kTfLiteOk) {
         ESP_LOGW(TAG, "Streaming interpreter invoke failed");
         return false;
@@ -135,6 +147,9 @@ void StreamingModel::reset_probabilities() {
   for (auto &prob : this->recent_streaming_probabilities_) {
     prob = 0;
   }
+  this->features_processed_ = 0;
+  this->inference_count_ = 0;
+  this->inference_time_us_ = 0;
 }
 
 WakeWordModel::WakeWordModel(const uint8_t *model_start, float probability_cutoff, size_t sliding_window_average_size,
@@ -16,13 +16,18 @@ static const uint32_t STREAMING_MODEL_VARIABLE_ARENA_SIZE = 1024;
 class StreamingModel {
  public:
   virtual void log_model_config() = 0;
+  virtual void log_inference_metrics() = 0;
   virtual bool determine_detected() = 0;
 
   bool perform_streaming_inference(const int8_t features[PREPROCESSOR_FEATURE_SIZE]);
 
-  /// @brief Sets all recent_streaming_probabilities to 0
+  /// @brief Sets all recent_streaming_probabilities to 0 and clears the inference metrics
   void reset_probabilities();
 
+  /// @brief Number of feature slices the model has processed since it was last reset
+  uint32_t get_features_processed() const { return this->features_processed_; }
+  void set_features_processed(uint32_t features_processed) { this->features_processed_ = features_processed; }
+
   /// @brief Allocates tensor and variable arenas and sets up the model interpreter
   /// @param op_resolver MicroMutableOpResolver object that must exist until the model is unloaded
   /// @return True if successful, false otherwise
@@ -32,7 +37,14 @@ class StreamingModel {
   void unload_model();
 
  protected:
+  /// @brief Logs how often the model was invoked and how long that took on average
+  void log_inference_metrics_(const char *name);
+
   uint8_t current_stride_step_{0};
+  uint32_t features_processed_{0};
+
+  uint32_t inference_count_{0};
+  uint32_t inference_time_us_{0};
 
   float probability_cutoff_;
   size_t sliding_window_size_;
@@ -54,6 +66,7 @@ class WakeWordModel final : public StreamingModel {
                 const std::string &wake_word, size_t tensor_arena_size);
 
   void log_model_config() override;
+  void log_inference_metrics() override { this->log_inference_metrics_(this->wake_word_.c_str()); }
 
   /// @brief Checks for the wake word by comparing the mean probability in the sliding window with the probability
   /// cutoff
@@ -71,6 +84,7 @@ class VADModel final : public StreamingModel {
   VADModel(const uint8_t *model_start, float probability_cutoff, size_t sliding_window_size, size_t tensor_arena_size);
 
   void log_model_config() override;
+  void log_inference_metrics() override { this->log_inference_metrics_("VAD"); }
 
   /// @brief Checks for voice activity by comparing the max probability in the sliding window with the probability
   /// cutoff
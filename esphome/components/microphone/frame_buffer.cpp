@@ -0,0 +1,101 @@
+#include "frame_buffer.h"
+
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace esphome {
+namespace microphone {
+
+FrameBuffer::~FrameBuffer() {
+  ExternalRAMAllocator<int16_t> samples_allocator(ExternalRAMAllocator<int16_t>::ALLOW_FAILURE);
+  ExternalRAMAllocator<uint32_t> timestamps_allocator(ExternalRAMAllocator<uint32_t>::ALLOW_FAILURE);
+  if (this->samples_ != nullptr)
+    samples_allocator.deallocate(this->samples_, this->frame_length_ * this->frame_count_);
+  if (this->timestamps_ != nullptr)
+    timestamps_allocator.deallocate(this->timestamps_, this->frame_count_);
+}
+
+bool FrameBuffer::allocate() {
+  ExternalRAMAllocator<int16_t> samples_allocator(ExternalRAMAllocator<int16_t>::ALLOW_FAILURE);
+  ExternalRAMAllocator<uint32_t> timestamps_allocator(ExternalRAMAllocator<uint32_t>::ALLOW_FAILURE);
+  if (this->samples_ == nullptr)
+    this->samples_ = samples_allocator.allocate(this->frame_length_ * this->frame_count_);
+  if (this->timestamps_ == nullptr)
+    this->timestamps_ = timestamps_allocator.allocate(this->frame_count_);
+  return this->samples_ != nullptr && this->timestamps_ != nullptr;
+}
+
+void FrameBuffer::commit_frame(uint32_t timestamp) {
+  uint32_t sequence = this->write_sequence_.load(std::memory_order_relaxed);
+  this->timestamps_[sequence % this->frame_count_] = timestamp;
+  this->write_sequence_.store(sequence + 1, std::memory_order_release);
+}
+
+size_t FrameReader::available() const {
+  // The oldest frame is the one being overwritten
+  return std::min<uint32_t>(this->buffer_->get_write_sequence() - this->sequence_, this->buffer_->frame_count_ - 1);
+}
+
+uint32_t FrameReader::wait_(uint32_t timeout_ms) const {
+  const uint32_t start = millis();
+  uint32_t write_sequence = this->buffer_->get_write_sequence();
+  while (write_sequence == this->sequence_ && millis() - start < timeout_ms) {
+    delay(1);
+    write_sequence = this->buffer_->get_write_sequence();
+  }
+  return write_sequence;
+}
+
+void FrameReader::skip_overwritten_(uint32_t write_sequence) {
+  const uint32_t behind = write_sequence - this->sequence_;
+  if (behind >= this->buffer_->frame_count_) {
+    const uint32_t skipped = behind - (this->buffer_->frame_count_ - 1);
+    this->overflow_count_ += skipped;
+    this->sequence_ += skipped;
+    this->offset_ = 0;
+  }
+}
+
+bool FrameReader::read(AudioFrame &frame, uint32_t timeout_ms) {
+  const uint32_t write_sequence = this->wait_(timeout_ms);
+  if (write_sequence == this->sequence_)
+    return false;
+  this->skip_overwritten_(write_sequence);
+
+  frame.samples = this->buffer_->get_frame_(this->sequence_);
+  frame.length = this->buffer_->frame_length_;
+  frame.sequence = this->sequence_;
+  frame.timestamp = this->buffer_->timestamps_[this->sequence_ % this->buffer_->frame_count_];
+  this->sequence_++;
+  this->offset_ = 0;
+  return true;
+}
+
+size_t FrameReader::read_samples(int16_t *buf, size_t len, uint32_t timeout_ms) {
+  size_t copied = 0;
+  uint32_t write_sequence = this->wait_(timeout_ms);
+  while (copied < len && write_sequence != this->sequence_) {
+    this->skip_overwritten_(write_sequence);
+    const size_t count = std::min(len - copied, this->buffer_->frame_length_ - this->offset_);
+    memcpy(buf + copied, this->buffer_->get_frame_(this->sequence_) + this->offset_, count * sizeof(int16_t));
+    copied += count;
+    this->offset_ += count;
+    if (this->offset_ == this->buffer_->frame_length_) {
+      this->sequence_++;
+      this->offset_ = 0;
+    }
+    write_sequence = this->buffer_->get_write_sequence();
+  }
+  return copied;
+}
+
+void FrameReader::reset() {
+  this->sequence_ = this->buffer_->get_write_sequence();
+  this->offset_ = 0;
+}
+
+}  // namespace microphone
+}  // namespace esphome
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace microphone {
+
+/// A block of captured samples. The samples point into the FrameBuffer, they are not copied.
+struct AudioFrame {
+  const int16_t *samples;
+  /// Number of samples in the frame.
+  size_t length;
+  /// Increases by one for every captured frame.
+  uint32_t sequence;
+  /// Approximate micros() at which the first sample of the frame was captured.
+  uint32_t timestamp;
+};
+
+/**
+ * @brief Ring of fixed size audio frames with a single writer and any number of readers.
+ *
+ * The writer never waits for the readers: once the ring is full it overwrites the oldest frame, and a reader that
+ * fell behind skips the frames it missed and counts them as overflows.
+ */
+class FrameBuffer {
+ public:
+  FrameBuffer(size_t frame_length, size_t frame_count) : frame_length_(frame_length), frame_count_(frame_count) {}
+  ~FrameBuffer();
+
+  /// Allocate the frames. Returns false if there is not enough memory.
+  bool allocate();
+
+  size_t get_frame_length() const { return this->frame_length_; }
+  size_t get_frame_count() const { return this->frame_count_; }
+
+  /// Frame to be filled in by the writer. Readers can't see it until it is committed.
+  int16_t *get_write_frame() { return this->get_frame_(this->write_sequence_.load(std::memory_order_relaxed)); }
+  /// Publish the frame returned by get_write_frame().
+  void commit_frame(uint32_t timestamp);
+
+  /// Sequence number of the next frame to be committed.
+  uint32_t get_write_sequence() const { return this->write_sequence_.load(std::memory_order_acquire); }
+
+ protected:
+  friend class FrameReader;
+
+  int16_t *get_frame_(uint32_t sequence) const {
+    return this->samples_ + (sequence % this->frame_count_) * this->frame_length_;
+  }
+
+  const size_t frame_length_;
+  const size_t frame_count_;
+  int16_t *samples_{nullptr};
+  uint32_t *timestamps_{nullptr};
+  std::atomic<uint32_t> write_sequence_{0};
+};
+
+/**
+ * @brief Reads the frames of a FrameBuffer from its own position, independently of any other reader.
+ *
+ * A reader must only be used from one task at a time.
+ */
+class FrameReader {
+ public:
+  explicit FrameReader(FrameBuffer *buffer) : buffer_(buffer), sequence_(buffer->get_write_sequence()) {}
+
+  /// Number of complete frames that can be read without waiting.
+  size_t available() const;
+
+  /**
+   * @brief Get the next frame without copying it.
+   *
+   * The frame stays valid until the writer wraps around to it; use is_valid() to check that it was not overwritten
+   * while it was being used.
+   *
+   * @param frame Filled in with the next frame.
+   * @param timeout_ms Maximum time to wait for a frame to be captured.
+   * @return false if no frame was captured in time.
+   */
+  bool read(AudioFrame &frame, uint32_t timeout_ms = 0);
+
+  /// Whether the samples of a frame returned by read() have not been overwritten yet.
+  bool is_valid(const AudioFrame &frame) const {
+    return this->buffer_->get_write_sequence() - frame.sequence < this->buffer_->frame_count_;
+  }
+
+  /**
+   * @brief Copy samples into buf, continuing where the previous call left off in a frame.
+   *
+   * @param buf Buffer to copy the samples into.
+   * @param len Maximum number of samples to copy.
+   * @param timeout_ms Maximum time to wait for a frame if none is available.
+   * @return Number of samples copied.
+   */
+  size_t read_samples(int16_t *buf, size_t len, uint32_t timeout_ms = 0);
+
+  /// Skip everything that was captured so far.
+  void reset();
+
+  /// Number of frames that were overwritten before this reader got to them.
+  uint32_t get_overflow_count() const { return this->overflow_count_; }
+
+ protected:
+  /// Wait until a frame is available. Returns the current write sequence, or sequence_ if none arrived in time.
+  uint32_t wait_(uint32_t timeout_ms) const;
+  /// Move past the frames that are (being) overwritten.
+  void skip_overwritten_(uint32_t write_sequence);
+
+  FrameBuffer *buffer_;
+  /// Sequence number of the next frame to read.
+  uint32_t sequence_;
+  /// Samples of frame sequence_ already copied by read_samples().
+  size_t offset_{0};
+  uint32_t overflow_count_{0};
+};
+
+}  // namespace microphone
+}  // namespace esphome
@@ -3,9 +3,12 @@
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <memory>
 #include <vector>
 #include "esphome/core/helpers.h"
 
+#include "frame_buffer.h"
+
 namespace esphome {
 namespace microphone {
 
@@ -25,6 +28,18 @@ class Microphone {
   }
   virtual size_t read(int16_t *buf, size_t len) = 0;
 
+  /**
+   * @brief Create a reader for the captured frames. Every reader has its own position, so several components can
+   * consume the same audio without copying it or taking data away from each other.
+   *
+   * @return The reader, or nullptr if the microphone does not buffer its frames.
+   */
+  std::unique_ptr<FrameReader> create_reader() {
+    if (this->frame_buffer_ == nullptr)
+      return nullptr;
+    return make_unique<FrameReader>(this->frame_buffer_.get());
+  }
+
   bool is_running() const { return this->state_ == STATE_RUNNING; }
   bool is_stopped() const { return this->state_ == STATE_STOPPED; }
 
@@ -32,6 +47,9 @@ class Microphone {
   State state_{STATE_STOPPED};
 
   CallbackManager<void(const std::vector<int16_t> &)> data_callbacks_{};
+
+  /// Frames captured while running, owned by the microphone for its whole lifetime so readers can't outlive it.
+  std::unique_ptr<FrameBuffer> frame_buffer_{nullptr};
 };
 
 }  // namespace microphone
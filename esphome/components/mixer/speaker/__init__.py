@@ -0,0 +1,92 @@
+from esphome import automation
+import esphome.codegen as cg
+from esphome.components import speaker
+import esphome.config_validation as cv
+from esphome.const import CONF_DURATION, CONF_ID, CONF_NUM_CHANNELS, CONF_SAMPLE_RATE
+
+AUTO_LOAD = ["audio"]
+
+CONF_BUFFER_DURATION = "buffer_duration"
+CONF_DECIBEL_REDUCTION = "decibel_reduction"
+CONF_OUTPUT_SPEAKER = "output_speaker"
+CONF_SOURCE_SPEAKERS = "source_speakers"
+
+mixer_speaker_ns = cg.esphome_ns.namespace("mixer_speaker")
+MixerSpeaker = mixer_speaker_ns.class_("MixerSpeaker", cg.Component)
+SourceSpeaker = mixer_speaker_ns.class_("SourceSpeaker", cg.Component, speaker.Speaker)
+
+DuckingApplyAction = mixer_speaker_ns.class_(
+    "DuckingApplyAction", automation.Action, cg.Parented.template(SourceSpeaker)
+)
+
+
+SOURCE_SPEAKER_SCHEMA = speaker.SPEAKER_SCHEMA.extend(
+    {
+        cv.Required(CONF_ID): cv.declare_id(SourceSpeaker),
+        cv.Optional(
+            CONF_BUFFER_DURATION, default="100ms"
+        ): cv.positive_time_period_milliseconds,
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+CONFIG_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.declare_id(MixerSpeaker),
+            cv.Required(CONF_OUTPUT_SPEAKER): cv.use_id(speaker.Speaker),
+            cv.Required(CONF_SOURCE_SPEAKERS): cv.All(
+                cv.ensure_list(SOURCE_SPEAKER_SCHEMA), cv.Length(min=2, max=8)
+            ),
+            cv.Optional(CONF_NUM_CHANNELS, default=1): cv.int_range(min=1, max=2),
+            cv.Optional(CONF_SAMPLE_RATE, default=16000): cv.int_range(
+                min=8000, max=48000
+            ),
+        }
+    ).extend(cv.COMPONENT_SCHEMA),
+    cv.only_on_esp32,
+)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+
+    output_speaker = await cg.get_variable(config[CONF_OUTPUT_SPEAKER])
+    cg.add(var.set_output_speaker(output_speaker))
+    cg.add(var.set_num_channels(config[CONF_NUM_CHANNELS]))
+    cg.add(var.set_sample_rate(config[CONF_SAMPLE_RATE]))
+
+    for source_config in config[CONF_SOURCE_SPEAKERS]:
+        source = cg.new_Pvariable(source_config[CONF_ID])
+        await cg.register_component(source, source_config)
+        await speaker.register_speaker(source, source_config)
+        cg.add(source.set_parent(var))
+        cg.add(source.set_buffer_duration(source_config[CONF_BUFFER_DURATION]))
+        cg.add(var.add_source_speaker(source))
+
+
+@automation.register_action(
+    "mixer_speaker.apply_ducking",
+    DuckingApplyAction,
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.use_id(SourceSpeaker),
+            cv.Required(CONF_DECIBEL_REDUCTION): cv.templatable(
+                cv.int_range(min=0, max=51)
+            ),
+            cv.Optional(CONF_DURATION, default="0s"): cv.templatable(
+                cv.positive_time_period_milliseconds
+            ),
+        }
+    ),
+)
+async def ducking_apply_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[CONF_ID])
+    decibel_reduction = await cg.templatable(
+        config[CONF_DECIBEL_REDUCTION], args, cg.uint8
+    )
+    cg.add(var.set_decibel_reduction(decibel_reduction))
+    duration = await cg.templatable(config[CONF_DURATION], args, cg.uint32)
+    cg.add(var.set_duration(duration))
+    return var
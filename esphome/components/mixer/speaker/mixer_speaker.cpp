@@ -0,0 +1,356 @@
+#include "mixer_speaker.h"
+
+#ifdef USE_ESP32
+
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace esphome {
+namespace mixer_speaker {
+
+static const size_t MIX_FRAMES = 256;
+static const size_t TASK_DELAY_MS = 10;
+static const size_t TASK_STACK_SIZE = 4096;
+static const ssize_t TASK_PRIORITY = 22;
+static const uint32_t METRICS_INTERVAL_MS = 10000;
+
+static const char *const TAG = "mixer_speaker";
+
+/// @brief Converts one little endian PCM sample to 16 bits. 8 bit samples are unsigned, wider ones are truncated to
+/// their most significant bits.
+static inline int16_t unpack_sample(const uint8_t *data, size_t bytes_per_sample) {
+  switch (bytes_per_sample) {
+    case 1:
+      return static_cast<int16_t>((data[0] - 128) << 8);
+    case 2:
+      return static_cast<int16_t>(encode_uint16(data[1], data[0]));
+    default:
+      return static_cast<int16_t>(encode_uint16(data[bytes_per_sample - 1], data[bytes_per_sample - 2]));
+  }
+}
+
+void SourceSpeaker::dump_config() {
+  ESP_LOGCONFIG(TAG, "Mixer Source Speaker:");
+  ESP_LOGCONFIG(TAG, "  Buffer Duration: %" PRIu32 " ms", this->buffer_duration_ms_);
+}
+
+void SourceSpeaker::loop() {
+  if (this->state_ == speaker::STATE_STOPPING && !this->has_buffered_data()) {
+    this->stop();
+  }
+}
+
+size_t SourceSpeaker::play(const uint8_t *data, size_t length, TickType_t ticks_to_wait) {
+  if (this->state_ == speaker::STATE_STOPPED) {
+    this->start();
+  } else if (this->state_ == speaker::STATE_STOPPING) {
+    // More audio after finish(), keep going
+    this->state_ = speaker::STATE_RUNNING;
+  }
+  if (!this->mixing_) {
+    return 0;
+  }
+  return this->ring_buffer_->write_without_replacement((void *) data, length, ticks_to_wait);
+}
+
+void SourceSpeaker::start() {
+  if (this->state_ == speaker::STATE_RUNNING || this->state_ == speaker::STATE_STOPPING) {
+    return;
+  }
+  const audio::AudioStreamInfo &output_info = this->parent_->get_output_audio_stream_info();
+  const size_t input_frame_size = this->audio_stream_info_.get_bytes_per_sample() * this->audio_stream_info_.channels;
+  if (input_frame_size == 0 || this->audio_stream_info_.sample_rate == 0) {
+    ESP_LOGE(TAG, "Unsupported audio stream");
+    return;
+  }
+
+  {
+    LockGuard lock(this->lock_);
+    const size_t ring_buffer_size = static_cast<uint64_t>(input_frame_size) * this->audio_stream_info_.sample_rate *
+                                    this->buffer_duration_ms_ / 1000;
+    if (this->ring_buffer_ == nullptr || this->ring_buffer_size_ != ring_buffer_size) {
+      this->ring_buffer_.reset();
+      this->ring_buffer_ = RingBuffer::create(ring_buffer_size);
+      if (this->ring_buffer_ == nullptr) {
+        ESP_LOGE(TAG, "Failed to allocate ring buffer of %zu bytes", ring_buffer_size);
+        this->ring_buffer_size_ = 0;
+        return;
+      }
+      this->ring_buffer_size_ = ring_buffer_size;
+    } else {
+      this->ring_buffer_->reset();
+    }
+
+    this->step_ = (static_cast<uint64_t>(this->audio_stream_info_.sample_rate) << 16) / output_info.sample_rate;
+    // Enough input frames to interpolate a whole block of output frames
+    const size_t max_input_frames = ((static_cast<uint64_t>(MIX_FRAMES) * this->step_) >> 16) + 3;
+    this->read_buffer_.resize(max_input_frames * input_frame_size);
+    this->input_.resize(max_input_frames * output_info.channels);
+    this->input_frames_ = 0;
+    this->position_ = 0;
+    this->mixing_ = true;
+  }
+
+  this->state_ = speaker::STATE_RUNNING;
+  this->parent_->start_mixing();
+}
+
+void SourceSpeaker::stop() {
+  if (this->state_ == speaker::STATE_STOPPED) {
+    return;
+  }
+  {
+    LockGuard lock(this->lock_);
+    this->mixing_ = false;
+    this->ring_buffer_->reset();
+    this->input_frames_ = 0;
+    this->position_ = 0;
+  }
+  this->state_ = speaker::STATE_STOPPED;
+}
+
+void SourceSpeaker::finish() {
+  if (this->state_ == speaker::STATE_RUNNING) {
+    this->state_ = speaker::STATE_STOPPING;
+  }
+}
+
+bool SourceSpeaker::has_buffered_data() const {
+  if (this->ring_buffer_ == nullptr)
+    return false;
+  LockGuard lock(this->lock_);
+  // Converted frames that are not mixed yet, the last one is only kept to interpolate towards the next frame
+  return this->ring_buffer_->available() > 0 || this->input_frames_ > (this->position_ >> 16) + 1;
+}
+
+void SourceSpeaker::set_volume(float volume) {
+  this->volume_ = volume;
+  LockGuard lock(this->lock_);
+  this->q15_volume_ = clamp<int32_t>(std::lround(volume * INT16_MAX), 0, INT16_MAX);
+}
+
+void SourceSpeaker::apply_ducking(uint8_t decibel_reduction, uint32_t duration) {
+  LockGuard lock(this->lock_);
+  this->q15_ducking_target_ = std::lround(INT16_MAX * std::pow(10.0f, -decibel_reduction / 20.0f));
+  this->ducking_frames_left_ =
+      static_cast<uint64_t>(duration) * this->parent_->get_output_audio_stream_info().sample_rate / 1000;
+  if (this->ducking_frames_left_ == 0) {
+    this->q15_ducking_ = this->q15_ducking_target_;
+  }
+}
+
+void SourceSpeaker::fill_input_(size_t frames, uint8_t output_channels) {
+  const uint8_t input_channels = this->audio_stream_info_.channels;
+  const size_t bytes_per_sample = this->audio_stream_info_.get_bytes_per_sample();
+  const size_t input_frame_size = bytes_per_sample * input_channels;
+
+  // Only read whole frames
+  frames = std::min(frames, this->ring_buffer_->available() / input_frame_size);
+  frames = std::min(frames, this->input_.size() / output_channels - this->input_frames_);
+  if (frames == 0) {
+    return;
+  }
+  frames = this->ring_buffer_->read(this->read_buffer_.data(), frames * input_frame_size) / input_frame_size;
+
+  const uint8_t *raw = this->read_buffer_.data();
+  int16_t *input = &this->input_[this->input_frames_ * output_channels];
+  for (size_t i = 0; i < frames; i++) {
+    int32_t left = unpack_sample(raw, bytes_per_sample);
+    int32_t right = input_channels > 1 ? unpack_sample(raw + bytes_per_sample, bytes_per_sample) : left;
+    raw += input_frame_size;
+    if (output_channels == 1) {
+      *input++ = (left + right) / 2;
+    } else {
+      *input++ = left;
+      *input++ = right;
+    }
+  }
+  this->input_frames_ += frames;
+}
+
+size_t SourceSpeaker::mix_(int32_t *mix, size_t frames, const audio::AudioStreamInfo &output_info) {
+  const uint32_t start = micros();
+  const uint8_t channels = output_info.channels;
+  size_t mixed = 0;
+  {
+    LockGuard lock(this->lock_);
+    if (!this->mixing_) {
+      return 0;
+    }
+
+    // The last output frame is interpolated between two input frames
+    const size_t needed = ((this->position_ + static_cast<uint64_t>(frames - 1) * this->step_) >> 16) + 2;
+    if (this->input_frames_ < needed) {
+      this->fill_input_(needed - this->input_frames_, channels);
+    }
+
+    if (this->ducking_frames_left_ > 0) {
+      const uint32_t ramp_frames = std::min<uint32_t>(frames, this->ducking_frames_left_);
+      this->q15_ducking_ += (this->q15_ducking_target_ - this->q15_ducking_) * static_cast<int32_t>(ramp_frames) /
+                            static_cast<int32_t>(this->ducking_frames_left_);
+      this->ducking_frames_left_ -= ramp_frames;
+    }
+    const int32_t gain = (this->q15_volume_ * this->q15_ducking_) >> 15;
+
+    // Linear interpolation with a Q15 fraction, which keeps the products within 32 bits
+    for (; mixed < frames; mixed++) {
+      const size_t index = this->position_ >> 16;
+      if (index + 1 >= this->input_frames_) {
+        break;
+      }
+      const int32_t fraction = (this->position_ & 0xFFFF) >> 1;
+      const int16_t *current = &this->input_[index * channels];
+      const int16_t *next = current + channels;
+      for (uint8_t channel = 0; channel < channels; channel++) {
+        int32_t sample = current[channel] + (((next[channel] - current[channel]) * fraction) >> 15);
+        mix[mixed * channels + channel] += (sample * gain) >> 15;
+      }
+      this->position_ += this->step_;
+    }
+
+    // Drop the input frames that were passed, keeping the one the next output frame starts from
+    const size_t consumed = std::min<size_t>(this->position_ >> 16, this->input_frames_);
+    if (consumed > 0) {
+      std::memmove(this->input_.data(), &this->input_[consumed * channels],
+                   (this->input_frames_ - consumed) * channels * sizeof(int16_t));
+      this->input_frames_ -= consumed;
+      this->position_ -= consumed << 16;
+    }
+  }
+  this->cpu_time_us_ += micros() - start;
+  return mixed;
+}
+
+void MixerSpeaker::setup() {
+  if (!this->allocate_buffers_()) {
+    this->mark_failed();
+    return;
+  }
+  this->last_cpu_times_.resize(this->source_speakers_.size());
+}
+
+bool MixerSpeaker::allocate_buffers_() {
+  if (this->mix_buffer_ == nullptr) {
+    ExternalRAMAllocator<int32_t> mix_allocator(ExternalRAMAllocator<int32_t>::ALLOW_FAILURE);
+    this->mix_buffer_ = mix_allocator.allocate(MIX_FRAMES * this->output_info_.channels);
+  }
+  if (this->output_buffer_ == nullptr) {
+    ExternalRAMAllocator<int16_t> output_allocator(ExternalRAMAllocator<int16_t>::ALLOW_FAILURE);
+    this->output_buffer_ = output_allocator.allocate(MIX_FRAMES * this->output_info_.channels);
+  }
+  if (this->mix_buffer_ == nullptr || this->output_buffer_ == nullptr) {
+    ESP_LOGE(TAG, "Failed to allocate mixing buffers");
+    return false;
+  }
+  return true;
+}
+
+void MixerSpeaker::loop() {
+#if ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_VERBOSE
+  const uint32_t now = millis();
+  if (now - this->last_metrics_time_ < METRICS_INTERVAL_MS) {
+    return;
+  }
+  const uint32_t elapsed_us = (now - this->last_metrics_time_) * 1000;
+  this->last_metrics_time_ = now;
+  for (size_t i = 0; i < this->source_speakers_.size(); i++) {
+    const uint32_t cpu_time = this->source_speakers_[i]->get_cpu_time();
+    const uint32_t used = cpu_time - this->last_cpu_times_[i];
+    this->last_cpu_times_[i] = cpu_time;
+    if (used > 0) {
+      ESP_LOGV(TAG, "Source %zu used %.2f%% CPU", i, used * 100.0f / elapsed_us);
+    }
+  }
+#endif
+}
+
+void MixerSpeaker::dump_config() {
+  ESP_LOGCONFIG(TAG, "Mixer Speaker:");
+  ESP_LOGCONFIG(TAG, "  Number of Channels: %u", this->output_info_.channels);
+  ESP_LOGCONFIG(TAG, "  Sample Rate: %" PRIu32 " Hz", this->output_info_.sample_rate);
+  ESP_LOGCONFIG(TAG, "  Sources: %zu", this->source_speakers_.size());
+}
+
+void MixerSpeaker::start_mixing() {
+  if (this->is_failed()) {
+    return;
+  }
+  if (this->task_handle_ == nullptr) {
+    // A source may start before setup(), e.g. from an automation with the same setup priority
+    if (!this->allocate_buffers_()) {
+      return;
+    }
+    xTaskCreate(MixerSpeaker::mix_task, "mixer_task", TASK_STACK_SIZE, (void *) this, TASK_PRIORITY,
+                &this->task_handle_);
+    if (this->task_handle_ == nullptr) {
+      ESP_LOGE(TAG, "Failed to start mixer task");
+    }
+    return;
+  }
+  xTaskNotifyGive(this->task_handle_);
+}
+
+void MixerSpeaker::mix_task(void *params) {
+  MixerSpeaker *this_mixer = (MixerSpeaker *) params;
+  const audio::AudioStreamInfo output_info = this_mixer->output_info_;
+  const size_t channels = output_info.channels;
+  auto is_mixing = [this_mixer]() {
+    return std::any_of(this_mixer->source_speakers_.begin(), this_mixer->source_speakers_.end(),
+                       [](SourceSpeaker *source) { return source->mixing_.load(); });
+  };
+  bool playing = false;
+
+  while (true) {
+    if (!is_mixing()) {
+      if (playing) {
+        this_mixer->output_speaker_->finish();
+        playing = false;
+      }
+      // Sleep until a source starts
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+      continue;
+    }
+    if (!playing) {
+      this_mixer->output_speaker_->set_audio_stream_info(output_info);
+      playing = true;
+    }
+
+    int32_t *mix = this_mixer->mix_buffer_;
+    std::memset(mix, 0, MIX_FRAMES * channels * sizeof(int32_t));
+    size_t frames = 0;
+    for (auto *source : this_mixer->source_speakers_) {
+      frames = std::max(frames, source->mix_(mix, MIX_FRAMES, output_info));
+    }
+    if (frames == 0) {
+      // None of the sources has audio buffered yet
+      vTaskDelay(pdMS_TO_TICKS(TASK_DELAY_MS));
+      continue;
+    }
+
+    int16_t *output = this_mixer->output_buffer_;
+    for (size_t i = 0; i < frames * channels; i++) {
+      output[i] = clamp<int32_t>(mix[i], INT16_MIN, INT16_MAX);
+    }
+
+    // Blocks while the output speaker's buffer is full, which paces the mixing
+    const uint8_t *data = reinterpret_cast<const uint8_t *>(output);
+    size_t bytes_left = frames * channels * sizeof(int16_t);
+    while (bytes_left > 0 && is_mixing()) {
+      size_t written = this_mixer->output_speaker_->play(data, bytes_left, pdMS_TO_TICKS(TASK_DELAY_MS));
+      if (written == 0) {
+        vTaskDelay(pdMS_TO_TICKS(TASK_DELAY_MS));
+      }
+      data += written;
+      bytes_left -= written;
+    }
+  }
+}
+
+}  // namespace mixer_speaker
+}  // namespace esphome
+
+#endif  // USE_ESP32
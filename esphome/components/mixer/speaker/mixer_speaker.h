@@ -0,0 +1,143 @@
+#pragma once
+
+#ifdef USE_ESP32
+
+#include "esphome/components/audio/audio.h"
+#include "esphome/components/speaker/speaker.h"
+
+#include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/ring_buffer.h"
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace esphome {
+namespace mixer_speaker {
+
+class MixerSpeaker;
+
+/// @brief One input of the mixer. Audio played on it is buffered in its own format and converted by the mixer task.
+class SourceSpeaker : public speaker::Speaker, public Component {
+ public:
+  void dump_config() override;
+  void loop() override;
+
+  size_t play(const uint8_t *data, size_t length, TickType_t ticks_to_wait) override;
+  size_t play(const uint8_t *data, size_t length) override { return this->play(data, length, 0); }
+
+  void start() override;
+  void stop() override;
+  /// @brief Stops once the mixer has taken all of the buffered audio.
+  void finish() override;
+
+  bool has_buffered_data() const override;
+
+  /// @brief Sets the gain of this source in the mix.
+  void set_volume(float volume) override;
+
+  /// @brief Reduces the volume of this source, e.g. while an announcement plays on another source.
+  /// @param decibel_reduction How far to reduce the volume. 0 restores the full volume.
+  /// @param duration Time in milliseconds to ramp to the new volume.
+  void apply_ducking(uint8_t decibel_reduction, uint32_t duration);
+
+  void set_buffer_duration(uint32_t buffer_duration_ms) { this->buffer_duration_ms_ = buffer_duration_ms; }
+  void set_parent(MixerSpeaker *parent) { this->parent_ = parent; }
+
+  /// @brief Total time in microseconds the mixer task spent converting and mixing this source.
+  uint32_t get_cpu_time() const { return this->cpu_time_us_; }
+
+ protected:
+  friend class MixerSpeaker;
+
+  /// @brief Called by the mixer task. Converts the buffered audio to the output format and adds it to mix.
+  /// @param mix Output frames to add to.
+  /// @param frames Number of output frames wanted.
+  /// @param output_info Format of the output.
+  /// @return Number of frames mixed, less than frames if the source ran out of audio.
+  size_t mix_(int32_t *mix, size_t frames, const audio::AudioStreamInfo &output_info);
+
+  /// @brief Reads up to frames input frames from the ring buffer, converted to 16 bit samples with the output's number
+  /// of channels, and appends them to input_.
+  void fill_input_(size_t frames, uint8_t output_channels);
+
+  MixerSpeaker *parent_{nullptr};
+
+  std::unique_ptr<RingBuffer> ring_buffer_;
+  size_t ring_buffer_size_{0};
+  uint32_t buffer_duration_ms_;
+
+  /// Guards the ring buffer and the conversion state against the mixer task.
+  mutable Mutex lock_;
+  /// Set while the mixer task should take audio from this source.
+  std::atomic<bool> mixing_{false};
+
+  // Conversion state, set up by start()
+  /// Raw bytes read from the ring buffer.
+  std::vector<uint8_t> read_buffer_;
+  /// Input frames converted to 16 bits and the output's number of channels.
+  std::vector<int16_t> input_;
+  size_t input_frames_{0};
+  /// Q16.16 position of the next output frame, relative to the first frame in input_.
+  uint32_t position_{0};
+  /// Q16.16 number of input frames per output frame.
+  uint32_t step_{1 << 16};
+
+  int32_t q15_volume_{INT16_MAX};
+  int32_t q15_ducking_{INT16_MAX};
+  int32_t q15_ducking_target_{INT16_MAX};
+  /// Output frames left to reach the ducking target.
+  uint32_t ducking_frames_left_{0};
+
+  std::atomic<uint32_t> cpu_time_us_{0};
+};
+
+/// @brief Mixes the source speakers into one stream, written to the output speaker by a single task.
+class MixerSpeaker : public Component {
+ public:
+  void setup() override;
+  void loop() override;
+  void dump_config() override;
+  // Before the automations, which may start playing on a source in on_boot
+  float get_setup_priority() const override { return setup_priority::DATA + 1.0f; }
+
+  void add_source_speaker(SourceSpeaker *source_speaker) { this->source_speakers_.push_back(source_speaker); }
+  void set_output_speaker(speaker::Speaker *speaker) { this->output_speaker_ = speaker; }
+  void set_num_channels(uint8_t num_channels) { this->output_info_.channels = num_channels; }
+  void set_sample_rate(uint32_t sample_rate) { this->output_info_.sample_rate = sample_rate; }
+
+  const audio::AudioStreamInfo &get_output_audio_stream_info() const { return this->output_info_; }
+
+  /// @brief Wakes up the mixer task, starting it if necessary. Called by the sources when they start.
+  void start_mixing();
+
+ protected:
+  /// @brief Allocates the buffers used by the mixer task, if not done yet.
+  /// @return False if they could not be allocated.
+  bool allocate_buffers_();
+
+  /// @brief Function for the FreeRTOS task that mixes the sources and writes the result to the output speaker.
+  /// Sleeps while none of the sources is playing.
+  /// @param params MixerSpeaker component
+  static void mix_task(void *params);
+
+  std::vector<SourceSpeaker *> source_speakers_;
+  speaker::Speaker *output_speaker_{nullptr};
+  audio::AudioStreamInfo output_info_;
+
+  TaskHandle_t task_handle_{nullptr};
+  int32_t *mix_buffer_{nullptr};
+  int16_t *output_buffer_{nullptr};
+
+  uint32_t last_metrics_time_{0};
+  std::vector<uint32_t> last_cpu_times_;
+};
+
+}  // namespace mixer_speaker
+}  // namespace esphome
+
+#endif  // USE_ESP32
@@ -11,6 +11,12 @@ void Modbus::setup() {
   if (this->flow_control_pin_ != nullptr) {
     this->flow_control_pin_->setup();
   }
+  // Modbus RTU frames are separated by at least 3.5 character times (11 bits each) of silence.
+  // Above 19200 baud the spec recommends a fixed 1.75 ms.
+  const uint32_t baud_rate = this->parent_->get_baud_rate();
+  if (baud_rate > 0 && baud_rate <= 19200) {
+    this->frame_delay_us_ = 38500000UL / baud_rate;
+  }
 }
 void Modbus::loop() {
   const uint32_t now = millis();
@@ -21,6 +27,10 @@ void Modbus::loop() {
   }
   // stop blocking new send commands after send_wait_time_ ms regardless if a response has been received since then
   if (now - this->last_send_ > send_wait_time_) {
+    if (waiting_for_response != 0) {
+      this->count_timeout_(waiting_for_response);
+      ESP_LOGV(TAG, "No response from device 0x%02X within %d ms", waiting_for_response, this->send_wait_time_);
+    }
     waiting_for_response = 0;
   }
 
@@ -33,6 +43,12 @@ void Modbus::loop() {
       this->rx_buffer_.clear();
     }
   }
+
+  // Send the next request as soon as the bus is idle instead of waiting for the device loops
+  if (this->role == ModbusRole::CLIENT && waiting_for_response == 0 && this->rx_buffer_.empty() &&
+      micros() - this->last_frame_us_ >= this->frame_delay_us_) {
+    this->dispatch_next_request_();
+  }
 }
 
 bool Modbus::parse_modbus_byte_(uint8_t byte) {
@@ -116,33 +132,13 @@ bool Modbus::parse_modbus_byte_(uint8_t byte) {
       }
     }
   }
+  this->last_frame_us_ = micros();
   std::vector<uint8_t> data(this->rx_buffer_.begin() + data_offset, this->rx_buffer_.begin() + data_offset + data_len);
-  bool found = false;
-  for (auto *device : this->devices_) {
-    if (device->address_ == address) {
-      // Is it an error response?
-      if ((function_code & 0x80) == 0x80) {
-        ESP_LOGD(TAG, "Modbus error function code: 0x%X exception: %d", function_code, raw[2]);
-        if (waiting_for_response != 0) {
-          device->on_modbus_error(function_code & 0x7F, raw[2]);
-        } else {
-          // Ignore modbus exception not related to a pending command
-          ESP_LOGD(TAG, "Ignoring Modbus error - not expecting a response");
-        }
-      } else if (this->role == ModbusRole::SERVER && (function_code == 0x3 || function_code == 0x4)) {
-        device->on_modbus_read_registers(function_code, uint16_t(data[1]) | (uint16_t(data[0]) << 8),
-                                         uint16_t(data[3]) | (uint16_t(data[2]) << 8));
-      } else {
-        device->on_modbus_data(data);
-      }
-      found = true;
-    }
-  }
-  waiting_for_response = 0;
-
-  if (!found) {
-    ESP_LOGW(TAG, "Got Modbus frame from unknown address 0x%02X! ", address);
-  }
+  const bool expected = waiting_for_response != 0 && waiting_for_response == address;
+  this->dispatch_frame_(address, function_code, data, expected, millis() - this->last_send_);
+  // A frame from another address doesn't answer the request, which is left to time out in loop()
+  if (expected)
+    waiting_for_response = 0;
 
   // return false to reset buffer
   return false;
@@ -152,6 +148,7 @@ void Modbus::dump_config() {
   ESP_LOGCONFIG(TAG, "Modbus:");
   LOG_PIN("  Flow Control Pin: ", this->flow_control_pin_);
   ESP_LOGCONFIG(TAG, "  Send Wait Time: %d ms", this->send_wait_time_);
+  ESP_LOGCONFIG(TAG, "  Frame Delay: %" PRIu32 " us", this->frame_delay_us_);
   ESP_LOGCONFIG(TAG, "  CRC Disabled: %s", YESNO(this->disable_crc_));
 }
 float Modbus::get_setup_priority() const {
@@ -161,37 +158,10 @@ float Modbus::get_setup_priority() const {
 
 void Modbus::send(uint8_t address, uint8_t function_code, uint16_t start_address, uint16_t number_of_entities,
                   uint8_t payload_len, const uint8_t *payload) {
-  static const size_t MAX_VALUES = 128;
-
-  // Only check max number of registers for standard function codes
-  // Some devices use non standard codes like 0x43
-  if (number_of_entities > MAX_VALUES && function_code <= 0x10) {
-    ESP_LOGE(TAG, "send too many values %d max=%zu", number_of_entities, MAX_VALUES);
+  std::vector<uint8_t> data =
+      this->build_frame_(address, function_code, start_address, number_of_entities, payload_len, payload);
+  if (data.empty())
     return;
-  }
-
-  std::vector<uint8_t> data;
-  data.push_back(address);
-  data.push_back(function_code);
-  if (this->role == ModbusRole::CLIENT) {
-    data.push_back(start_address >> 8);
-    data.push_back(start_address >> 0);
-    if (function_code != 0x5 && function_code != 0x6) {
-      data.push_back(number_of_entities >> 8);
-      data.push_back(number_of_entities >> 0);
-    }
-  }
-
-  if (payload != nullptr) {
-    if (this->role == ModbusRole::SERVER || function_code == 0xF || function_code == 0x10) {  // Write multiple
-      data.push_back(payload_len);  // Byte count is required for write
-    } else {
-      payload_len = 2;  // Write single register or coil
-    }
-    for (int i = 0; i < payload_len; i++) {
-      data.push_back(payload[i]);
-    }
-  }
 
   auto crc = crc16(data.data(), data.size());
   data.push_back(crc >> 0);
@@ -205,6 +175,7 @@ void Modbus::send(uint8_t address, uint8_t function_code, uint16_t start_address
 
   if (this->flow_control_pin_ != nullptr)
     this->flow_control_pin_->digital_write(false);
+  this->last_frame_us_ = micros();
   waiting_for_response = address;
   last_send_ = millis();
   ESP_LOGV(TAG, "Modbus write: %s", format_hex_pretty(data).c_str());
@@ -227,6 +198,7 @@ void Modbus::send_raw(const std::vector<uint8_t> &payload) {
   this->flush();
   if (this->flow_control_pin_ != nullptr)
     this->flow_control_pin_->digital_write(false);
+  this->last_frame_us_ = micros();
   waiting_for_response = payload[0];
   ESP_LOGV(TAG, "Modbus write raw: %s", format_hex_pretty(payload).c_str());
   last_send_ = millis();
@@ -2,7 +2,7 @@ import binascii
 
 from esphome import automation
 import esphome.codegen as cg
-from esphome.components import modbus
+from esphome.components import modbus_hub
 import esphome.config_validation as cv
 from esphome.const import (
     CONF_ADDRESS,
@@ -22,6 +22,7 @@ from .const import (
     CONF_CUSTOM_COMMAND,
     CONF_FORCE_NEW_RANGE,
     CONF_MAX_CMD_RETRIES,
+    CONF_MAX_REGISTER_GAP,
     CONF_MODBUS_CONTROLLER_ID,
     CONF_OFFLINE_SKIP_UPDATES,
     CONF_ON_COMMAND_SENT,
@@ -34,7 +35,7 @@ from .const import (
 
 CODEOWNERS = ["@martgras"]
 
-AUTO_LOAD = ["modbus"]
+AUTO_LOAD = ["modbus_hub"]
 
 CONF_READ_LAMBDA = "read_lambda"
 CONF_SERVER_REGISTERS = "server_registers"
@@ -42,7 +43,7 @@ MULTI_CONF = True
 
 modbus_controller_ns = cg.esphome_ns.namespace("modbus_controller")
 ModbusController = modbus_controller_ns.class_(
-    "ModbusController", cg.PollingComponent, modbus.ModbusDevice
+    "ModbusController", cg.PollingComponent, modbus_hub.ModbusDevice
 )
 
 SensorItem = modbus_controller_ns.struct("SensorItem")
@@ -136,6 +137,9 @@ CONFIG_SCHEMA = cv.All(
             ): cv.positive_time_period_milliseconds,
             cv.Optional(CONF_MAX_CMD_RETRIES, default=4): cv.positive_int,
             cv.Optional(CONF_OFFLINE_SKIP_UPDATES, default=0): cv.positive_int,
+            cv.Optional(CONF_MAX_REGISTER_GAP, default=0): cv.int_range(
+                min=0, max=124
+            ),
             cv.Optional(
                 CONF_SERVER_REGISTERS,
             ): cv.ensure_list(ModbusServerRegisterSchema),
@@ -149,7 +153,7 @@ CONFIG_SCHEMA = cv.All(
         }
     )
     .extend(cv.polling_component_schema("60s"))
-    .extend(modbus.modbus_device_schema(0x01))
+    .extend(modbus_hub.modbus_device_schema(0x01))
 )
 
 ModbusItemBaseSchema = cv.Schema(
@@ -195,9 +199,9 @@ def validate_modbus_register(config):
 
 def _final_validate(config):
     if CONF_SERVER_REGISTERS in config:
-        return modbus.final_validate_modbus_device("modbus_controller", role="server")(
-            config
-        )
+        return modbus_hub.final_validate_modbus_device(
+            "modbus_controller", role="server"
+        )(config)
     return config
 
 
@@ -263,6 +267,7 @@ async def to_code(config):
     cg.add(var.set_command_throttle(config[CONF_COMMAND_THROTTLE]))
     cg.add(var.set_max_cmd_retries(config[CONF_MAX_CMD_RETRIES]))
     cg.add(var.set_offline_skip_updates(config[CONF_OFFLINE_SKIP_UPDATES]))
+    cg.add(var.set_max_register_gap(config[CONF_MAX_REGISTER_GAP]))
     if CONF_SERVER_REGISTERS in config:
         for server_register in config[CONF_SERVER_REGISTERS]:
             cg.add(
@@ -291,7 +296,7 @@ async def to_code(config):
 async def register_modbus_device(var, config):
     cg.add(var.set_address(config[CONF_ADDRESS]))
     await cg.register_component(var, config)
-    return await modbus.register_modbus_device(var, config)
+    return await modbus_hub.register_modbus_device(var, config)
 
 
 def function_code_to_register(function_code):
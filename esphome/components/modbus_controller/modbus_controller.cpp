@@ -6,15 +6,24 @@ namespace esphome {
 namespace modbus_controller {
 
 static const char *const TAG = "modbus_controller";
+/// Largest range created by merging over unused registers (max registers of a single read request)
+static const uint16_t MAX_GAP_RANGE_REGISTERS = 125;
 
 void ModbusController::setup() { this->create_register_ranges_(); }
 
 /*
  To work with the existing modbus class and avoid polling for responses a command queue is used.
- send_next_command will submit the command at the top of the queue and set the corresponding callback
- to handle the response from the device.
+ The modbus bus schedules the devices sharing it by the deadline of the command at the top of their queue and
+ calls send_next_command to submit it and set the corresponding callback to handle the response from the device.
  Once the response has been processed it is removed from the queue and the next command is sent
 */
+bool ModbusController::get_next_request_deadline(uint32_t &deadline) {
+  if (this->command_queue_.empty() || millis() - this->last_command_timestamp_ <= this->command_throttle_)
+    return false;
+  deadline = this->command_queue_.front()->deadline;
+  return true;
+}
+
 bool ModbusController::send_next_command_() {
   uint32_t last_send = millis() - this->last_command_timestamp_;
 
@@ -46,18 +55,23 @@ bool ModbusController::send_next_command_() {
 
       this->command_sent_callback_.call((int) command->function_code, command->register_address);
 
-      // remove from queue if no handler is defined
-      if (!command->on_data_func) {
-        this->command_queue_.pop_front();
-      }
+      // wait for the response, the bus may send the next commands before it arrives
+      this->in_flight_queue_.push_back(std::move(command));
+      this->command_queue_.pop_front();
+      return true;
     }
   }
-  return (!this->command_queue_.empty());
+  return false;
 }
 
 // Queue incoming response
 void ModbusController::on_modbus_data(const std::vector<uint8_t> &data) {
-  auto &current_command = this->command_queue_.front();
+  // responses arrive in the order of the commands, see ModbusDevice::on_modbus_timeout
+  if (this->in_flight_queue_.empty()) {
+    ESP_LOGV(TAG, "Modbus response without a command waiting for it");
+    return;
+  }
+  auto &current_command = this->in_flight_queue_.front();
   if (current_command != nullptr) {
     if (this->module_offline_) {
       ESP_LOGW(TAG, "Modbus device=%d back online", this->address_);
@@ -71,12 +85,14 @@ void ModbusController::on_modbus_data(const std::vector<uint8_t> &data) {
     }
     this->module_offline_ = false;
 
-    // Move the commandItem to the response queue
-    current_command->payload = data;
-    this->incoming_queue_.push(std::move(current_command));
-    ESP_LOGV(TAG, "Modbus response queued");
-    this->command_queue_.pop_front();
+    // Move the commandItem to the response queue, commands without handler only needed the acknowledgement
+    if (current_command->on_data_func) {
+      current_command->payload = data;
+      this->incoming_queue_.push(std::move(current_command));
+      ESP_LOGV(TAG, "Modbus response queued");
+    }
   }
+  this->in_flight_queue_.pop_front();
 }
 
 // Dispatch the response to the registered handler
@@ -89,7 +105,9 @@ void ModbusController::process_modbus_data_(const ModbusCommandItem *response) {
 void ModbusController::on_modbus_error(uint8_t function_code, uint8_t exception_code) {
   ESP_LOGE(TAG, "Modbus error function code: 0x%X exception: %d ", function_code, exception_code);
   // Remove pending command waiting for a response
-  auto &current_command = this->command_queue_.front();
+  if (this->in_flight_queue_.empty())
+    return;
+  auto &current_command = this->in_flight_queue_.front();
   if (current_command != nullptr) {
     ESP_LOGE(TAG,
              "Modbus error - last command: function code=0x%X  register address = 0x%X  "
@@ -97,8 +115,16 @@ void ModbusController::on_modbus_error(uint8_t function_code, uint8_t exception_
              "payload size=%zu",
              function_code, current_command->register_address, current_command->register_count,
              current_command->payload.size());
-    this->command_queue_.pop_front();
   }
+  this->in_flight_queue_.pop_front();
+}
+
+void ModbusController::on_modbus_timeout() {
+  if (this->in_flight_queue_.empty())
+    return;
+  // Send it again first, send_next_command_ drops it after max_cmd_retries
+  this->command_queue_.push_front(std::move(this->in_flight_queue_.front()));
+  this->in_flight_queue_.pop_front();
 }
 
 void ModbusController::on_modbus_read_registers(uint8_t function_code, uint16_t start_address,
@@ -176,6 +202,7 @@ void ModbusController::queue_command(const ModbusCommandItem &command) {
   if (!this->allow_duplicate_commands_) {
     // check if this command is already qeued.
     // not very effective but the queue is never really large
+    // commands waiting for their response are not checked, a newer payload has to be sent again
     for (auto &item : this->command_queue_) {
       if (item->is_equal(command)) {
         ESP_LOGW(TAG, "Duplicate modbus command found: type=0x%x address=%u count=%u",
@@ -187,7 +214,10 @@ void ModbusController::queue_command(const ModbusCommandItem &command) {
       }
     }
   }
-  this->command_queue_.push_back(make_unique<ModbusCommandItem>(command));
+  auto item = make_unique<ModbusCommandItem>(command);
+  if (item->deadline == 0)
+    item->deadline = millis();
+  this->command_queue_.push_back(std::move(item));
 }
 
 void ModbusController::update_range_(RegisterRange &r) {
@@ -210,7 +240,12 @@ void ModbusController::update_range_(RegisterRange &r) {
         queue_command(command_item);
       }
     } else {
-      queue_command(ModbusCommandItem::create_read_command(this, r.register_type, r.start_address, r.register_count));
+      auto command_item =
+          ModbusCommandItem::create_read_command(this, r.register_type, r.start_address, r.register_count);
+      // polled reads are due before the next update, commands queued by writes go first
+      if (this->get_update_interval() != SCHEDULER_DONT_RUN)
+        command_item.deadline = millis() + this->get_update_interval();
+      queue_command(command_item);
     }
     r.skip_updates_counter = r.skip_updates;  // reset counter to config value
   } else {
@@ -302,6 +337,34 @@ size_t ModbusController::create_register_ranges_() {
 
           ESP_LOGV(TAG, "Extend range - change to register: 0x%X %d offset=%u", curr->start_address,
                    curr->register_count, curr->offset);
+        } else if (curr->start_address > (r.start_address + r.register_count) &&
+                   curr->start_address - (r.start_address + r.register_count) <= this->max_register_gap_ &&
+                   curr->start_address + curr->register_count - r.start_address <= MAX_GAP_RANGE_REGISTERS &&
+                   curr->response_bytes == 0 && prev->response_bytes == 0) {
+          // this register is close enough to read the unused registers in between instead of sending another
+          // command
+          uint16_t gap = curr->start_address - (r.start_address + r.register_count);
+
+          // remove this sensore because start_address is changed (sort-order)
+          ix = sensorset_.erase(ix);
+
+          curr->start_address = r.start_address;
+          if (curr->register_type == ModbusRegisterType::COIL ||
+              curr->register_type == ModbusRegisterType::DISCRETE_INPUT) {
+            buffer_offset += gap;
+          } else {
+            buffer_offset += gap * 2;
+          }
+          curr->offset += buffer_offset;
+          buffer_offset += curr->get_register_size();
+          r.register_count += gap + curr->register_count;
+
+          sensorset_.insert(curr);
+          // move iterator backwards because it will be incremented later
+          ix--;
+
+          ESP_LOGV(TAG, "Merge range over %u unused registers - change to register: 0x%X %d offset=%u", gap,
+                   curr->start_address, curr->register_count, curr->offset);
         }
       }
     }
@@ -346,6 +409,9 @@ void ModbusController::dump_config() {
   ESP_LOGCONFIG(TAG, "  Address: 0x%02X", this->address_);
   ESP_LOGCONFIG(TAG, "  Max Command Retries: %d", this->max_cmd_retries_);
   ESP_LOGCONFIG(TAG, "  Offline Skip Updates: %d", this->offline_skip_updates_);
+  ESP_LOGCONFIG(TAG, "  Max Register Gap: %d", this->max_register_gap_);
+  ESP_LOGCONFIG(TAG, "  Responses: %" PRIu32 ", Timeouts: %" PRIu32 ", Max Round Trip Time: %" PRIu32 " ms",
+                this->response_count_, this->timeout_count_, this->max_round_trip_time_);
 #if ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_VERBOSE
   ESP_LOGCONFIG(TAG, "sensormap");
   for (auto &it : sensorset_) {
@@ -373,11 +439,8 @@ void ModbusController::loop() {
     if (message != nullptr)
       process_modbus_data_(message.get());
     incoming_queue_.pop();
-
-  } else {
-    // all messages processed send pending commands
-    send_next_command_();
   }
+  // pending commands are sent by the modbus bus scheduler, see Modbus::dispatch_next_request_
 }
 
 void ModbusController::on_write_register_response(ModbusRegisterType register_type, uint16_t start_address,
@@ -2,7 +2,7 @@
 
 #include "esphome/core/component.h"
 
-#include "esphome/components/modbus/modbus.h"
+#include "esphome/components/modbus_hub/modbus_hub.h"
 #include "esphome/core/automation.h"
 
 #include <list>
@@ -320,6 +320,8 @@ class ModbusCommandItem {
   std::function<void(ModbusRegisterType register_type, uint16_t start_address, const std::vector<uint8_t> &data)>
       on_data_func;
   std::vector<uint8_t> payload = {};
+  /// millis() timestamp by which the bus scheduler should send this command, 0 means as soon as possible
+  uint32_t deadline{0};
   bool send();
   /// Check if the command should be retried based on the max_retries parameter
   bool should_retry(uint8_t max_retries) { return this->send_count_ <= max_retries; };
@@ -444,8 +446,14 @@ class ModbusController : public PollingComponent, public modbus::ModbusDevice {
   void on_modbus_data(const std::vector<uint8_t> &data) override;
   /// called when a modbus error response was received
   void on_modbus_error(uint8_t function_code, uint8_t exception_code) override;
+  /// called when the oldest command waiting for a response wasn't answered
+  void on_modbus_timeout() override;
   /// called when a modbus request (function code 3 or 4) was parsed without errors
   void on_modbus_read_registers(uint8_t function_code, uint16_t start_address, uint16_t number_of_registers) final;
+  /// called by the modbus bus scheduler to get the deadline of the command at the front of the queue
+  bool get_next_request_deadline(uint32_t &deadline) override;
+  /// called by the modbus bus scheduler when this device may use the bus
+  bool send_next_request() override { return this->send_next_command_(); }
   /// default delegate called by process_modbus_data when a response has retrieved from the incoming queue
   void on_register_data(ModbusRegisterType register_type, uint16_t start_address, const std::vector<uint8_t> &data);
   /// default delegate called by process_modbus_data when a response for a write response has retrieved from the
@@ -460,6 +468,8 @@ class ModbusController : public PollingComponent, public modbus::ModbusDevice {
   bool get_allow_duplicate_commands() { return this->allow_duplicate_commands_; }
   /// called by esphome generated code to set the command_throttle period
   void set_command_throttle(uint16_t command_throttle) { this->command_throttle_ = command_throttle; }
+  /// called by esphome generated code to set the max number of unused registers read to merge two ranges
+  void set_max_register_gap(uint16_t max_register_gap) { this->max_register_gap_ = max_register_gap; }
   /// called by esphome generated code to set the offline_skip_updates
   void set_offline_skip_updates(uint16_t offline_skip_updates) { this->offline_skip_updates_ = offline_skip_updates; }
   /// get the number of queued modbus commands (should be mostly empty)
@@ -482,7 +492,7 @@ class ModbusController : public PollingComponent, public modbus::ModbusDevice {
   void update_range_(RegisterRange &r);
   /// parse incoming modbus data
   void process_modbus_data_(const ModbusCommandItem *response);
-  /// send the next modbus command from the send queue
+  /// send the next modbus command from the send queue, returns true if a command was sent
   bool send_next_command_();
   /// dump the parsed sensormap for diagnostics
   void dump_sensors_();
@@ -494,6 +504,8 @@ class ModbusController : public PollingComponent, public modbus::ModbusDevice {
   std::vector<RegisterRange> register_ranges_;
   /// Hold the pending requests to be sent
   std::list<std::unique_ptr<ModbusCommandItem>> command_queue_;
+  /// Sent requests waiting for their response, in the order they were sent
+  std::list<std::unique_ptr<ModbusCommandItem>> in_flight_queue_;
   /// modbus response data waiting to get processed
   std::queue<std::unique_ptr<ModbusCommandItem>> incoming_queue_;
   /// if duplicate commands can be sent
@@ -508,6 +520,8 @@ class ModbusController : public PollingComponent, public modbus::ModbusDevice {
   uint16_t offline_skip_updates_;
   /// How many times we will retry a command if we get no response
   uint8_t max_cmd_retries_{4};
+  /// max number of unused registers that are read to merge two adjacent ranges
+  uint16_t max_register_gap_{0};
   CallbackManager<void(int, int)> command_sent_callback_{};
 };
 
@@ -0,0 +1,70 @@
+from __future__ import annotations
+from typing import Literal
+
+import esphome.codegen as cg
+import esphome.config_validation as cv
+import esphome.final_validate as fv
+from esphome.const import CONF_ADDRESS
+from esphome.core import CORE
+
+
+def AUTO_LOAD():
+    # Devices get a bus on the only UART, unless a Modbus TCP connection is configured
+    if "modbus_tcp" in CORE.raw_config:
+        return []
+    return ["modbus"]
+
+
+modbus_ns = cg.esphome_ns.namespace("modbus")
+ModbusHub = modbus_ns.class_("ModbusHub", cg.Component)
+ModbusDevice = modbus_ns.class_("ModbusDevice")
+
+CONF_ROLE = "role"
+CONF_MODBUS_ID = "modbus_id"
+CONF_SEND_WAIT_TIME = "send_wait_time"
+
+ModbusRole = modbus_ns.enum("ModbusRole")
+MODBUS_ROLES = {
+    "client": ModbusRole.CLIENT,
+    "server": ModbusRole.SERVER,
+}
+
+
+def modbus_device_schema(default_address):
+    schema = {
+        cv.GenerateID(CONF_MODBUS_ID): cv.use_id(ModbusHub),
+    }
+    if default_address is None:
+        schema[cv.Required(CONF_ADDRESS)] = cv.hex_uint8_t
+    else:
+        schema[cv.Optional(CONF_ADDRESS, default=default_address)] = cv.hex_uint8_t
+    return cv.Schema(schema)
+
+
+def final_validate_modbus_device(
+    name: str, *, role: Literal["server", "client"] | None = None
+):
+    def validate_role(value):
+        assert role in MODBUS_ROLES
+        if value != role:
+            raise cv.Invalid(f"Component {name} requires role to be {role}")
+        return value
+
+    def validate_hub(hub_config):
+        hub_schema = {}
+        if role is not None:
+            hub_schema[cv.Required(CONF_ROLE)] = validate_role
+
+        return cv.Schema(hub_schema, extra=cv.ALLOW_EXTRA)(hub_config)
+
+    return cv.Schema(
+        {cv.Required(CONF_MODBUS_ID): fv.id_declaration_match_schema(validate_hub)},
+        extra=cv.ALLOW_EXTRA,
+    )
+
+
+async def register_modbus_device(var, config):
+    parent = await cg.get_variable(config[CONF_MODBUS_ID])
+    cg.add(var.set_parent(parent))
+    cg.add(var.set_address(config[CONF_ADDRESS]))
+    cg.add(parent.register_device(var))
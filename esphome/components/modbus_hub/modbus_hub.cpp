@@ -0,0 +1,111 @@
+#include "modbus_hub.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+#include "esphome/core/helpers.h"
+
+#include <algorithm>
+
+namespace esphome {
+namespace modbus {
+
+static const char *const TAG = "modbus";
+
+void ModbusHub::count_timeout_(uint8_t address) {
+  for (auto *device : this->devices_) {
+    if (device->address_ == address) {
+      device->timeout_count_++;
+      device->on_modbus_timeout();
+    }
+  }
+}
+
+bool ModbusHub::dispatch_next_request_() {
+  const uint32_t now = millis();
+  ModbusDevice *next = nullptr;
+  int32_t next_remaining = 0;
+  for (auto *device : this->devices_) {
+    uint32_t deadline;
+    if (this->is_waiting_for_response(device->address_) || !device->get_next_request_deadline(deadline))
+      continue;
+    // signed difference keeps the ordering correct across a millis() rollover
+    auto remaining = static_cast<int32_t>(deadline - now);
+    if (next == nullptr || remaining < next_remaining) {
+      next = device;
+      next_remaining = remaining;
+    }
+  }
+  return next != nullptr && next->send_next_request();
+}
+
+void ModbusHub::dispatch_frame_(uint8_t address, uint8_t function_code, const std::vector<uint8_t> &data, bool expected,
+                                uint32_t round_trip_time) {
+  bool found = false;
+  for (auto *device : this->devices_) {
+    if (device->address_ == address) {
+      if (expected) {
+        device->last_round_trip_time_ = round_trip_time;
+        device->max_round_trip_time_ = std::max(device->max_round_trip_time_, round_trip_time);
+        device->response_count_++;
+      }
+      // Is it an error response?
+      if ((function_code & 0x80) == 0x80) {
+        ESP_LOGD(TAG, "Modbus error function code: 0x%X exception: %d", function_code, data[0]);
+        if (expected) {
+          device->on_modbus_error(function_code & 0x7F, data[0]);
+        } else {
+          // Ignore modbus exception not related to a pending command
+          ESP_LOGD(TAG, "Ignoring Modbus error - not expecting a response");
+        }
+      } else if (this->role == ModbusRole::SERVER && (function_code == 0x3 || function_code == 0x4)) {
+        device->on_modbus_read_registers(function_code, uint16_t(data[1]) | (uint16_t(data[0]) << 8),
+                                         uint16_t(data[3]) | (uint16_t(data[2]) << 8));
+      } else {
+        device->on_modbus_data(data);
+      }
+      found = true;
+    }
+  }
+
+  if (!found) {
+    ESP_LOGW(TAG, "Got Modbus frame from unknown address 0x%02X! ", address);
+  }
+}
+
+std::vector<uint8_t> ModbusHub::build_frame_(uint8_t address, uint8_t function_code, uint16_t start_address,
+                                             uint16_t number_of_entities, uint8_t payload_len, const uint8_t *payload) {
+  static const size_t MAX_VALUES = 128;
+
+  // Only check max number of registers for standard function codes
+  // Some devices use non standard codes like 0x43
+  if (number_of_entities > MAX_VALUES && function_code <= 0x10) {
+    ESP_LOGE(TAG, "send too many values %d max=%zu", number_of_entities, MAX_VALUES);
+    return {};
+  }
+
+  std::vector<uint8_t> data;
+  data.push_back(address);
+  data.push_back(function_code);
+  if (this->role == ModbusRole::CLIENT) {
+    data.push_back(start_address >> 8);
+    data.push_back(start_address >> 0);
+    if (function_code != 0x5 && function_code != 0x6) {
+      data.push_back(number_of_entities >> 8);
+      data.push_back(number_of_entities >> 0);
+    }
+  }
+
+  if (payload != nullptr) {
+    if (this->role == ModbusRole::SERVER || function_code == 0xF || function_code == 0x10) {  // Write multiple
+      data.push_back(payload_len);  // Byte count is required for write
+    } else {
+      payload_len = 2;  // Write single register or coil
+    }
+    for (int i = 0; i < payload_len; i++) {
+      data.push_back(payload[i]);
+    }
+  }
+  return data;
+}
+
+}  // namespace modbus
+}  // namespace esphome
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "esphome/core/component.h"
+
+#include <vector>
+
+namespace esphome {
+namespace modbus {
+
+enum ModbusRole {
+  CLIENT,
+  SERVER,
+};
+
+class ModbusDevice;
+
+/** Transport independent part of a Modbus bus: the devices on it, the scheduling of their requests and the dispatch
+ * of the responses. Transports (RTU over UART, TCP) implement sending and tracking the requests in flight.
+ */
+class ModbusHub : public Component {
+ public:
+  void register_device(ModbusDevice *device) { this->devices_.push_back(device); }
+
+  virtual void send(uint8_t address, uint8_t function_code, uint16_t start_address, uint16_t number_of_entities,
+                    uint8_t payload_len = 0, const uint8_t *payload = nullptr) = 0;
+  virtual void send_raw(const std::vector<uint8_t> &payload) = 0;
+  /// Returns true if the device with this address can't take another request until a response arrives
+  virtual bool is_waiting_for_response(uint8_t address) = 0;
+  void set_role(ModbusRole role) { this->role = role; }
+  void set_send_wait_time(uint16_t time_in_ms) { send_wait_time_ = time_in_ms; }
+
+  ModbusRole role{ModbusRole::CLIENT};
+
+ protected:
+  /// Build a frame (address, function code and data) without checksum
+  std::vector<uint8_t> build_frame_(uint8_t address, uint8_t function_code, uint16_t start_address,
+                                    uint16_t number_of_entities, uint8_t payload_len, const uint8_t *payload);
+  /// Pass the data of a received frame to the devices registered for its address
+  void dispatch_frame_(uint8_t address, uint8_t function_code, const std::vector<uint8_t> &data, bool expected,
+                       uint32_t round_trip_time);
+  /// Tell the device(s) with this address that the oldest request to them wasn't answered
+  void count_timeout_(uint8_t address);
+  /// Send the next request of the idle device with the earliest deadline, returns true if a request was sent
+  bool dispatch_next_request_();
+  uint16_t send_wait_time_{250};
+  uint32_t last_send_{0};
+  std::vector<ModbusDevice *> devices_;
+};
+
+class ModbusDevice {
+ public:
+  void set_parent(ModbusHub *parent) { parent_ = parent; }
+  void set_address(uint8_t address) { address_ = address; }
+  virtual void on_modbus_data(const std::vector<uint8_t> &data) = 0;
+  virtual void on_modbus_error(uint8_t function_code, uint8_t exception_code) {}
+  /// Called when the oldest request sent to this device wasn't answered within the send wait time
+  virtual void on_modbus_timeout() {}
+  virtual void on_modbus_read_registers(uint8_t function_code, uint16_t start_address, uint16_t number_of_registers){};
+  void send(uint8_t function, uint16_t start_address, uint16_t number_of_entities, uint8_t payload_len = 0,
+            const uint8_t *payload = nullptr) {
+    this->parent_->send(this->address_, function, start_address, number_of_entities, payload_len, payload);
+  }
+  void send_raw(const std::vector<uint8_t> &payload) { this->parent_->send_raw(payload); }
+  // If more than one device is connected block sending a new command before a response is received
+  bool waiting_for_response() { return parent_->is_waiting_for_response(this->address_); }
+
+  /** Bus scheduler hook: devices that queue their own requests report the deadline of the next one.
+   *
+   * The bus calls this whenever it is idle and sends the request of the device with the earliest deadline
+   * through send_next_request(). Devices that send directly from update() don't need to override this.
+   *
+   * @param deadline set to the millis() timestamp by which the next request should be sent
+   * @return true if a request is ready to be sent
+   */
+  virtual bool get_next_request_deadline(uint32_t &deadline) { return false; }
+  /// Called by the bus scheduler to send the next request. Returns true if a frame was sent.
+  virtual bool send_next_request() { return false; }
+
+  /// Round trip time of the last response in ms
+  uint32_t get_last_round_trip_time() const { return this->last_round_trip_time_; }
+  /// Largest round trip time seen since boot in ms
+  uint32_t get_max_round_trip_time() const { return this->max_round_trip_time_; }
+  /// Number of responses received since boot
+  uint32_t get_response_count() const { return this->response_count_; }
+  /// Number of requests that were not answered within send_wait_time
+  uint32_t get_timeout_count() const { return this->timeout_count_; }
+
+ protected:
+  friend ModbusHub;
+
+  ModbusHub *parent_;
+  uint8_t address_;
+  uint32_t last_round_trip_time_{0};
+  uint32_t max_round_trip_time_{0};
+  uint32_t response_count_{0};
+  uint32_t timeout_count_{0};
+};
+
+}  // namespace modbus
+}  // namespace esphome
@@ -0,0 +1,42 @@
+import esphome.codegen as cg
+from esphome.components import modbus_hub
+import esphome.config_validation as cv
+from esphome.const import CONF_ID, CONF_IP_ADDRESS, CONF_PORT
+
+DEPENDENCIES = ["network"]
+AUTO_LOAD = ["modbus_hub", "socket"]
+MULTI_CONF = True
+
+CONF_MAX_DEVICE_TRANSACTIONS = "max_device_transactions"
+CONF_MAX_TRANSACTIONS = "max_transactions"
+
+modbus_tcp_ns = cg.esphome_ns.namespace("modbus_tcp")
+ModbusTCP = modbus_tcp_ns.class_("ModbusTCP", modbus_hub.ModbusHub)
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(ModbusTCP),
+        cv.Required(CONF_IP_ADDRESS): cv.ipv4,
+        cv.Optional(CONF_PORT, default=502): cv.port,
+        cv.Optional(
+            modbus_hub.CONF_SEND_WAIT_TIME, default="1s"
+        ): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_MAX_TRANSACTIONS, default=4): cv.int_range(min=1, max=16),
+        # Requests to one device in flight at the same time, if the server supports it
+        cv.Optional(CONF_MAX_DEVICE_TRANSACTIONS, default=1): cv.int_range(
+            min=1, max=16
+        ),
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+
+async def to_code(config):
+    cg.add_global(modbus_hub.modbus_ns.using)
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+
+    cg.add(var.set_ip_address(str(config[CONF_IP_ADDRESS])))
+    cg.add(var.set_port(config[CONF_PORT]))
+    cg.add(var.set_send_wait_time(config[modbus_hub.CONF_SEND_WAIT_TIME]))
+    cg.add(var.set_max_transactions(config[CONF_MAX_TRANSACTIONS]))
+    cg.add(var.set_max_device_transactions(config[CONF_MAX_DEVICE_TRANSACTIONS]))
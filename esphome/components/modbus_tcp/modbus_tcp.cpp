@@ -0,0 +1,262 @@
+#include "modbus_tcp.h"
+#include "esphome/core/log.h"
+#include "esphome/core/helpers.h"
+#include "esphome/components/network/util.h"
+
+#include <algorithm>
+#include <cerrno>
+
+namespace esphome {
+namespace modbus_tcp {
+
+static const char *const TAG = "modbus_tcp";
+
+/// MBAP header: transaction id, protocol id, length
+static const size_t MBAP_HEADER_SIZE = 6;
+/// Unit id and PDU of the largest Modbus frame
+static const uint16_t MAX_FRAME_SIZE = 254;
+static const uint32_t CONNECT_TIMEOUT = 5000;
+static const uint32_t RECONNECT_INTERVAL = 1000;
+
+void ModbusTCP::setup() {}
+
+void ModbusTCP::loop() {
+  if (this->state_ == ConnectionState::DISCONNECTED) {
+    if (network::is_connected() && millis() - this->connect_started_ > RECONNECT_INTERVAL)
+      this->connect_();
+    return;
+  }
+
+  if (this->state_ == ConnectionState::CONNECTING) {
+    struct sockaddr_storage peer;
+    socklen_t len = sizeof(peer);
+    if (this->socket_->getpeername((struct sockaddr *) &peer, &len) == 0) {
+      ESP_LOGD(TAG, "Connected to %s:%u", this->ip_address_.c_str(), this->port_);
+      this->state_ = ConnectionState::CONNECTED;
+    } else if (millis() - this->connect_started_ > CONNECT_TIMEOUT) {
+      ESP_LOGW(TAG, "Connecting to %s:%u timed out", this->ip_address_.c_str(), this->port_);
+      this->disconnect_();
+    }
+    return;
+  }
+
+  this->read_frames_();
+  this->check_timeouts_();
+
+  // keep up to max_transactions_ requests to different devices outstanding on the connection
+  while (this->state_ == ConnectionState::CONNECTED && this->transactions_.size() < this->max_transactions_ &&
+         this->dispatch_next_request_()) {
+  }
+}
+
+void ModbusTCP::connect_() {
+  this->connect_started_ = millis();
+
+  struct sockaddr_storage server;
+  socklen_t sl = socket::set_sockaddr((struct sockaddr *) &server, sizeof(server), this->ip_address_, this->port_);
+  if (sl == 0) {
+    ESP_LOGW(TAG, "Unable to set sockaddr: errno %d", errno);
+    return;
+  }
+  this->socket_ = socket::socket(server.ss_family, SOCK_STREAM, 0);
+  if (this->socket_ == nullptr) {
+    ESP_LOGW(TAG, "Could not create socket");
+    return;
+  }
+  int err = this->socket_->setblocking(false);
+  if (err != 0) {
+    ESP_LOGW(TAG, "Socket unable to set nonblocking mode: errno %d", err);
+    this->disconnect_();
+    return;
+  }
+  int enable = 1;
+  err = this->socket_->setsockopt(IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(int));
+  if (err != 0) {
+    ESP_LOGW(TAG, "Socket unable to set nodelay: errno %d", err);
+  }
+  err = this->socket_->connect((struct sockaddr *) &server, sl);
+  if (err != 0 && errno != EINPROGRESS) {
+    ESP_LOGW(TAG, "Socket unable to connect: errno %d", errno);
+    this->disconnect_();
+    return;
+  }
+  this->state_ = ConnectionState::CONNECTING;
+}
+
+void ModbusTCP::disconnect_() {
+  if (this->socket_ != nullptr) {
+    this->socket_->close();
+    this->socket_ = nullptr;
+  }
+  this->state_ = ConnectionState::DISCONNECTED;
+  this->rx_buffer_.clear();
+  // requests in flight are lost, count them as timeouts
+  for (auto &transaction : this->transactions_)
+    this->count_timeout_(transaction.address);
+  this->transactions_.clear();
+}
+
+bool ModbusTCP::is_waiting_for_response(uint8_t address) {
+  auto in_flight = std::count_if(this->transactions_.begin(), this->transactions_.end(),
+                                 [address](const Transaction &transaction) { return transaction.address == address; });
+  return in_flight >= this->max_device_transactions_;
+}
+
+void ModbusTCP::send(uint8_t address, uint8_t function_code, uint16_t start_address, uint16_t number_of_entities,
+                     uint8_t payload_len, const uint8_t *payload) {
+  std::vector<uint8_t> frame =
+      this->build_frame_(address, function_code, start_address, number_of_entities, payload_len, payload);
+  if (!frame.empty())
+    this->write_frame_(frame);
+}
+
+// Helper function for lambdas
+// Send raw command. Unit id and PDU must be contained in payload
+void ModbusTCP::send_raw(const std::vector<uint8_t> &payload) {
+  if (payload.empty()) {
+    return;
+  }
+  this->write_frame_(payload);
+}
+
+void ModbusTCP::write_frame_(const std::vector<uint8_t> &frame) {
+  if (this->state_ != ConnectionState::CONNECTED) {
+    ESP_LOGW(TAG, "Not connected - dropping request to device 0x%02X", frame[0]);
+    return;
+  }
+  if (frame.size() > MAX_FRAME_SIZE) {
+    ESP_LOGE(TAG, "Frame too large: %zu", frame.size());
+    return;
+  }
+
+  const uint16_t transaction_id = this->next_transaction_id_++;
+  std::vector<uint8_t> adu;
+  adu.reserve(MBAP_HEADER_SIZE + frame.size());
+  adu.push_back(transaction_id >> 8);
+  adu.push_back(transaction_id >> 0);
+  adu.push_back(0);  // protocol id
+  adu.push_back(0);
+  adu.push_back(frame.size() >> 8);
+  adu.push_back(frame.size() >> 0);
+  adu.insert(adu.end(), frame.begin(), frame.end());
+
+  ssize_t written = this->socket_->write(adu.data(), adu.size());
+  if (written != (ssize_t) adu.size()) {
+    ESP_LOGW(TAG, "Socket write failed: errno %d", errno);
+    this->disconnect_();
+    return;
+  }
+  this->transactions_.push_back(Transaction{transaction_id, frame[0], millis()});
+  this->last_send_ = millis();
+  ESP_LOGV(TAG, "Modbus TCP write: %s", format_hex_pretty(adu).c_str());
+}
+
+void ModbusTCP::read_frames_() {
+  uint8_t buf[128];
+  while (true) {
+    ssize_t len = this->socket_->read(buf, sizeof(buf));
+    if (len == -1) {
+      if (errno == EWOULDBLOCK || errno == EAGAIN)
+        break;
+      ESP_LOGW(TAG, "Socket read failed: errno %d", errno);
+      this->disconnect_();
+      return;
+    }
+    if (len == 0) {
+      ESP_LOGW(TAG, "Connection closed by %s", this->ip_address_.c_str());
+      this->disconnect_();
+      return;
+    }
+    this->rx_buffer_.insert(this->rx_buffer_.end(), buf, buf + len);
+  }
+
+  size_t at = 0;
+  while (this->rx_buffer_.size() - at >= MBAP_HEADER_SIZE) {
+    const uint8_t *raw = &this->rx_buffer_[at];
+    const uint16_t transaction_id = (uint16_t(raw[0]) << 8) | raw[1];
+    const uint16_t protocol_id = (uint16_t(raw[2]) << 8) | raw[3];
+    const uint16_t length = (uint16_t(raw[4]) << 8) | raw[5];
+    if (protocol_id != 0 || length < 2 || length > MAX_FRAME_SIZE) {
+      ESP_LOGW(TAG, "Invalid MBAP header, reconnecting");
+      this->disconnect_();
+      return;
+    }
+    if (this->rx_buffer_.size() - at < MBAP_HEADER_SIZE + length)
+      break;
+    this->handle_frame_(transaction_id, raw + MBAP_HEADER_SIZE, length);
+    at += MBAP_HEADER_SIZE + length;
+  }
+  this->rx_buffer_.erase(this->rx_buffer_.begin(), this->rx_buffer_.begin() + at);
+}
+
+void ModbusTCP::handle_frame_(uint16_t transaction_id, const uint8_t *frame, uint16_t length) {
+  const uint8_t address = frame[0];
+  const uint8_t function_code = frame[1];
+
+  bool expected = false;
+  uint32_t round_trip_time = 0;
+  auto it = std::find_if(this->transactions_.begin(), this->transactions_.end(),
+                         [transaction_id](const Transaction &transaction) { return transaction.id == transaction_id; });
+  if (it != this->transactions_.end()) {
+    expected = true;
+    round_trip_time = millis() - it->sent;
+    // Devices match responses to their requests by order, earlier requests to the device were not answered
+    size_t index = it - this->transactions_.begin();
+    for (size_t i = 0; i < index;) {
+      if (this->transactions_[i].address == address) {
+        ESP_LOGV(TAG, "Device 0x%02X answered a later request", address);
+        this->count_timeout_(address);
+        this->transactions_.erase(this->transactions_.begin() + i);
+        index--;
+      } else {
+        i++;
+      }
+    }
+    this->transactions_.erase(this->transactions_.begin() + index);
+  }
+
+  // Same data layout as the RTU frames, see Modbus::parse_modbus_byte_
+  uint16_t data_offset = 3;
+  uint16_t data_len = length > 2 ? frame[2] : 0;
+  if (((function_code >= 65) && (function_code <= 72)) || ((function_code >= 100) && (function_code <= 110))) {
+    data_offset = 1;
+    data_len = length - 1;
+  } else if ((function_code & 0x80) == 0x80) {
+    data_offset = 2;
+    data_len = 1;
+  } else if (function_code == 0x5 || function_code == 0x06 || function_code == 0xF || function_code == 0x10) {
+    data_offset = 2;
+    data_len = 4;
+  }
+  if (data_offset + data_len > length) {
+    ESP_LOGW(TAG, "Modbus TCP frame too short for function code 0x%X", function_code);
+    return;
+  }
+
+  std::vector<uint8_t> data(frame + data_offset, frame + data_offset + data_len);
+  this->dispatch_frame_(address, function_code, data, expected, round_trip_time);
+}
+
+void ModbusTCP::check_timeouts_() {
+  const uint32_t now = millis();
+  for (auto it = this->transactions_.begin(); it != this->transactions_.end();) {
+    if (now - it->sent > this->send_wait_time_) {
+      ESP_LOGV(TAG, "No response from device 0x%02X within %d ms", it->address, this->send_wait_time_);
+      this->count_timeout_(it->address);
+      it = this->transactions_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void ModbusTCP::dump_config() {
+  ESP_LOGCONFIG(TAG, "Modbus TCP:");
+  ESP_LOGCONFIG(TAG, "  Address: %s:%u", this->ip_address_.c_str(), this->port_);
+  ESP_LOGCONFIG(TAG, "  Send Wait Time: %d ms", this->send_wait_time_);
+  ESP_LOGCONFIG(TAG, "  Max Transactions: %u", this->max_transactions_);
+  ESP_LOGCONFIG(TAG, "  Max Transactions per Device: %u", this->max_device_transactions_);
+}
+
+}  // namespace modbus_tcp
+}  // namespace esphome
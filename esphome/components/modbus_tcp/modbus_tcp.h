@@ -0,0 +1,75 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+#include "esphome/core/component.h"
+#include "esphome/components/modbus_hub/modbus_hub.h"
+#include "esphome/components/socket/socket.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace esphome {
+namespace modbus_tcp {
+
+enum class ConnectionState : uint8_t {
+  DISCONNECTED,
+  CONNECTING,
+  CONNECTED,
+};
+
+/** Modbus TCP client transport.
+ *
+ * Frames are sent with an MBAP header instead of a CRC. Every request gets its own transaction id, so several
+ * requests, also to the same device (unit id), can be outstanding on the connection at the same time. The responses
+ * of a device are passed on in the order of its requests, a response answering a later request means the earlier
+ * ones were lost.
+ */
+class ModbusTCP : public modbus::ModbusHub {
+ public:
+  void setup() override;
+  void loop() override;
+  void dump_config() override;
+  float get_setup_priority() const override { return setup_priority::AFTER_WIFI; }
+
+  void send(uint8_t address, uint8_t function_code, uint16_t start_address, uint16_t number_of_entities,
+            uint8_t payload_len = 0, const uint8_t *payload = nullptr) override;
+  void send_raw(const std::vector<uint8_t> &payload) override;
+  bool is_waiting_for_response(uint8_t address) override;
+
+  void set_ip_address(const std::string &ip_address) { this->ip_address_ = ip_address; }
+  void set_port(uint16_t port) { this->port_ = port; }
+  void set_max_transactions(uint8_t max_transactions) { this->max_transactions_ = max_transactions; }
+  void set_max_device_transactions(uint8_t max_device_transactions) {
+    this->max_device_transactions_ = max_device_transactions;
+  }
+
+ protected:
+  struct Transaction {
+    uint16_t id;
+    uint8_t address;
+    uint32_t sent;
+  };
+
+  void connect_();
+  void disconnect_();
+  void write_frame_(const std::vector<uint8_t> &frame);
+  void read_frames_();
+  void handle_frame_(uint16_t transaction_id, const uint8_t *frame, uint16_t length);
+  void check_timeouts_();
+
+  std::unique_ptr<socket::Socket> socket_;
+  ConnectionState state_{ConnectionState::DISCONNECTED};
+  std::string ip_address_;
+  uint16_t port_{502};
+  uint32_t connect_started_{0};
+  uint16_t next_transaction_id_{0};
+  uint8_t max_transactions_{4};
+  uint8_t max_device_transactions_{1};
+  /// Requests waiting for their response, in the order they were sent
+  std::vector<Transaction> transactions_;
+  std::vector<uint8_t> rx_buffer_;
+};
+
+}  // namespace modbus_tcp
+}  // namespace esphome
@@ -28,6 +28,7 @@ MULTI_CONF = True
 
 CONF_ON_DOWNLOAD_FINISHED = "on_download_finished"
 CONF_PLACEHOLDER = "placeholder"
+CONF_PROGRESSIVE_DISPLAY = "progressive_display"
 
 _LOGGER = logging.getLogger(__name__)
 
@@ -35,9 +36,13 @@ online_image_ns = cg.esphome_ns.namespace("online_image")
 
 ImageFormat = online_image_ns.enum("ImageFormat")
 
+FORMAT_JPEG = "JPEG"
 FORMAT_PNG = "PNG"
 
-IMAGE_FORMAT = {FORMAT_PNG: ImageFormat.PNG}  # Add new supported formats here
+IMAGE_FORMAT = {
+    FORMAT_JPEG: ImageFormat.JPEG,
+    FORMAT_PNG: ImageFormat.PNG,
+}  # Add new supported formats here
 
 OnlineImage = online_image_ns.class_("OnlineImage", cg.PollingComponent, Image_)
 
@@ -76,6 +81,7 @@ ONLINE_IMAGE_SCHEMA = cv.Schema(
         cv.Required(CONF_FORMAT): cv.enum(IMAGE_FORMAT, upper=True),
         cv.Optional(CONF_PLACEHOLDER): cv.use_id(Image_),
         cv.Optional(CONF_BUFFER_SIZE, default=2048): cv.int_range(256, 65536),
+        cv.Optional(CONF_PROGRESSIVE_DISPLAY, default=False): cv.boolean,
         cv.Optional(CONF_ON_DOWNLOAD_FINISHED): automation.validate_automation(
             {
                 cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(DownloadFinishedTrigger),
@@ -135,6 +141,9 @@ async def to_code(config):
     if format in [FORMAT_PNG]:
         cg.add_define("USE_ONLINE_IMAGE_PNG_SUPPORT")
         cg.add_library("pngle", "1.0.2")
+    if format in [FORMAT_JPEG]:
+        cg.add_define("USE_ONLINE_IMAGE_JPEG_SUPPORT")
+        cg.add_library("JPEGDEC", None, "https://github.com/bitbank2/JPEGDEC#ca1e0f2")
 
     url = config[CONF_URL]
     width, height = config.get(CONF_RESIZE, (0, 0))
@@ -153,6 +162,7 @@ async def to_code(config):
     await cg.register_parented(var, config[CONF_HTTP_REQUEST_ID])
 
     cg.add(var.set_transparency(transparent))
+    cg.add(var.set_progressive_display(config[CONF_PROGRESSIVE_DISPLAY]))
 
     if placeholder_id := config.get(CONF_PLACEHOLDER):
         placeholder = await cg.get_variable(placeholder_id)
@@ -24,6 +24,18 @@ void ImageDecoder::draw(int x, int y, int w, int h, const Color &color) {
   }
 }
 
+int ImageDecoder::get_downscale_factor(int width, int height, int max_factor) const {
+  if (this->image_->auto_resize_()) {
+    return 1;
+  }
+  int factor = 1;
+  while (factor < max_factor && width / (factor * 2) >= this->image_->fixed_width_ &&
+         height / (factor * 2) >= this->image_->fixed_height_) {
+    factor *= 2;
+  }
+  return factor;
+}
+
 uint8_t *DownloadBuffer::data(size_t offset) {
   if (offset > this->size_) {
     ESP_LOGE(TAG, "Tried to access beyond download buffer bounds!!!");
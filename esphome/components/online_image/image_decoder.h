@@ -63,7 +63,17 @@ class ImageDecoder {
    */
   void draw(int x, int y, int w, int h, const Color &color);
 
-  bool is_finished() const { return this->decoded_bytes_ == this->download_size_; }
+  /**
+   * @brief Get the largest power of two, up to max_factor, that the image can be shrunk by while decoding
+   * without becoming smaller than the size it is resized to. Always 1 if the image is not resized.
+   *
+   * @param width The image's width.
+   * @param height The image's height.
+   * @param max_factor The largest factor supported by the decoder.
+   */
+  int get_downscale_factor(int width, int height, int max_factor) const;
+
+  virtual bool is_finished() const { return this->decoded_bytes_ == this->download_size_; }
 
  protected:
   OnlineImage *image_;
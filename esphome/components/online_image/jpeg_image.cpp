@@ -0,0 +1,238 @@
+#include "jpeg_image.h"
+#ifdef USE_ONLINE_IMAGE_JPEG_SUPPORT
+
+#include "esphome/components/display/display_buffer.h"
+#include "esphome/core/application.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+
+static const char *const TAG = "online_image.jpeg";
+
+namespace esphome {
+namespace online_image {
+
+/// Size of the stream buffer between the download buffer and the decoder task.
+static const size_t STREAM_BUFFER_SIZE = 2048;
+static const uint32_t TASK_STACK_SIZE = 6144;
+static const UBaseType_t TASK_PRIORITY = 1;
+/// How long the decoder task waits for data before checking whether it should stop.
+static const uint32_t READ_TIMEOUT_MS = 50;
+/// Once the whole image is downloaded the decoder task never blocks, so let the idle task run now and then.
+static const uint32_t YIELD_INTERVAL_MS = 100;
+
+enum ScanState : uint8_t {
+  SCAN_MARKER,
+  SCAN_CODE,
+  SCAN_LENGTH_HIGH,
+  SCAN_LENGTH_LOW,
+  SCAN_SKIP,
+  SCAN_FRAME,
+  SCAN_DONE,
+  SCAN_ERROR,
+};
+
+/// SOF0 to SOF15, except for DHT, JPG and DAC which share the range.
+static bool is_frame_marker(uint8_t marker) {
+  return (marker & 0xF0) == 0xC0 && marker != 0xC4 && marker != 0xC8 && marker != 0xCC;
+}
+
+JpegDecoder::~JpegDecoder() {
+  if (this->task_ != nullptr) {
+    this->abort_ = true;
+    while (!this->task_done_) {
+      delay(1);
+    }
+  }
+  if (this->stream_ != nullptr) {
+    vStreamBufferDelete(this->stream_);
+  }
+}
+
+void JpegDecoder::prepare(uint32_t download_size) {
+  ImageDecoder::prepare(download_size);
+  this->stream_ = xStreamBufferCreate(STREAM_BUFFER_SIZE, 1);
+  if (this->stream_ == nullptr) {
+    ESP_LOGE(TAG, "Could not allocate stream buffer");
+    this->failed_ = true;
+    return;
+  }
+  if (xTaskCreate(decode_task, "jpeg_decode", TASK_STACK_SIZE, this, TASK_PRIORITY, &this->task_) != pdPASS) {
+    ESP_LOGE(TAG, "Could not start decoder task");
+    this->task_ = nullptr;
+    this->failed_ = true;
+  }
+}
+
+int HOT JpegDecoder::decode(uint8_t *buffer, size_t size) {
+  if (this->failed_) {
+    if (this->task_done_) {
+      ESP_LOGE(TAG, "Error decoding image: %d", this->jpeg_.getLastError());
+    }
+    return -1;
+  }
+  size_t len = std::min(size, xStreamBufferSpacesAvailable(this->stream_));
+  if (len == 0) {
+    return 0;
+  }
+
+  bool header_found = false;
+  if (this->scan_state_ != SCAN_DONE) {
+    size_t header_len = this->scan_header_(buffer, len);
+    if (this->scan_state_ == SCAN_ERROR) {
+      ESP_LOGE(TAG, "Invalid JPEG header");
+      return -1;
+    }
+    if (header_len > 0) {
+      // Only hand over the data up to the frame header; the image buffer has to be set up
+      // before the decoder task gets to the first MCU.
+      len = header_len;
+      header_found = true;
+      this->height_ = encode_uint16(this->frame_header_[1], this->frame_header_[2]);
+      this->width_ = encode_uint16(this->frame_header_[3], this->frame_header_[4]);
+      int factor = this->get_downscale_factor(this->width_, this->height_, 8);
+      if (factor == 8) {
+        this->scale_ = JPEG_SCALE_EIGHTH;
+      } else if (factor == 4) {
+        this->scale_ = JPEG_SCALE_QUARTER;
+      } else if (factor == 2) {
+        this->scale_ = JPEG_SCALE_HALF;
+      }
+      ESP_LOGD(TAG, "Image size: %dx%d, decoding at 1/%d", this->width_, this->height_, factor);
+      this->width_ = (this->width_ + factor - 1) / factor;
+      this->height_ = (this->height_ + factor - 1) / factor;
+    }
+  }
+
+  len = xStreamBufferSend(this->stream_, buffer, len, 0);
+  this->decoded_bytes_ += len;
+  if (header_found) {
+    // Ends the download if the buffer can't be allocated, so nothing may access the decoder after this.
+    this->set_size(this->width_, this->height_);
+  }
+  return len;
+}
+
+size_t JpegDecoder::scan_header_(const uint8_t *buffer, size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    uint8_t byte = buffer[i];
+    switch (this->scan_state_) {
+      case SCAN_MARKER:
+        this->scan_state_ = byte == 0xFF ? SCAN_CODE : SCAN_ERROR;
+        break;
+      case SCAN_CODE:
+        if (byte == 0xFF) {
+          // Fill byte
+          break;
+        }
+        this->marker_ = byte;
+        if (byte == 0xD8 || byte == 0x01 || (byte >= 0xD0 && byte <= 0xD7)) {
+          // SOI, TEM and RSTn have no payload
+          this->scan_state_ = SCAN_MARKER;
+        } else if (byte == 0xDA || byte == 0xD9) {
+          // Start of scan or end of image before the frame header
+          this->scan_state_ = SCAN_ERROR;
+        } else {
+          this->scan_state_ = SCAN_LENGTH_HIGH;
+        }
+        break;
+      case SCAN_LENGTH_HIGH:
+        this->segment_left_ = byte << 8;
+        this->scan_state_ = SCAN_LENGTH_LOW;
+        break;
+      case SCAN_LENGTH_LOW:
+        // The length includes its own two bytes
+        this->segment_left_ = (this->segment_left_ | byte) - 2;
+        if (is_frame_marker(this->marker_)) {
+          this->scan_state_ = this->segment_left_ < sizeof(this->frame_header_) ? SCAN_ERROR : SCAN_FRAME;
+        } else if (this->segment_left_ > 0xFFFD) {
+          this->scan_state_ = SCAN_ERROR;
+        } else {
+          this->scan_state_ = this->segment_left_ == 0 ? SCAN_MARKER : SCAN_SKIP;
+        }
+        break;
+      case SCAN_SKIP: {
+        size_t skip = std::min<size_t>(this->segment_left_, size - i);
+        this->segment_left_ -= skip;
+        i += skip - 1;
+        if (this->segment_left_ == 0)
+          this->scan_state_ = SCAN_MARKER;
+        break;
+      }
+      case SCAN_FRAME:
+        // Precision, height and width
+        this->frame_header_[this->frame_header_len_++] = byte;
+        if (this->frame_header_len_ == sizeof(this->frame_header_)) {
+          this->scan_state_ = SCAN_DONE;
+          return i + 1;
+        }
+        break;
+      default:
+        return 0;
+    }
+  }
+  return 0;
+}
+
+void JpegDecoder::decode_task(void *param) {
+  auto *decoder = static_cast<JpegDecoder *>(param);
+  auto &jpeg = decoder->jpeg_;
+  if (!jpeg.open(decoder, decoder->download_size_, close_callback, read_callback, seek_callback, draw_callback)) {
+    decoder->failed_ = true;
+  } else {
+    jpeg.setUserPointer(decoder);
+    jpeg.setPixelType(RGB565_LITTLE_ENDIAN);
+    if (!jpeg.decode(0, 0, decoder->scale_)) {
+      decoder->failed_ = true;
+    }
+    jpeg.close();
+  }
+  // The decoder may be destroyed as soon as this is set.
+  decoder->task_done_ = true;
+  vTaskDelete(nullptr);
+}
+
+int32_t JpegDecoder::read_callback(JPEGFILE *file, uint8_t *buffer, int32_t length) {
+  auto *decoder = static_cast<JpegDecoder *>(file->fHandle);
+  length = std::min(length, file->iSize - file->iPos);
+  int32_t read = 0;
+  while (read < length && !decoder->abort_) {
+    read += xStreamBufferReceive(decoder->stream_, buffer + read, length - read, pdMS_TO_TICKS(READ_TIMEOUT_MS));
+  }
+  file->iPos += read;
+  return read;
+}
+
+int32_t JpegDecoder::seek_callback(JPEGFILE *file, int32_t position) {
+  // The data only arrives as a stream, so it is only possible to skip ahead.
+  uint8_t discard[64];
+  while (file->iPos < position) {
+    int32_t len = std::min<int32_t>(sizeof(discard), position - file->iPos);
+    if (read_callback(file, discard, len) < len)
+      break;
+  }
+  return file->iPos;
+}
+
+int JpegDecoder::draw_callback(JPEGDRAW *draw) {
+  auto *decoder = static_cast<JpegDecoder *>(draw->pUser);
+  if (decoder->abort_) {
+    return 0;
+  }
+  const uint16_t *pixels = draw->pPixels;
+  for (int y = 0; y < draw->iHeight; y++) {
+    for (int x = 0; x < draw->iWidth; x++) {
+      decoder->draw(draw->x + x, draw->y + y, 1, 1, display::ColorUtil::rgb565_to_color(*pixels++));
+    }
+  }
+  uint32_t now = millis();
+  if (now - decoder->last_yield_ > YIELD_INTERVAL_MS) {
+    decoder->last_yield_ = now;
+    vTaskDelay(1);
+  }
+  return 1;
+}
+
+}  // namespace online_image
+}  // namespace esphome
+
+#endif  // USE_ONLINE_IMAGE_JPEG_SUPPORT
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "image_decoder.h"
+#ifdef USE_ONLINE_IMAGE_JPEG_SUPPORT
+#include <JPEGDEC.h>
+
+#include <atomic>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/stream_buffer.h>
+#include <freertos/task.h>
+
+namespace esphome {
+namespace online_image {
+
+/**
+ * @brief Image decoder specialization for JPEG images.
+ *
+ * JPEGDEC pulls its input through a read callback, so the decoding runs in its own task, which is fed through a
+ * small stream buffer from the download buffer. That way the image is decoded MCU row by MCU row while it is being
+ * downloaded, and the memory used does not depend on the size of the image.
+ */
+class JpegDecoder : public ImageDecoder {
+ public:
+  /**
+   * @brief Construct a new JPEG Decoder object.
+   *
+   * @param display The image to decode the stream into.
+   */
+  JpegDecoder(OnlineImage *image) : ImageDecoder(image) {}
+  ~JpegDecoder() override;
+
+  void prepare(uint32_t download_size) override;
+  int HOT decode(uint8_t *buffer, size_t size) override;
+  bool is_finished() const override { return this->task_done_ && !this->failed_; }
+
+ protected:
+  static void decode_task(void *param);
+  static int32_t read_callback(JPEGFILE *file, uint8_t *buffer, int32_t length);
+  static int32_t seek_callback(JPEGFILE *file, int32_t position);
+  static void close_callback(void *handle) {}
+  static int draw_callback(JPEGDRAW *draw);
+
+  /**
+   * @brief Look for the frame header in the bytes about to be handed to the decoder task.
+   *
+   * @return The number of bytes up to and including the frame header, or 0 if it is not part of the buffer.
+   */
+  size_t scan_header_(const uint8_t *buffer, size_t size);
+
+  JPEGDEC jpeg_;
+  StreamBufferHandle_t stream_{nullptr};
+  TaskHandle_t task_{nullptr};
+  /** Scale option passed to JPEGDEC, set from the frame header before the decoder task can parse it. */
+  int scale_{0};
+  uint32_t last_yield_{0};
+  std::atomic<bool> abort_{false};
+  std::atomic<bool> failed_{false};
+  std::atomic<bool> task_done_{false};
+
+  // Frame header scanner state
+  uint8_t scan_state_{0};
+  uint8_t marker_{0};
+  uint16_t segment_left_{0};
+  uint8_t frame_header_[5];
+  uint8_t frame_header_len_{0};
+  int width_{0};
+  int height_{0};
+};
+
+}  // namespace online_image
+}  // namespace esphome
+
+#endif  // USE_ONLINE_IMAGE_JPEG_SUPPORT
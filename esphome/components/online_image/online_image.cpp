@@ -9,6 +9,9 @@ static const char *const TAG = "online_image";
 #ifdef USE_ONLINE_IMAGE_PNG_SUPPORT
 #include "png_image.h"
 #endif
+#ifdef USE_ONLINE_IMAGE_JPEG_SUPPORT
+#include "jpeg_image.h"
+#endif
 
 namespace esphome {
 namespace online_image {
@@ -45,26 +48,32 @@ void OnlineImage::draw(int x, int y, display::Display *display, Color color_on,
 
 void OnlineImage::release() {
   if (this->buffer_) {
-    ESP_LOGD(TAG, "Deallocating old buffer...");
-    this->allocator_.deallocate(this->buffer_, this->get_buffer_size_());
-    this->data_start_ = nullptr;
-    this->buffer_ = nullptr;
-    this->width_ = 0;
-    this->height_ = 0;
-    this->buffer_width_ = 0;
-    this->buffer_height_ = 0;
+    // Stop decoding first, the decoder may still be writing into the buffer
     this->end_connection_();
+    this->deallocate_buffer_();
   }
 }
 
+void OnlineImage::deallocate_buffer_() {
+  ESP_LOGD(TAG, "Deallocating old buffer...");
+  this->allocator_.deallocate(this->buffer_, this->get_buffer_size_());
+  this->data_start_ = nullptr;
+  this->buffer_ = nullptr;
+  this->width_ = 0;
+  this->height_ = 0;
+  this->buffer_width_ = 0;
+  this->buffer_height_ = 0;
+}
+
 bool OnlineImage::resize_(int width_in, int height_in) {
   int width = this->fixed_width_;
   int height = this->fixed_height_;
   if (this->auto_resize_()) {
     width = width_in;
     height = height_in;
-    if (this->width_ != width && this->height_ != height) {
-      this->release();
+    if (this->buffer_ && this->width_ != width && this->height_ != height) {
+      // Called by the decoder, so keep the connection open
+      this->deallocate_buffer_();
     }
   }
   if (this->buffer_) {
@@ -79,6 +88,12 @@ bool OnlineImage::resize_(int width_in, int height_in) {
     this->buffer_height_ = height;
     this->width_ = width;
     ESP_LOGD(TAG, "New size: (%d, %d)", width, height);
+    if (this->progressive_display_) {
+      // Show the image right away; the parts not decoded yet stay blank
+      memset(this->buffer_, 0, new_size);
+      this->data_start_ = this->buffer_;
+      this->height_ = height;
+    }
   } else {
 #if defined(USE_ESP8266)
     // NOLINTNEXTLINE(readability-static-accessed-through-instance)
@@ -133,6 +148,11 @@ void OnlineImage::update() {
     this->decoder_ = esphome::make_unique<PngDecoder>(this);
   }
 #endif  // ONLINE_IMAGE_PNG_SUPPORT
+#ifdef USE_ONLINE_IMAGE_JPEG_SUPPORT
+  if (this->format_ == ImageFormat::JPEG) {
+    this->decoder_ = esphome::make_unique<JpegDecoder>(this);
+  }
+#endif  // USE_ONLINE_IMAGE_JPEG_SUPPORT
 
   if (!this->decoder_) {
     ESP_LOGE(TAG, "Could not instantiate decoder. Image format unsupported.");
@@ -167,16 +187,17 @@ void OnlineImage::loop() {
     auto len = this->downloader_->read(this->download_buffer_.append(), available);
     if (len > 0) {
       this->download_buffer_.write(len);
-      auto fed = this->decoder_->decode(this->download_buffer_.data(), this->download_buffer_.unread());
-      if (fed < 0) {
-        ESP_LOGE(TAG, "Error when decoding image.");
-        this->end_connection_();
-        this->download_error_callback_.call();
-        return;
-      }
-      this->download_buffer_.read(fed);
     }
   }
+  // Decoders may still be busy with data they took earlier, so keep calling them even if nothing new arrived.
+  auto fed = this->decoder_->decode(this->download_buffer_.data(), this->download_buffer_.unread());
+  if (fed < 0) {
+    ESP_LOGE(TAG, "Error when decoding image.");
+    this->end_connection_();
+    this->download_error_callback_.call();
+    return;
+  }
+  this->download_buffer_.read(fed);
 }
 
 void OnlineImage::draw_pixel_(int x, int y, Color color) {
@@ -23,7 +23,7 @@ using t_http_codes = enum {
 enum ImageFormat {
   /** Automatically detect from MIME type. Not supported yet. */
   AUTO,
-  /** JPEG format. Not supported yet. */
+  /** JPEG format. */
   JPEG,
   /** PNG format. */
   PNG,
@@ -70,6 +70,12 @@ class OnlineImage : public PollingComponent,
    */
   void set_placeholder(image::Image *placeholder) { this->placeholder_ = placeholder; }
 
+  /**
+   * @brief Show the image while it is being decoded, so that it fills in as the rows arrive,
+   * instead of only once it has been fully downloaded.
+   */
+  void set_progressive_display(bool progressive_display) { this->progressive_display_ = progressive_display; }
+
   /**
    * Release the buffer storing the image. The image will need to be downloaded again
    * to be able to be displayed.
@@ -97,6 +103,7 @@ class OnlineImage : public PollingComponent,
   ESPHOME_ALWAYS_INLINE bool auto_resize_() const { return this->fixed_width_ == 0 || this->fixed_height_ == 0; }
 
   bool resize_(int width, int height);
+  void deallocate_buffer_();
 
   /**
    * @brief Draw a pixel into the buffer.
@@ -124,6 +131,7 @@ class OnlineImage : public PollingComponent,
 
   const ImageFormat format_;
   image::Image *placeholder_{nullptr};
+  bool progressive_display_{false};
 
   std::string url_{""};
 
@@ -152,6 +160,7 @@ class OnlineImage : public PollingComponent,
 
   friend void ImageDecoder::set_size(int width, int height);
   friend void ImageDecoder::draw(int x, int y, int w, int h, const Color &color);
+  friend int ImageDecoder::get_downscale_factor(int width, int height, int max_factor) const;
 };
 
 template<typename... Ts> class OnlineImageSetUrlAction : public Action<Ts...> {
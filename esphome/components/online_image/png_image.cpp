@@ -50,7 +50,7 @@ void PngDecoder::prepare(uint32_t download_size) {
 
 int HOT PngDecoder::decode(uint8_t *buffer, size_t size) {
   if (size < 256 && size < this->download_size_ - this->decoded_bytes_) {
-    ESP_LOGD(TAG, "Waiting for data");
+    ESP_LOGV(TAG, "Waiting for data");
     return 0;
   }
   auto fed = pngle_feed(this->pngle_, buffer, size);
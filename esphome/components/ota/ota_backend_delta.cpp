@@ -0,0 +1,114 @@
+#include "ota_backend_delta.h"
+
+#ifdef USE_ESP32
+
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+
+#include <esp_ota_ops.h>
+
+#include <algorithm>
+#include <cinttypes>
+
+namespace esphome {
+namespace ota {
+
+static const char *const TAG = "ota.delta";
+
+static uint32_t read_u32(const uint8_t *data) {
+  return uint32_t(data[0]) | (uint32_t(data[1]) << 8) | (uint32_t(data[2]) << 16) | (uint32_t(data[3]) << 24);
+}
+
+bool DeltaOTABackend::get_running_image_hash(uint8_t *hash) {
+  const esp_partition_t *partition = esp_ota_get_running_partition();
+  if (partition == nullptr)
+    return false;
+  // The hash appended to the image, or the hash of the whole image if there is none
+  return esp_partition_get_sha256(partition, hash) == ESP_OK;
+}
+
+OTAResponseTypes DeltaOTABackend::begin(size_t image_size) {
+  this->running_partition_ = esp_ota_get_running_partition();
+  this->copy_buffer_ = make_unique<uint8_t[]>(COPY_BUFFER_SIZE);
+  if (this->running_partition_ == nullptr)
+    return OTA_RESPONSE_ERROR_UPDATE_PREPARE;
+  this->op_length_ = 0;
+  this->insert_remaining_ = 0;
+  return this->backend_->begin(image_size);
+}
+
+OTAResponseTypes DeltaOTABackend::write(uint8_t *data, size_t len) {
+  while (len > 0) {
+    if (this->insert_remaining_ > 0) {
+      const size_t length = std::min<size_t>(len, this->insert_remaining_);
+      OTAResponseTypes error = this->backend_->write(data, length);
+      if (error != OTA_RESPONSE_OK)
+        return error;
+      data += length;
+      len -= length;
+      this->insert_remaining_ -= length;
+      continue;
+    }
+
+    this->op_[this->op_length_++] = *data++;
+    len--;
+    size_t op_size;
+    switch (this->op_[0]) {
+      case OP_COPY:
+        op_size = 9;
+        break;
+      case OP_INSERT:
+        op_size = 5;
+        break;
+      default:
+        ESP_LOGW(TAG, "Invalid patch operation 0x%02X", this->op_[0]);
+        return OTA_RESPONSE_ERROR_INVALID_PATCH;
+    }
+    if (this->op_length_ < op_size)
+      continue;
+
+    this->op_length_ = 0;
+    if (this->op_[0] == OP_INSERT) {
+      this->insert_remaining_ = read_u32(this->op_ + 1);
+    } else {
+      OTAResponseTypes error = this->copy_(read_u32(this->op_ + 1), read_u32(this->op_ + 5));
+      if (error != OTA_RESPONSE_OK)
+        return error;
+    }
+  }
+  return OTA_RESPONSE_OK;
+}
+
+OTAResponseTypes DeltaOTABackend::copy_(uint32_t offset, uint32_t length) {
+  if (offset > this->running_partition_->size || length > this->running_partition_->size - offset) {
+    ESP_LOGW(TAG, "Patch copies %" PRIu32 " bytes at %" PRIu32 ", outside of the running image", length, offset);
+    return OTA_RESPONSE_ERROR_INVALID_PATCH;
+  }
+  while (length > 0) {
+    const size_t chunk = std::min<size_t>(length, COPY_BUFFER_SIZE);
+    if (esp_partition_read(this->running_partition_, offset, this->copy_buffer_.get(), chunk) != ESP_OK) {
+      ESP_LOGW(TAG, "Reading the running image failed");
+      return OTA_RESPONSE_ERROR_INVALID_PATCH;
+    }
+    OTAResponseTypes error = this->backend_->write(this->copy_buffer_.get(), chunk);
+    if (error != OTA_RESPONSE_OK)
+      return error;
+    offset += chunk;
+    length -= chunk;
+  }
+  return OTA_RESPONSE_OK;
+}
+
+OTAResponseTypes DeltaOTABackend::end() {
+  this->copy_buffer_.reset();
+  if (this->op_length_ != 0 || this->insert_remaining_ != 0) {
+    ESP_LOGW(TAG, "Patch ended in the middle of an operation");
+    return OTA_RESPONSE_ERROR_INVALID_PATCH;
+  }
+  return this->backend_->end();
+}
+
+}  // namespace ota
+}  // namespace esphome
+
+#endif  // USE_ESP32
@@ -0,0 +1,61 @@
+#pragma once
+
+#ifdef USE_ESP32
+#include "ota_backend.h"
+
+#include <esp_partition.h>
+
+#include <memory>
+
+namespace esphome {
+namespace ota {
+
+/**
+ * @brief Rebuilds the new image from a patch against the running image and writes it to another backend.
+ *
+ * The patch is a sequence of operations, with little endian fields:
+ * - OP_COPY, offset (u32), length (u32): copy length bytes at offset in the running image.
+ * - OP_INSERT, length (u32), then length bytes of data: insert the data.
+ *
+ * The patch is applied while it is received, using a buffer of COPY_BUFFER_SIZE bytes. begin() and the MD5 apply to
+ * the new image, so a patch that does not match the running image fails the MD5 check.
+ */
+class DeltaOTABackend : public OTABackend {
+ public:
+  static const uint8_t OP_COPY = 0x00;
+  static const uint8_t OP_INSERT = 0x01;
+  static const size_t COPY_BUFFER_SIZE = 1024;
+  static const size_t IMAGE_HASH_SIZE = 32;
+
+  explicit DeltaOTABackend(std::unique_ptr<OTABackend> backend) : backend_(std::move(backend)) {}
+
+  OTAResponseTypes begin(size_t image_size) override;
+  void set_update_md5(const char *md5) override { this->backend_->set_update_md5(md5); }
+  OTAResponseTypes write(uint8_t *data, size_t len) override;
+  OTAResponseTypes end() override;
+  void abort() override { this->backend_->abort(); }
+  bool supports_compression() override { return false; }
+
+  /// @brief Gets the SHA-256 of the running image, which identifies the image a patch is made against.
+  /// @return false if the hash could not be determined, delta updates are then not possible.
+  static bool get_running_image_hash(uint8_t *hash);
+
+ protected:
+  /// @brief Writes length bytes at offset in the running image to the backend.
+  OTAResponseTypes copy_(uint32_t offset, uint32_t length);
+
+  std::unique_ptr<OTABackend> backend_;
+  const esp_partition_t *running_partition_{nullptr};
+  std::unique_ptr<uint8_t[]> copy_buffer_;
+
+  /// The operation being received.
+  uint8_t op_[9];
+  size_t op_length_{0};
+  /// Bytes of the current OP_INSERT still to be received.
+  uint32_t insert_remaining_{0};
+};
+
+}  // namespace ota
+}  // namespace esphome
+
+#endif  // USE_ESP32
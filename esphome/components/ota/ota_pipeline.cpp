@@ -0,0 +1,117 @@
+#include "ota_pipeline.h"
+
+#ifdef USE_ESP32
+
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace ota {
+
+static const char *const TAG = "ota.pipeline";
+
+static const uint32_t WRITE_TASK_STACK_SIZE = 4096;
+static const UBaseType_t WRITE_TASK_PRIORITY = 2;
+
+OTAPipeline::~OTAPipeline() {
+  if (this->task_handle_ != nullptr)
+    this->finish();
+  if (this->write_queue_ != nullptr)
+    vQueueDelete(this->write_queue_);
+  if (this->free_queue_ != nullptr)
+    vQueueDelete(this->free_queue_);
+  if (this->buffers_ != nullptr) {
+    RAMAllocator<uint8_t> allocator(RAMAllocator<uint8_t>::ALLOC_INTERNAL);
+    allocator.deallocate(this->buffers_, BUFFER_COUNT * BUFFER_SIZE);
+  }
+}
+
+bool OTAPipeline::start(OTABackend *backend) {
+  this->backend_ = backend;
+
+  // Flash can't be written from PSRAM directly
+  RAMAllocator<uint8_t> allocator(RAMAllocator<uint8_t>::ALLOC_INTERNAL);
+  this->buffers_ = allocator.allocate(BUFFER_COUNT * BUFFER_SIZE);
+  if (this->buffers_ == nullptr) {
+    ESP_LOGW(TAG, "Not enough memory for the write buffers");
+    return false;
+  }
+
+  this->free_queue_ = xQueueCreate(BUFFER_COUNT + 1, sizeof(uint8_t *));
+  this->write_queue_ = xQueueCreate(BUFFER_COUNT + 1, sizeof(Block));
+  if (this->free_queue_ == nullptr || this->write_queue_ == nullptr) {
+    ESP_LOGW(TAG, "Could not create the write queues");
+    return false;
+  }
+  for (size_t i = 0; i < BUFFER_COUNT; i++) {
+    uint8_t *buffer = this->buffers_ + i * BUFFER_SIZE;
+    xQueueSend(this->free_queue_, &buffer, 0);
+  }
+
+  if (xTaskCreate(OTAPipeline::write_task, "ota_write", WRITE_TASK_STACK_SIZE, (void *) this, WRITE_TASK_PRIORITY,
+                  &this->task_handle_) != pdPASS) {
+    ESP_LOGW(TAG, "Could not start the write task");
+    this->task_handle_ = nullptr;
+    return false;
+  }
+  return true;
+}
+
+uint8_t *OTAPipeline::get_buffer(uint32_t timeout_ms) {
+  uint8_t *buffer = nullptr;
+  const uint32_t start = micros();
+  if (xQueueReceive(this->free_queue_, &buffer, pdMS_TO_TICKS(timeout_ms)) != pdTRUE)
+    buffer = nullptr;
+  this->wait_time_us_ += micros() - start;
+  return buffer;
+}
+
+void OTAPipeline::write(uint8_t *buffer, size_t length) {
+  Block block{buffer, length};
+  // Never blocks, there are more queue slots than buffers
+  xQueueSend(this->write_queue_, &block, portMAX_DELAY);
+}
+
+OTAResponseTypes OTAPipeline::finish() {
+  if (this->task_handle_ != nullptr) {
+    Block stop{nullptr, 0};
+    xQueueSend(this->write_queue_, &stop, portMAX_DELAY);
+    // The task returns every buffer, then signals that it stopped with nullptr
+    uint8_t *buffer;
+    do {
+      xQueueReceive(this->free_queue_, &buffer, portMAX_DELAY);
+    } while (buffer != nullptr);
+    this->task_handle_ = nullptr;
+  }
+  return this->get_error();
+}
+
+void OTAPipeline::write_task(void *params) {
+  OTAPipeline *this_pipeline = (OTAPipeline *) params;
+
+  Block block;
+  while (true) {
+    xQueueReceive(this_pipeline->write_queue_, &block, portMAX_DELAY);
+    if (block.data == nullptr)
+      break;
+
+    if (this_pipeline->error_.load() == OTA_RESPONSE_OK) {
+      const uint32_t start = micros();
+      const OTAResponseTypes error = this_pipeline->backend_->write(block.data, block.length);
+      this_pipeline->write_time_us_ += micros() - start;
+      if (error != OTA_RESPONSE_OK)
+        this_pipeline->error_.store(error);
+    }
+    xQueueSend(this_pipeline->free_queue_, &block.data, portMAX_DELAY);
+  }
+
+  uint8_t *stopped = nullptr;
+  xQueueSend(this_pipeline->free_queue_, &stopped, portMAX_DELAY);
+  vTaskDelete(nullptr);
+}
+
+}  // namespace ota
+}  // namespace esphome
+
+#endif  // USE_ESP32
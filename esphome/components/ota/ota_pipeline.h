@@ -0,0 +1,78 @@
+#pragma once
+
+#ifdef USE_ESP32
+#include "ota_backend.h"
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+
+#include <atomic>
+
+namespace esphome {
+namespace ota {
+
+/**
+ * @brief Writes an update to an OTABackend from a separate task.
+ *
+ * The caller fills buffers with the data it receives and queues them, while the task writes the previous buffers to
+ * flash. Receiving only has to wait for flash when all buffers are queued.
+ */
+class OTAPipeline {
+ public:
+  static const size_t BUFFER_COUNT = 4;
+  static const size_t BUFFER_SIZE = 4096;
+
+  ~OTAPipeline();
+
+  /// @brief Allocates the buffers and starts the task.
+  /// @return false if that failed, the backend then has to be written directly.
+  bool start(OTABackend *backend);
+
+  /// @brief Takes an empty buffer of BUFFER_SIZE bytes.
+  /// @param timeout_ms Time to wait for the task to finish writing a buffer.
+  /// @return The buffer, or nullptr on timeout.
+  uint8_t *get_buffer(uint32_t timeout_ms);
+
+  /// @brief Queues a buffer from get_buffer() to be written.
+  void write(uint8_t *buffer, size_t length);
+
+  /// @brief Waits until all queued buffers are written, then stops the task.
+  /// @return The first error of the backend, or OTA_RESPONSE_OK.
+  OTAResponseTypes finish();
+
+  /// @brief First error of the backend so far, or OTA_RESPONSE_OK. Buffers queued after an error are not written.
+  OTAResponseTypes get_error() const { return this->error_.load(); }
+
+  /// @brief Total time spent writing to the backend. Only valid after finish().
+  uint32_t get_write_time_ms() const { return this->write_time_us_ / 1000; }
+  /// @brief Total time spent in get_buffer() waiting for the backend.
+  uint32_t get_wait_time_ms() const { return this->wait_time_us_ / 1000; }
+
+ protected:
+  struct Block {
+    uint8_t *data;
+    size_t length;
+  };
+
+  /// @brief Function for the FreeRTOS task that writes the queued blocks. A block without data stops it.
+  /// @param params OTAPipeline
+  static void write_task(void *params);
+
+  OTABackend *backend_{nullptr};
+  uint8_t *buffers_{nullptr};
+  /// Empty buffers, nullptr once the task stopped.
+  QueueHandle_t free_queue_{nullptr};
+  /// Blocks to write.
+  QueueHandle_t write_queue_{nullptr};
+  TaskHandle_t task_handle_{nullptr};
+
+  std::atomic<OTAResponseTypes> error_{OTA_RESPONSE_OK};
+  uint32_t write_time_us_{0};
+  uint32_t wait_time_us_{0};
+};
+
+}  // namespace ota
+}  // namespace esphome
+
+#endif  // USE_ESP32
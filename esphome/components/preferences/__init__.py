@@ -8,12 +8,17 @@ preferences_ns = cg.esphome_ns.namespace("preferences")
 IntervalSyncer = preferences_ns.class_("IntervalSyncer", cg.Component)
 
 CONF_FLASH_WRITE_INTERVAL = "flash_write_interval"
+CONF_RTC_CACHE_SIZE = "rtc_cache_size"
 CONFIG_SCHEMA = cv.Schema(
     {
         cv.GenerateID(): cv.declare_id(IntervalSyncer),
         cv.Optional(
             CONF_FLASH_WRITE_INTERVAL, default="60s"
         ): cv.positive_time_period_milliseconds,
+        # Keep the values in RTC memory to load them from there after deep sleep
+        cv.Optional(CONF_RTC_CACHE_SIZE): cv.All(
+            cv.only_on_esp32, cv.validate_bytes, cv.int_range(min=64, max=4096)
+        ),
     }
 ).extend(cv.COMPONENT_SCHEMA)
 
@@ -22,3 +27,5 @@ async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     cg.add(var.set_write_interval(config[CONF_FLASH_WRITE_INTERVAL]))
     await cg.register_component(var, config)
+    if CONF_RTC_CACHE_SIZE in config:
+        cg.add_define("USE_PREFERENCES_RTC_CACHE", config[CONF_RTC_CACHE_SIZE])
@@ -0,0 +1,41 @@
+#include "syncer.h"
+
+#include "esphome/core/log.h"
+
+#include <cinttypes>
+
+namespace esphome {
+namespace preferences {
+
+static const char *const TAG = "preferences";
+
+void IntervalSyncer::setup() {
+  this->set_interval(this->write_interval_, [this]() { this->sync_(); });
+}
+
+void IntervalSyncer::dump_config() {
+  ESP_LOGCONFIG(TAG, "Preferences:");
+  ESP_LOGCONFIG(TAG, "  Flash write interval: %" PRIu32 " ms", this->write_interval_);
+  const ESPPreferencesStats &stats = global_preferences->get_stats();
+  ESP_LOGCONFIG(TAG, "  Flash writes since boot: %" PRIu32, stats.writes);
+  ESP_LOGCONFIG(TAG, "  Flash erases since boot: %" PRIu32, stats.erases);
+  ESP_LOGCONFIG(TAG, "  Unchanged saves: %" PRIu32, stats.unchanged);
+  ESP_LOGCONFIG(TAG, "  Held back saves: %" PRIu32, stats.deferred);
+}
+
+void IntervalSyncer::sync_() {
+  global_preferences->sync();
+
+  // Only logged when flash was written, to follow the wear caused by the preferences
+  const ESPPreferencesStats &stats = global_preferences->get_stats();
+  if (stats.writes == this->logged_writes_)
+    return;
+  this->logged_writes_ = stats.writes;
+  ESP_LOGD(TAG,
+           "Flash writes since boot: %" PRIu32 ", erases: %" PRIu32 ", unchanged saves: %" PRIu32
+           ", held back saves: %" PRIu32,
+           stats.writes, stats.erases, stats.unchanged, stats.deferred);
+}
+
+}  // namespace preferences
+}  // namespace esphome
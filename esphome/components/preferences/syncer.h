@@ -9,14 +9,17 @@ namespace preferences {
 class IntervalSyncer : public Component {
  public:
   void set_write_interval(uint32_t write_interval) { write_interval_ = write_interval; }
-  void setup() override {
-    set_interval(write_interval_, []() { global_preferences->sync(); });
-  }
-  void on_shutdown() override { global_preferences->sync(); }
+  void setup() override;
+  void dump_config() override;
+  void on_shutdown() override { global_preferences->flush(); }
   float get_setup_priority() const override { return setup_priority::BUS; }
 
  protected:
+  void sync_();
+
   uint32_t write_interval_;
+  /// Flash writes at the last time the statistics were logged.
+  uint32_t logged_writes_{0};
 };
 
 }  // namespace preferences
@@ -3,7 +3,7 @@
 #include "esphome/core/automation.h"
 #include "esphome/core/component.h"
 #include "esphome/components/sensor/sensor.h"
-#include "esphome/components/modbus/modbus.h"
+#include "esphome/components/modbus_hub/modbus_hub.h"
 
 #include <vector>
 
@@ -2,7 +2,7 @@ import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome import automation
 from esphome.automation import maybe_simple_id
-from esphome.components import sensor, modbus
+from esphome.components import sensor, modbus_hub
 from esphome.const import (
     CONF_CURRENT,
     CONF_ID,
@@ -21,10 +21,10 @@ from esphome.const import (
     UNIT_KILOWATT_HOURS,
 )
 
-AUTO_LOAD = ["modbus"]
+AUTO_LOAD = ["modbus_hub"]
 
 pzemdc_ns = cg.esphome_ns.namespace("pzemdc")
-PZEMDC = pzemdc_ns.class_("PZEMDC", cg.PollingComponent, modbus.ModbusDevice)
+PZEMDC = pzemdc_ns.class_("PZEMDC", cg.PollingComponent, modbus_hub.ModbusDevice)
 
 # Actions
 ResetEnergyAction = pzemdc_ns.class_("ResetEnergyAction", automation.Action)
@@ -60,7 +60,7 @@ CONFIG_SCHEMA = (
         }
     )
     .extend(cv.polling_component_schema("60s"))
-    .extend(modbus.modbus_device_schema(0x01))
+    .extend(modbus_hub.modbus_device_schema(0x01))
 )
 
 
@@ -81,7 +81,7 @@ async def reset_energy_to_code(config, action_id, template_arg, args):
 async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     await cg.register_component(var, config)
-    await modbus.register_modbus_device(var, config)
+    await modbus_hub.register_modbus_device(var, config)
 
     if CONF_VOLTAGE in config:
         conf = config[CONF_VOLTAGE]
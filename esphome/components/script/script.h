@@ -4,7 +4,8 @@
 #include "esphome/core/component.h"
 #include "esphome/core/log.h"
 
-#include <queue>
+#include <algorithm>
+#include <vector>
 namespace esphome {
 namespace script {
 
@@ -29,6 +30,8 @@ template<typename... Ts> class Script : public ScriptLogger, public Trigger<Ts..
   virtual void execute(Ts...) = 0;
   /// Check if any instance of this script is currently running.
   virtual bool is_running() { return this->is_action_running(); }
+  /// Return the number of instances of this script that are currently running.
+  int num_running() { return this->num_action_runs_in_flight(); }
   /// Stop all instances of this script.
   virtual void stop() { this->stop_action(); }
 
@@ -98,8 +101,7 @@ template<typename... Ts> class QueueingScript : public Script<Ts...>, public Com
       }
 
       this->esp_logd_(__LINE__, "Script '%s' queueing new instance (mode: queued)", this->name_.c_str());
-      this->num_runs_++;
-      this->var_queue_.push(std::make_tuple(x...));
+      this->push_(x...);
       return;
     }
 
@@ -110,28 +112,48 @@ template<typename... Ts> class QueueingScript : public Script<Ts...>, public Com
 
   void stop() override {
     this->num_runs_ = 0;
+    this->queue_head_ = 0;
     Script<Ts...>::stop();
   }
 
   void loop() override {
     if (this->num_runs_ != 0 && !this->is_action_running()) {
       this->num_runs_--;
-      auto &vars = this->var_queue_.front();
-      this->var_queue_.pop();
+      auto vars = std::move(this->var_queue_[this->queue_head_]);
+      this->queue_head_ = (this->queue_head_ + 1) % this->var_queue_.size();
       this->trigger_tuple_(vars, typename gens<sizeof...(Ts)>::type());
     }
   }
 
-  void set_max_runs(int max_runs) { max_runs_ = max_runs; }
+  void set_max_runs(int max_runs) {
+    max_runs_ = max_runs;
+    // at most max_runs - 1 instances are queued, so the queue never has to grow
+    if (max_runs > 1)
+      this->var_queue_.resize(max_runs - 1);
+  }
 
  protected:
   template<int... S> void trigger_tuple_(const std::tuple<Ts...> &tuple, seq<S...> /*unused*/) {
     this->trigger(std::get<S>(tuple)...);
   }
 
+  void push_(Ts... x) {
+    if (this->num_runs_ == (int) this->var_queue_.size()) {
+      // only without max_runs: unroll the ring and double its size
+      std::rotate(this->var_queue_.begin(), this->var_queue_.begin() + this->queue_head_, this->var_queue_.end());
+      this->queue_head_ = 0;
+      this->var_queue_.resize(std::max<size_t>(4, this->var_queue_.size() * 2));
+    }
+    size_t index = (this->queue_head_ + this->num_runs_) % this->var_queue_.size();
+    this->var_queue_[index] = std::make_tuple(x...);
+    this->num_runs_++;
+  }
+
   int num_runs_ = 0;
   int max_runs_ = 0;
-  std::queue<std::tuple<Ts...>> var_queue_;
+  /// Arguments of the queued instances, a ring buffer starting at queue_head_
+  std::vector<std::tuple<Ts...>> var_queue_;
+  size_t queue_head_{0};
 };
 
 /** A script type that executes new instances in parallel.
@@ -142,7 +164,7 @@ template<typename... Ts> class QueueingScript : public Script<Ts...>, public Com
 template<typename... Ts> class ParallelScript : public Script<Ts...> {
  public:
   void execute(Ts... x) override {
-    if (this->max_runs_ != 0 && this->automation_parent_->num_running() >= this->max_runs_) {
+    if (this->max_runs_ != 0 && this->num_running() >= this->max_runs_) {
       this->esp_logw_(__LINE__, "Script '%s' maximum number of parallel runs exceeded!", this->name_.c_str());
       return;
     }
@@ -225,7 +247,7 @@ template<class C, typename... Ts> class ScriptWaitAction : public Action<Ts...>,
       this->play_next_(x...);
       return;
     }
-    this->var_ = std::make_tuple(x...);
+    this->pending_.acquire(x...);
     this->loop();
   }
 
@@ -236,9 +258,18 @@ template<class C, typename... Ts> class ScriptWaitAction : public Action<Ts...>,
     if (this->script_->is_running())
       return;
 
-    this->play_next_tuple_(this->var_);
+    // every waiting run continues, the following actions may start waiting again
+    for (int slot = this->pending_.find_used(); slot != -1 && this->num_running_ > 0;
+         slot = this->pending_.find_used()) {
+      auto args = this->pending_.take(slot);
+      this->play_next_tuple_(args);
+      if (this->script_->is_running())
+        break;
+    }
   }
 
+  void stop() override { this->pending_.release_all(); }
+
   float get_setup_priority() const override { return setup_priority::DATA; }
 
   void play(Ts... x) override { /* ignore - see play_complex */
@@ -246,7 +277,7 @@ template<class C, typename... Ts> class ScriptWaitAction : public Action<Ts...>,
 
  protected:
   C *script_;
-  std::tuple<Ts...> var_{};
+  ActionStatePool<Ts...> pending_;
 };
 
 }  // namespace script
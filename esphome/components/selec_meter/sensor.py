@@ -1,6 +1,6 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
-from esphome.components import sensor, modbus
+from esphome.components import sensor, modbus_hub
 from esphome.const import (
     CONF_ACTIVE_POWER,
     CONF_APPARENT_POWER,
@@ -30,7 +30,7 @@ from esphome.const import (
     UNIT_WATT,
 )
 
-AUTO_LOAD = ["modbus"]
+AUTO_LOAD = ["modbus_hub"]
 CODEOWNERS = ["@sourabhjaiswal"]
 
 CONF_TOTAL_ACTIVE_ENERGY = "total_active_energy"
@@ -46,7 +46,7 @@ UNIT_KILOVOLT_AMPS_REACTIVE_HOURS = "kVARh"
 
 selec_meter_ns = cg.esphome_ns.namespace("selec_meter")
 SelecMeter = selec_meter_ns.class_(
-    "SelecMeter", cg.PollingComponent, modbus.ModbusDevice
+    "SelecMeter", cg.PollingComponent, modbus_hub.ModbusDevice
 )
 
 SENSORS = {
@@ -151,14 +151,14 @@ CONFIG_SCHEMA = (
         {cv.Optional(sensor_name): schema for sensor_name, schema in SENSORS.items()}
     )
     .extend(cv.polling_component_schema("10s"))
-    .extend(modbus.modbus_device_schema(0x01))
+    .extend(modbus_hub.modbus_device_schema(0x01))
 )
 
 
 async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     await cg.register_component(var, config)
-    await modbus.register_modbus_device(var, config)
+    await modbus_hub.register_modbus_device(var, config)
     for name in SENSORS:
         if name in config:
             sens = await sensor.new_sensor(config[name])
@@ -40,7 +40,10 @@ std::string format_sockaddr(const struct sockaddr_storage &storage) {
 
 class BSDSocketImpl : public Socket {
  public:
-  BSDSocketImpl(int fd) : fd_(fd) {}
+  BSDSocketImpl(int fd, bool monitor_loop = false) : fd_(fd) {
+    if (monitor_loop)
+      this->loop_monitored_ = monitor_fd(fd);
+  }
   ~BSDSocketImpl() override {
     if (!closed_) {
       close();  // NOLINT(clang-analyzer-optin.cplusplus.VirtualCall)
@@ -50,10 +53,15 @@ class BSDSocketImpl : public Socket {
     int fd = ::accept(fd_, addr, addrlen);
     if (fd == -1)
       return {};
-    return make_unique<BSDSocketImpl>(fd);
+    return make_unique<BSDSocketImpl>(fd, this->loop_monitored_);
   }
   int bind(const struct sockaddr *addr, socklen_t addrlen) override { return ::bind(fd_, addr, addrlen); }
+  int connect(const struct sockaddr *addr, socklen_t addrlen) override { return ::connect(fd_, addr, addrlen); }
   int close() override {
+    if (this->loop_monitored_) {
+      unmonitor_fd(fd_);
+      this->loop_monitored_ = false;
+    }
     int ret = ::close(fd_);
     closed_ = true;
     return ret;
@@ -125,9 +133,12 @@ class BSDSocketImpl : public Socket {
     return 0;
   }
 
+  bool ready() const override { return !this->loop_monitored_ || is_fd_ready(fd_); }
+
  protected:
   int fd_;
   bool closed_ = false;
+  bool loop_monitored_ = false;
 };
 
 std::unique_ptr<Socket> socket(int domain, int type, int protocol) {
@@ -137,6 +148,13 @@ std::unique_ptr<Socket> socket(int domain, int type, int protocol) {
   return std::unique_ptr<Socket>{new BSDSocketImpl(ret)};
 }
 
+std::unique_ptr<Socket> socket_loop_monitored(int domain, int type, int protocol) {
+  int ret = ::socket(domain, type, protocol);
+  if (ret == -1)
+    return nullptr;
+  return std::unique_ptr<Socket>{new BSDSocketImpl(ret, true)};
+}
+
 }  // namespace socket
 }  // namespace esphome
 
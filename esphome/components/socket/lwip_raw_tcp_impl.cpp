@@ -73,41 +73,9 @@ class LWIPRawImpl : public Socket {
     }
     ip_addr_t ip;
     in_port_t port;
-#if LWIP_IPV6
-    if (family_ == AF_INET) {
-      if (addrlen < sizeof(sockaddr_in)) {
-        errno = EINVAL;
-        return -1;
-      }
-      auto *addr4 = reinterpret_cast<const sockaddr_in *>(name);
-      port = ntohs(addr4->sin_port);
-      ip.type = IPADDR_TYPE_V4;
-      ip.u_addr.ip4.addr = addr4->sin_addr.s_addr;
-      LWIP_LOG("tcp_bind(%p ip=%s port=%u)", pcb_, ip4addr_ntoa(&ip.u_addr.ip4), port);
-    } else if (family_ == AF_INET6) {
-      if (addrlen < sizeof(sockaddr_in6)) {
-        errno = EINVAL;
-        return -1;
-      }
-      auto *addr6 = reinterpret_cast<const sockaddr_in6 *>(name);
-      port = ntohs(addr6->sin6_port);
-      ip.type = IPADDR_TYPE_ANY;
-      memcpy(&ip.u_addr.ip6.addr, &addr6->sin6_addr.un.u8_addr, 16);
-      LWIP_LOG("tcp_bind(%p ip=%s port=%u)", pcb_, ip6addr_ntoa(&ip.u_addr.ip6), port);
-    } else {
-      errno = EINVAL;
-      return -1;
-    }
-#else
-    if (family_ != AF_INET) {
-      errno = EINVAL;
+    if (this->sockaddr2ip_(name, addrlen, &ip, &port) != 0)
       return -1;
-    }
-    auto *addr4 = reinterpret_cast<const sockaddr_in *>(name);
-    port = ntohs(addr4->sin_port);
-    ip.addr = addr4->sin_addr.s_addr;
-    LWIP_LOG("tcp_bind(%p ip=%u port=%u)", pcb_, ip.addr, port);
-#endif
+    LWIP_LOG("tcp_bind(%p port=%u)", pcb_, port);
     err_t err = tcp_bind(pcb_, &ip, port);
     if (err == ERR_USE) {
       LWIP_LOG("  -> err ERR_USE");
@@ -126,6 +94,35 @@ class LWIPRawImpl : public Socket {
     }
     return 0;
   }
+  int connect(const struct sockaddr *name, socklen_t addrlen) override {
+    if (pcb_ == nullptr) {
+      errno = EBADF;
+      return -1;
+    }
+    if (name == nullptr) {
+      errno = EINVAL;
+      return -1;
+    }
+    ip_addr_t ip;
+    in_port_t port;
+    if (this->sockaddr2ip_(name, addrlen, &ip, &port) != 0)
+      return -1;
+#if LWIP_IPV6
+    // binding to AF_INET6 accepts both IP versions, a remote address has to be a real IPv6 address
+    if (family_ == AF_INET6)
+      ip.type = IPADDR_TYPE_V6;
+#endif
+    LWIP_LOG("tcp_connect(%p port=%u)", pcb_, port);
+    err_t err = tcp_connect(pcb_, &ip, port, LWIPRawImpl::s_connected_fn);
+    if (err != ERR_OK) {
+      LWIP_LOG("  -> err %d", err);
+      errno = err == ERR_MEM ? ENOMEM : EIO;
+      return -1;
+    }
+    // only non-blocking operation is supported, completion is reported through connected_fn
+    errno = EINPROGRESS;
+    return -1;
+  }
   int close() override {
     if (pcb_ == nullptr) {
       errno = ECONNRESET;
@@ -178,6 +175,10 @@ class LWIPRawImpl : public Socket {
       errno = EINVAL;
       return -1;
     }
+    if (pcb_->state == SYN_SENT && !connected_) {
+      errno = ENOTCONN;
+      return -1;
+    }
     return this->ip2sockaddr_(&pcb_->local_ip, pcb_->local_port, name, addrlen);
   }
   std::string getpeername() override {
@@ -485,6 +486,11 @@ class LWIPRawImpl : public Socket {
     return 0;
   }
 
+  // The lwIP callbacks update the state checked here, so there is no need to monitor the socket in the loop
+  bool ready() const override {
+    return this->rx_buf_ != nullptr || this->rx_closed_ || this->pcb_ == nullptr || !this->accepted_sockets_.empty();
+  }
+
   err_t accept_fn(struct tcp_pcb *newpcb, err_t err) {
     LWIP_LOG("accept(newpcb=%p err=%d)", newpcb, err);
     if (err != ERR_OK || newpcb == nullptr) {
@@ -499,6 +505,11 @@ class LWIPRawImpl : public Socket {
     accepted_sockets_.push(std::move(sock));
     return ERR_OK;
   }
+  err_t connected_fn(err_t err) {
+    LWIP_LOG("connected(err=%d)", err);
+    connected_ = err == ERR_OK;
+    return ERR_OK;
+  }
   void err_fn(err_t err) {
     LWIP_LOG("err(err=%d)", err);
     // "If a connection is aborted because of an error, the application is alerted of this event by
@@ -535,6 +546,11 @@ class LWIPRawImpl : public Socket {
     return arg_this->accept_fn(newpcb, err);
   }
 
+  static err_t s_connected_fn(void *arg, struct tcp_pcb *pcb, err_t err) {
+    LWIPRawImpl *arg_this = reinterpret_cast<LWIPRawImpl *>(arg);
+    return arg_this->connected_fn(err);
+  }
+
   static void s_err_fn(void *arg, err_t err) {
     LWIPRawImpl *arg_this = reinterpret_cast<LWIPRawImpl *>(arg);
     arg_this->err_fn(err);
@@ -546,6 +562,41 @@ class LWIPRawImpl : public Socket {
   }
 
  protected:
+  int sockaddr2ip_(const struct sockaddr *name, socklen_t addrlen, ip_addr_t *ip, in_port_t *port) {
+#if LWIP_IPV6
+    if (family_ == AF_INET) {
+      if (addrlen < sizeof(sockaddr_in)) {
+        errno = EINVAL;
+        return -1;
+      }
+      auto *addr4 = reinterpret_cast<const sockaddr_in *>(name);
+      *port = ntohs(addr4->sin_port);
+      ip->type = IPADDR_TYPE_V4;
+      ip->u_addr.ip4.addr = addr4->sin_addr.s_addr;
+    } else if (family_ == AF_INET6) {
+      if (addrlen < sizeof(sockaddr_in6)) {
+        errno = EINVAL;
+        return -1;
+      }
+      auto *addr6 = reinterpret_cast<const sockaddr_in6 *>(name);
+      *port = ntohs(addr6->sin6_port);
+      ip->type = IPADDR_TYPE_ANY;
+      memcpy(&ip->u_addr.ip6.addr, &addr6->sin6_addr.un.u8_addr, 16);
+    } else {
+      errno = EINVAL;
+      return -1;
+    }
+#else
+    if (family_ != AF_INET) {
+      errno = EINVAL;
+      return -1;
+    }
+    auto *addr4 = reinterpret_cast<const sockaddr_in *>(name);
+    *port = ntohs(addr4->sin_port);
+    ip->addr = addr4->sin_addr.s_addr;
+#endif
+    return 0;
+  }
   int ip2sockaddr_(ip_addr_t *ip, uint16_t port, struct sockaddr *name, socklen_t *addrlen) {
     if (family_ == AF_INET) {
       if (*addrlen < sizeof(struct sockaddr_in)) {
@@ -589,6 +640,7 @@ class LWIPRawImpl : public Socket {
   struct tcp_pcb *pcb_;
   std::queue<std::unique_ptr<LWIPRawImpl>> accepted_sockets_;
   bool rx_closed_ = false;
+  bool connected_ = false;
   pbuf *rx_buf_ = nullptr;
   size_t rx_buf_offset_ = 0;
   // don't use lwip nodelay flag, it sometimes causes reconnect
@@ -606,6 +658,10 @@ std::unique_ptr<Socket> socket(int domain, int type, int protocol) {
   return std::unique_ptr<Socket>{sock};
 }
 
+std::unique_ptr<Socket> socket_loop_monitored(int domain, int type, int protocol) {
+  return socket(domain, type, protocol);
+}
+
 }  // namespace socket
 }  // namespace esphome
 
@@ -33,7 +33,10 @@ std::string format_sockaddr(const struct sockaddr_storage &storage) {
 
 class LwIPSocketImpl : public Socket {
  public:
-  LwIPSocketImpl(int fd) : fd_(fd) {}
+  LwIPSocketImpl(int fd, bool monitor_loop = false) : fd_(fd) {
+    if (monitor_loop)
+      this->loop_monitored_ = monitor_fd(fd);
+  }
   ~LwIPSocketImpl() override {
     if (!closed_) {
       close();  // NOLINT(clang-analyzer-optin.cplusplus.VirtualCall)
@@ -43,10 +46,15 @@ class LwIPSocketImpl : public Socket {
     int fd = lwip_accept(fd_, addr, addrlen);
     if (fd == -1)
       return {};
-    return make_unique<LwIPSocketImpl>(fd);
+    return make_unique<LwIPSocketImpl>(fd, this->loop_monitored_);
   }
   int bind(const struct sockaddr *addr, socklen_t addrlen) override { return lwip_bind(fd_, addr, addrlen); }
+  int connect(const struct sockaddr *addr, socklen_t addrlen) override { return lwip_connect(fd_, addr, addrlen); }
   int close() override {
+    if (this->loop_monitored_) {
+      unmonitor_fd(fd_);
+      this->loop_monitored_ = false;
+    }
     int ret = lwip_close(fd_);
     closed_ = true;
     return ret;
@@ -97,9 +105,12 @@ class LwIPSocketImpl : public Socket {
     return 0;
   }
 
+  bool ready() const override { return !this->loop_monitored_ || is_fd_ready(fd_); }
+
  protected:
   int fd_;
   bool closed_ = false;
+  bool loop_monitored_ = false;
 };
 
 std::unique_ptr<Socket> socket(int domain, int type, int protocol) {
@@ -109,6 +120,13 @@ std::unique_ptr<Socket> socket(int domain, int type, int protocol) {
   return std::unique_ptr<Socket>{new LwIPSocketImpl(ret)};
 }
 
+std::unique_ptr<Socket> socket_loop_monitored(int domain, int type, int protocol) {
+  int ret = lwip_socket(domain, type, protocol);
+  if (ret == -1)
+    return nullptr;
+  return std::unique_ptr<Socket>{new LwIPSocketImpl(ret, true)};
+}
+
 }  // namespace socket
 }  // namespace esphome
 
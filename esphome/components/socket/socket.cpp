@@ -1,13 +1,70 @@
 #include "socket.h"
 #if defined(USE_SOCKET_IMPL_LWIP_TCP) || defined(USE_SOCKET_IMPL_LWIP_SOCKETS) || defined(USE_SOCKET_IMPL_BSD_SOCKETS)
+#include <algorithm>
 #include <cerrno>
 #include <cstring>
 #include <string>
+#include <vector>
+#include "esphome/core/hal.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
 namespace socket {
 
+#ifdef USE_SOCKET_SELECT_SUPPORT
+static std::vector<int> monitored_fds;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static fd_set ready_fds;                // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+bool monitor_fd(int fd) {
+  if (fd < 0 || fd >= FD_SETSIZE)
+    return false;
+  monitored_fds.push_back(fd);
+  // Until the next wait_for_ready_sockets() it is unknown if there is data
+  FD_SET(fd, &ready_fds);
+  return true;
+}
+
+void unmonitor_fd(int fd) {
+  monitored_fds.erase(std::remove(monitored_fds.begin(), monitored_fds.end(), fd), monitored_fds.end());
+  FD_CLR(fd, &ready_fds);
+}
+
+bool is_fd_ready(int fd) { return FD_ISSET(fd, &ready_fds); }
+
+void wait_for_ready_sockets(uint32_t timeout_ms) {
+  if (monitored_fds.empty()) {
+    if (timeout_ms != 0)
+      delay(timeout_ms);
+    return;
+  }
+  FD_ZERO(&ready_fds);
+  int max_fd = -1;
+  for (int fd : monitored_fds) {
+    FD_SET(fd, &ready_fds);
+    max_fd = std::max(max_fd, fd);
+  }
+  struct timeval tv;
+  tv.tv_sec = timeout_ms / 1000;
+  tv.tv_usec = (timeout_ms % 1000) * 1000;
+#ifdef USE_SOCKET_IMPL_LWIP_SOCKETS
+  int ret = lwip_select(max_fd + 1, &ready_fds, nullptr, nullptr, &tv);
+#else
+  int ret = ::select(max_fd + 1, &ready_fds, nullptr, nullptr, &tv);
+#endif
+  if (ret < 0) {
+    // Consider all sockets ready, so that the error is seen when reading
+    for (int fd : monitored_fds)
+      FD_SET(fd, &ready_fds);
+  }
+}
+#else
+void wait_for_ready_sockets(uint32_t timeout_ms) {
+  // Readiness is tracked by the sockets themselves, there is nothing to wait on
+  if (timeout_ms != 0)
+    delay(timeout_ms);
+}
+#endif  // USE_SOCKET_SELECT_SUPPORT
+
 Socket::~Socket() {}
 
 std::unique_ptr<Socket> socket_ip(int type, int protocol) {
@@ -18,6 +75,14 @@ std::unique_ptr<Socket> socket_ip(int type, int protocol) {
 #endif /* USE_NETWORK_IPV6 */
 }
 
+std::unique_ptr<Socket> socket_ip_loop_monitored(int type, int protocol) {
+#if USE_NETWORK_IPV6
+  return socket_loop_monitored(AF_INET6, type, protocol);
+#else
+  return socket_loop_monitored(AF_INET, type, protocol);
+#endif /* USE_NETWORK_IPV6 */
+}
+
 socklen_t set_sockaddr(struct sockaddr *addr, socklen_t addrlen, const std::string &ip_address, uint16_t port) {
 #if USE_NETWORK_IPV6
   if (ip_address.find(':') != std::string::npos) {
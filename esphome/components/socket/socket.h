@@ -19,9 +19,9 @@ class Socket {
   virtual std::unique_ptr<Socket> accept(struct sockaddr *addr, socklen_t *addrlen) = 0;
   virtual int bind(const struct sockaddr *addr, socklen_t addrlen) = 0;
   virtual int close() = 0;
-  // not supported yet:
-  // virtual int connect(const std::string &address) = 0;
-  // virtual int connect(const struct sockaddr *addr, socklen_t addrlen) = 0;
+  /// Connect to a remote address. Non-blocking sockets return -1 with errno EINPROGRESS, the connection is
+  /// established once getpeername() succeeds.
+  virtual int connect(const struct sockaddr *addr, socklen_t addrlen) = 0;
   virtual int shutdown(int how) = 0;
 
   virtual int getpeername(struct sockaddr *addr, socklen_t *addrlen) = 0;
@@ -42,6 +42,10 @@ class Socket {
 
   virtual int setblocking(bool blocking) = 0;
   virtual int loop() { return 0; };
+
+  /// Whether read() or accept() may return something instead of failing with EAGAIN. Always true for sockets that
+  /// are not monitored, see socket_loop_monitored().
+  virtual bool ready() const { return true; }
 };
 
 /// Create a socket of the given domain, type and protocol.
@@ -50,6 +54,27 @@ std::unique_ptr<Socket> socket(int domain, int type, int protocol);
 /// Create a socket in the newest available IP domain (IPv6 or IPv4) of the given type and protocol.
 std::unique_ptr<Socket> socket_ip(int type, int protocol);
 
+/// Create a socket like socket(), whose readiness is checked once per loop iteration for ready(). Sockets it accepts
+/// are monitored as well. Without select() support this is the same as socket().
+std::unique_ptr<Socket> socket_loop_monitored(int domain, int type, int protocol);
+
+/// Create a socket like socket_ip(), whose readiness is checked once per loop iteration for ready().
+std::unique_ptr<Socket> socket_ip_loop_monitored(int type, int protocol);
+
+#ifdef USE_SOCKET_SELECT_SUPPORT
+/// Add a file descriptor to the ones checked by wait_for_ready_sockets().
+/// @return false if it can't be checked with select(), the socket must then be considered always ready.
+bool monitor_fd(int fd);
+/// Remove a file descriptor added with monitor_fd(), must be done before it is closed.
+void unmonitor_fd(int fd);
+/// Whether the file descriptor had data to read or a connection to accept at the last wait_for_ready_sockets().
+bool is_fd_ready(int fd);
+#endif
+
+/// Wait at most timeout_ms for one of the monitored sockets to become ready, and update which ones are. Called by the
+/// application loop instead of delay(), so it wakes up as soon as there is network activity.
+void wait_for_ready_sockets(uint32_t timeout_ms);
+
 /// Set a sockaddr to the specified address and port for the IP version used by socket_ip().
 socklen_t set_sockaddr(struct sockaddr *addr, socklen_t addrlen, const std::string &ip_address, uint16_t port);
 
@@ -240,6 +240,19 @@ class SPIDelegate {
       ptr[i] = this->transfer(0);
   }
 
+  /**
+   * Write the contents of a buffer in the background where the platform supports it, otherwise write it immediately.
+   * The buffer must stay valid and unchanged until the write has completed, see wait_queued_writes(). Ending the
+   * transaction while writes are queued defers releasing the device until they have completed.
+   */
+  virtual void queue_write_array(const uint8_t *ptr, size_t length) { this->write_array(ptr, length); }
+
+  // wait until no more than max_pending queued writes are in progress
+  virtual void wait_queued_writes(size_t max_pending) {}
+
+  // return the number of queued writes still in progress, without waiting
+  virtual size_t pending_queued_writes() { return 0; }
+
   // check if device is ready
   virtual bool is_ready();
 
@@ -466,6 +479,21 @@ class SPIDevice : public SPIClient {
 
   void write_array(const uint8_t *data, size_t length) { this->delegate_->write_array(data, length); }
 
+  /**
+   * Queue writing the array data and return while it is transferred, where supported.
+   * @param data The data, which must not be changed until the write has completed.
+   * @param length
+   */
+  void queue_write_array(const uint8_t *data, size_t length) { this->delegate_->queue_write_array(data, length); }
+
+  /**
+   * Wait for queued writes to complete.
+   * @param max_pending The number of writes that may still be in progress on return.
+   */
+  void wait_queued_writes(size_t max_pending = 0) { this->delegate_->wait_queued_writes(max_pending); }
+
+  size_t pending_queued_writes() { return this->delegate_->pending_queued_writes(); }
+
   template<size_t N> void write_array(const std::array<uint8_t, N> &data) { this->write_array(data.data(), N); }
 
   void write_array(const std::vector<uint8_t> &data) { this->write_array(data.data(), data.size()); }
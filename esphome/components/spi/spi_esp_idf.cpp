@@ -7,6 +7,7 @@ namespace spi {
 #ifdef USE_ESP_IDF
 static const char *const TAG = "spi-esp-idf";
 static const size_t MAX_TRANSFER_SIZE = 4092;  // dictated by ESP-IDF API.
+static const size_t MAX_QUEUED_TRANSFERS = 4;  // transactions that can be queued for interrupt transfers
 
 class SPIDelegateHw : public SPIDelegate {
  public:
@@ -18,7 +19,7 @@ class SPIDelegateHw : public SPIDelegate {
     config.clock_speed_hz = static_cast<int>(data_rate);
     config.spics_io_num = -1;
     config.flags = 0;
-    config.queue_size = 1;
+    config.queue_size = MAX_QUEUED_TRANSFERS;
     config.pre_cb = nullptr;
     config.post_cb = nullptr;
     if (bit_order == BIT_ORDER_LSB_FIRST)
@@ -33,6 +34,10 @@ class SPIDelegateHw : public SPIDelegate {
   bool is_ready() override { return this->handle_ != nullptr; }
 
   void begin_transaction() override {
+    // finish writes queued in a previous transaction, possibly by another device on this bus
+    SPIDelegateHw *pending = active_delegates[this->channel_];
+    if (pending != nullptr)
+      pending->wait_queued_writes(0);
     if (this->is_ready()) {
       if (spi_device_acquire_bus(this->handle_, portMAX_DELAY) != ESP_OK)
         ESP_LOGE(TAG, "Failed to acquire SPI bus");
@@ -43,13 +48,55 @@ class SPIDelegateHw : public SPIDelegate {
   }
 
   void end_transaction() override {
+    if (this->num_queued_ != 0) {
+      // release the bus once the queued writes have completed
+      this->end_pending_ = true;
+      active_delegates[this->channel_] = this;
+      return;
+    }
     if (this->is_ready()) {
       SPIDelegate::end_transaction();
       spi_device_release_bus(this->handle_);
     }
   }
 
+  void queue_write_array(const uint8_t *ptr, size_t length) override {
+    while (length != 0) {
+      if (this->num_queued_ == MAX_QUEUED_TRANSFERS)
+        this->reclaim_transfer_(portMAX_DELAY);
+      size_t const partial = std::min(length, MAX_TRANSFER_SIZE);
+      spi_transaction_t *desc = &this->queued_[(this->queue_head_ + this->num_queued_) % MAX_QUEUED_TRANSFERS];
+      *desc = {};
+      desc->length = partial * 8;
+      desc->tx_buffer = ptr;
+      esp_err_t const err = spi_device_queue_trans(this->handle_, desc, portMAX_DELAY);
+      if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Queue transmit failed - err %X", err);
+        return;
+      }
+      this->num_queued_++;
+      length -= partial;
+      ptr += partial;
+    }
+  }
+
+  void wait_queued_writes(size_t max_pending) override {
+    while (this->num_queued_ > max_pending)
+      this->reclaim_transfer_(portMAX_DELAY);
+    if (this->num_queued_ == 0)
+      this->finish_transaction_();
+  }
+
+  size_t pending_queued_writes() override {
+    while (this->num_queued_ != 0 && this->reclaim_transfer_(0)) {
+    }
+    if (this->num_queued_ == 0)
+      this->finish_transaction_();
+    return this->num_queued_;
+  }
+
   ~SPIDelegateHw() override {
+    this->wait_queued_writes(0);
     esp_err_t const err = spi_bus_remove_device(this->handle_);
     if (err != ESP_OK)
       ESP_LOGE(TAG, "Remove device failed - err %X", err);
@@ -60,6 +107,8 @@ class SPIDelegateHw : public SPIDelegate {
   // TODO - make use of the queue for interrupt transfers to provide a (short) pipeline of blocks
   // when splitting is required.
   void transfer(const uint8_t *txbuf, uint8_t *rxbuf, size_t length) override {
+    // polling transfers must not overlap queued ones
+    this->wait_queued_writes(0);
     if (rxbuf != nullptr && this->write_only_) {
       ESP_LOGE(TAG, "Attempted read from write-only channel");
       return;
@@ -90,6 +139,7 @@ class SPIDelegateHw : public SPIDelegate {
   }
 
   void write(uint16_t data, size_t num_bits) override {
+    this->wait_queued_writes(0);
     spi_transaction_ext_t desc = {};
     desc.command_bits = num_bits;
     desc.base.flags = SPI_TRANS_VARIABLE_CMD;
@@ -121,6 +171,7 @@ class SPIDelegateHw : public SPIDelegate {
       esph_log_w(TAG, "Nothing to transfer");
       return;
     }
+    this->wait_queued_writes(0);
     desc.base.flags = SPI_TRANS_VARIABLE_ADDR | SPI_TRANS_VARIABLE_CMD | SPI_TRANS_VARIABLE_DUMMY;
     if (bus_width == 4) {
       desc.base.flags |= SPI_TRANS_MODE_QIO;
@@ -189,11 +240,43 @@ class SPIDelegateHw : public SPIDelegate {
   void read_array(uint8_t *ptr, size_t length) override { this->transfer(nullptr, ptr, length); }
 
  protected:
+  // collect the oldest queued transfer, return false if it did not complete in time
+  bool reclaim_transfer_(TickType_t ticks_to_wait) {
+    spi_transaction_t *desc;
+    esp_err_t const err = spi_device_get_trans_result(this->handle_, &desc, ticks_to_wait);
+    if (err == ESP_ERR_TIMEOUT)
+      return false;
+    if (err != ESP_OK)
+      ESP_LOGE(TAG, "Queued transmit failed - err %X", err);
+    this->queue_head_ = (this->queue_head_ + 1) % MAX_QUEUED_TRANSFERS;
+    this->num_queued_--;
+    return true;
+  }
+
+  // complete a transaction that was ended while writes were still queued
+  void finish_transaction_() {
+    if (!this->end_pending_)
+      return;
+    this->end_pending_ = false;
+    if (active_delegates[this->channel_] == this)
+      active_delegates[this->channel_] = nullptr;
+    this->end_transaction();
+  }
+
+  // the device per bus that still holds the bus for queued writes
+  static SPIDelegateHw *active_delegates[SOC_SPI_PERIPH_NUM];
+
   SPIInterface channel_{};
   spi_device_handle_t handle_{};
   bool write_only_{false};
+  bool end_pending_{false};
+  spi_transaction_t queued_[MAX_QUEUED_TRANSFERS]{};
+  size_t queue_head_{0};
+  size_t num_queued_{0};
 };
 
+SPIDelegateHw *SPIDelegateHw::active_delegates[SOC_SPI_PERIPH_NUM] = {};
+
 class SPIBusHw : public SPIBus {
  public:
   SPIBusHw(GPIOPin *clk, GPIOPin *sdo, GPIOPin *sdi, SPIInterface channel, std::vector<uint8_t> data_pins)
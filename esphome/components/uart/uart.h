@@ -42,6 +42,10 @@ class UARTDevice {
 
   void flush() { return this->parent_->flush(); }
 
+  bool start_frame_receiver(const UARTFrameConfig &config, uart_frame_callback_t &&callback) {
+    return this->parent_->start_frame_receiver(config, std::move(callback));
+  }
+
   // Compat APIs
   int read() {
     uint8_t data;
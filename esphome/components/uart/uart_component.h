@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <vector>
 #include <cstring>
 #include "esphome/core/defines.h"
@@ -27,6 +28,35 @@ enum UARTDirection {
 };
 #endif
 
+enum UARTFrameMode : uint8_t {
+  UART_FRAME_DELIMITER,  // a frame ends with the delimiter byte
+  UART_FRAME_IDLE,       // a frame ends when the RX line is idle
+  UART_FRAME_LENGTH,     // a frame contains a length field
+};
+
+/// Describes how the received byte stream is split into frames, see UARTComponent::start_frame_receiver().
+struct UARTFrameConfig {
+  UARTFrameMode mode{UART_FRAME_IDLE};
+  // UART_FRAME_DELIMITER: byte ending a frame, it is included in the frame.
+  uint8_t delimiter{'\n'};
+  // UART_FRAME_IDLE: idle time in symbols (bytes) ending a frame.
+  uint8_t idle_symbols{10};
+  // UART_FRAME_LENGTH: offset and size (1 or 2 bytes) of the length field in the frame.
+  uint8_t length_offset{0};
+  uint8_t length_size{1};
+  bool length_little_endian{true};
+  // UART_FRAME_LENGTH: number of bytes in the frame not counted by the length field.
+  uint16_t length_overhead{0};
+  // UART_FRAME_LENGTH: frames start with one of these headers, bytes not matching any header are skipped.
+  std::vector<std::vector<uint8_t>> headers{};
+  // Longer frames are dropped.
+  size_t max_frame_size{256};
+  // Size of the buffer holding complete frames until they are passed to the callback.
+  size_t buffer_size{1024};
+};
+
+using uart_frame_callback_t = std::function<void(uint8_t *data, size_t len)>;
+
 const LogString *parity_to_str(UARTParityOptions parity);
 
 class UARTComponent {
@@ -149,6 +179,19 @@ class UARTComponent {
   virtual void load_settings(){};
 #endif  // USE_ESP8266 || USE_ESP32
 
+  /**
+   * Receive complete frames in the background instead of reading single bytes.
+   *
+   * When supported by the platform, the UART receives and splits the incoming data into frames without involving
+   * the main loop and calls the callback from its loop() for every complete frame. The data passed to the callback
+   * is only valid during the call. Once started, bytes can't be read with read_byte()/read_array() anymore.
+   *
+   * @param config How the data is split into frames.
+   * @param callback Called with every complete frame.
+   * @return false if frames aren't supported on this platform, data has to be read with read_array() then.
+   */
+  virtual bool start_frame_receiver(const UARTFrameConfig &config, uart_frame_callback_t &&callback) { return false; }
+
 #ifdef USE_UART_DEBUGGER
   void add_debug_callback(std::function<void(UARTDirection, uint8_t)> &&callback) {
     this->debug_callback_.add(std::move(callback));
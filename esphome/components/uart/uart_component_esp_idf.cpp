@@ -5,7 +5,9 @@
 #include "esphome/core/defines.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
+#include <algorithm>
 #include <cinttypes>
+#include <cstring>
 
 #ifdef USE_LOGGER
 #include "esphome/components/logger/logger.h"
@@ -15,6 +17,12 @@ namespace esphome {
 namespace uart {
 static const char *const TAG = "uart.idf";
 
+static const uint32_t FRAME_TASK_STACK_SIZE = 3072;
+static const UBaseType_t FRAME_TASK_PRIORITY = 18;
+static const int PATTERN_QUEUE_SIZE = 16;
+/// RX timeout of the driver (UART_TOUT_THRESH_DEFAULT), restored if the frame receiver could not be started
+static const uint8_t DEFAULT_RX_TIMEOUT = 10;
+
 uart_config_t IDFUARTComponent::get_config_() {
   uart_parity_t parity = UART_PARITY_DISABLE;
   if (this->parity_ == UART_CONFIG_PARITY_EVEN) {
@@ -166,6 +174,10 @@ void IDFUARTComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "  Data Bits: %u", this->data_bits_);
   ESP_LOGCONFIG(TAG, "  Parity: %s", LOG_STR_ARG(parity_to_str(this->parity_)));
   ESP_LOGCONFIG(TAG, "  Stop bits: %u", this->stop_bits_);
+  if (this->frame_ring_buffer_ != nullptr) {
+    ESP_LOGCONFIG(TAG, "  Frame Receiver: mode %u, max frame size %zu", this->frame_config_.mode,
+                  this->frame_config_.max_frame_size);
+  }
   this->check_logger_conflict();
 }
 
@@ -242,6 +254,241 @@ void IDFUARTComponent::flush() {
 
 void IDFUARTComponent::check_logger_conflict() {}
 
+bool IDFUARTComponent::start_frame_receiver(const UARTFrameConfig &config, uart_frame_callback_t &&callback) {
+  if (this->is_failed() || this->frame_task_handle_ != nullptr)
+    return false;
+
+  this->frame_config_ = config;
+  this->frame_callback_ = std::move(callback);
+
+  RAMAllocator<uint8_t> allocator(RAMAllocator<uint8_t>::ALLOC_INTERNAL);
+  this->frame_staging_ = allocator.allocate(config.max_frame_size);
+  this->frame_ring_buffer_ = xRingbufferCreate(config.buffer_size, RINGBUF_TYPE_NOSPLIT);
+  if (this->frame_staging_ == nullptr || this->frame_ring_buffer_ == nullptr) {
+    ESP_LOGE(TAG, "Could not allocate frame buffers for UART %u", this->uart_num_);
+    this->release_frame_receiver_(false);
+    return false;
+  }
+
+  xSemaphoreTake(this->lock_, portMAX_DELAY);
+  if (config.mode == UART_FRAME_DELIMITER) {
+    uart_enable_pattern_det_baud_intr(this->uart_num_, config.delimiter, 1, 9, 0, 0);
+    uart_pattern_queue_reset(this->uart_num_, PATTERN_QUEUE_SIZE);
+  } else {
+    uart_set_rx_timeout(this->uart_num_, config.idle_symbols);
+  }
+  uart_flush_input(this->uart_num_);
+  xQueueReset(this->uart_event_queue_);
+  this->has_peek_ = false;
+  xSemaphoreGive(this->lock_);
+
+  xTaskCreate(IDFUARTComponent::frame_task, "uart_frames", FRAME_TASK_STACK_SIZE, (void *) this, FRAME_TASK_PRIORITY,
+              &this->frame_task_handle_);
+  if (this->frame_task_handle_ == nullptr) {
+    ESP_LOGE(TAG, "Could not start frame task for UART %u", this->uart_num_);
+    this->release_frame_receiver_(true);
+    return false;
+  }
+  return true;
+}
+
+void IDFUARTComponent::release_frame_receiver_(bool restore_uart) {
+  if (restore_uart) {
+    xSemaphoreTake(this->lock_, portMAX_DELAY);
+    if (this->frame_config_.mode == UART_FRAME_DELIMITER) {
+      uart_disable_pattern_det_intr(this->uart_num_);
+    } else {
+      uart_set_rx_timeout(this->uart_num_, DEFAULT_RX_TIMEOUT);
+    }
+    uart_flush_input(this->uart_num_);
+    xQueueReset(this->uart_event_queue_);
+    xSemaphoreGive(this->lock_);
+  }
+  if (this->frame_ring_buffer_ != nullptr) {
+    vRingbufferDelete(this->frame_ring_buffer_);
+    this->frame_ring_buffer_ = nullptr;
+  }
+  if (this->frame_staging_ != nullptr) {
+    RAMAllocator<uint8_t> allocator(RAMAllocator<uint8_t>::ALLOC_INTERNAL);
+    allocator.deallocate(this->frame_staging_, this->frame_config_.max_frame_size);
+    this->frame_staging_ = nullptr;
+  }
+  this->frame_staging_len_ = 0;
+  this->frame_callback_ = nullptr;
+}
+
+void IDFUARTComponent::frame_task(void *params) {
+  auto *this_uart = (IDFUARTComponent *) params;
+  uart_event_t event;
+  while (true) {
+    if (xQueueReceive(this_uart->uart_event_queue_, &event, portMAX_DELAY) != pdTRUE)
+      continue;
+    switch (event.type) {
+      case UART_DATA:
+        // with pattern detection data stays in the driver buffer until the delimiter is received
+        if (this_uart->frame_config_.mode != UART_FRAME_DELIMITER)
+          this_uart->receive_data_(event.size, event.timeout_flag);
+        break;
+      case UART_PATTERN_DET:
+        this_uart->receive_pattern_();
+        break;
+      case UART_FIFO_OVF:
+      case UART_BUFFER_FULL:
+        uart_flush_input(this_uart->uart_num_);
+        xQueueReset(this_uart->uart_event_queue_);
+        if (this_uart->frame_config_.mode == UART_FRAME_DELIMITER)
+          uart_pattern_queue_reset(this_uart->uart_num_, PATTERN_QUEUE_SIZE);
+        this_uart->frame_staging_len_ = 0;
+        this_uart->frames_dropped_++;
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+void IDFUARTComponent::receive_data_(size_t len, bool idle) {
+  const UARTFrameConfig &config = this->frame_config_;
+  while (len > 0) {
+    size_t space = config.max_frame_size - this->frame_staging_len_;
+    if (space == 0) {
+      // no delimiter found within a frame, start over
+      this->frame_staging_len_ = 0;
+      this->frames_dropped_++;
+      continue;
+    }
+    int read = uart_read_bytes(this->uart_num_, this->frame_staging_ + this->frame_staging_len_, std::min(len, space),
+                               0);
+    if (read <= 0)
+      return;
+    this->frame_staging_len_ += read;
+    len -= read;
+    if (config.mode == UART_FRAME_LENGTH)
+      this->parse_length_frames_();
+  }
+  if (idle && config.mode == UART_FRAME_IDLE && this->frame_staging_len_ > 0) {
+    this->commit_frame_(this->frame_staging_, this->frame_staging_len_);
+    this->frame_staging_len_ = 0;
+  }
+}
+
+void IDFUARTComponent::receive_pattern_() {
+  int pos = uart_pattern_pop_pos(this->uart_num_);
+  if (pos < 0) {
+    // the pattern queue overflowed, positions can't be trusted anymore
+    uart_flush_input(this->uart_num_);
+    uart_pattern_queue_reset(this->uart_num_, PATTERN_QUEUE_SIZE);
+    this->frames_dropped_++;
+    return;
+  }
+  size_t len = pos + 1;
+  if (len > this->frame_config_.max_frame_size) {
+    // discard the oversized frame including its delimiter
+    uint8_t discard[32];
+    while (len > 0) {
+      int read = uart_read_bytes(this->uart_num_, discard, std::min(len, sizeof(discard)), 0);
+      if (read <= 0)
+        break;
+      len -= read;
+    }
+    this->frames_dropped_++;
+    return;
+  }
+  int read = uart_read_bytes(this->uart_num_, this->frame_staging_, len, 0);
+  if (read == (int) len)
+    this->commit_frame_(this->frame_staging_, len);
+}
+
+void IDFUARTComponent::parse_length_frames_() {
+  const UARTFrameConfig &config = this->frame_config_;
+  uint8_t *data = this->frame_staging_;
+  size_t start = 0;
+  while (true) {
+    size_t len = this->frame_staging_len_ - start;
+    const uint8_t *frame = data + start;
+
+    if (!config.headers.empty()) {
+      bool match = false;
+      bool partial = false;
+      for (const auto &header : config.headers) {
+        size_t compare = std::min(len, header.size());
+        if (memcmp(frame, header.data(), compare) == 0) {
+          match = compare == header.size();
+          partial = !match;
+          if (match)
+            break;
+        }
+      }
+      if (partial && !match)
+        break;
+      if (!match) {
+        if (len == 0)
+          break;
+        start++;
+        continue;
+      }
+    }
+
+    if (len < (size_t) config.length_offset + config.length_size)
+      break;
+    uint16_t length = frame[config.length_offset];
+    if (config.length_size == 2) {
+      if (config.length_little_endian) {
+        length |= uint16_t(frame[config.length_offset + 1]) << 8;
+      } else {
+        length = (length << 8) | frame[config.length_offset + 1];
+      }
+    }
+    size_t total = length + config.length_overhead;
+    if (total > config.max_frame_size || total == 0) {
+      // not a valid frame, resynchronize on the next byte
+      start++;
+      continue;
+    }
+    if (len < total)
+      break;
+    this->commit_frame_(frame, total);
+    start += total;
+  }
+  if (start > 0) {
+    this->frame_staging_len_ -= start;
+    memmove(data, data + start, this->frame_staging_len_);
+  }
+}
+
+void IDFUARTComponent::commit_frame_(const uint8_t *data, size_t len) {
+  if (xRingbufferSend(this->frame_ring_buffer_, data, len, 0) == pdTRUE) {
+    this->frames_received_++;
+  } else {
+    // the main loop doesn't keep up, drop the frame
+    this->frames_dropped_++;
+  }
+}
+
+void IDFUARTComponent::loop() {
+  if (this->frame_ring_buffer_ == nullptr)
+    return;
+
+  size_t len;
+  void *item;
+  while ((item = xRingbufferReceive(this->frame_ring_buffer_, &len, 0)) != nullptr) {
+    auto *data = static_cast<uint8_t *>(item);
+#ifdef USE_UART_DEBUGGER
+    for (size_t i = 0; i < len; i++) {
+      this->debug_callback_.call(UART_DIRECTION_RX, data[i]);
+    }
+#endif
+    this->frame_callback_(data, len);
+    vRingbufferReturnItem(this->frame_ring_buffer_, item);
+  }
+
+  uint32_t dropped = this->frames_dropped_;
+  if (dropped != this->frames_dropped_logged_) {
+    ESP_LOGW(TAG, "UART %u dropped %" PRIu32 " frames", this->uart_num_, dropped - this->frames_dropped_logged_);
+    this->frames_dropped_logged_ = dropped;
+  }
+}
+
 }  // namespace uart
 }  // namespace esphome
 
@@ -3,6 +3,10 @@
 #ifdef USE_ESP_IDF
 
 #include <driver/uart.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/ringbuf.h>
+#include <freertos/task.h>
+#include <atomic>
 #include "esphome/core/component.h"
 #include "uart_component.h"
 
@@ -12,6 +16,7 @@ namespace uart {
 class IDFUARTComponent : public UARTComponent, public Component {
  public:
   void setup() override;
+  void loop() override;
   void dump_config() override;
   float get_setup_priority() const override { return setup_priority::BUS; }
 
@@ -23,6 +28,10 @@ class IDFUARTComponent : public UARTComponent, public Component {
   int available() override;
   void flush() override;
 
+  bool start_frame_receiver(const UARTFrameConfig &config, uart_frame_callback_t &&callback) override;
+  uint32_t get_frames_received() const { return this->frames_received_; }
+  uint32_t get_frames_dropped() const { return this->frames_dropped_; }
+
   uint8_t get_hw_serial_number() { return this->uart_num_; }
   QueueHandle_t *get_uart_event_queue() { return &this->uart_event_queue_; }
 
@@ -50,6 +59,26 @@ class IDFUARTComponent : public UARTComponent, public Component {
 
   bool has_peek_{false};
   uint8_t peek_byte_;
+
+  static void frame_task(void *params);
+  void receive_data_(size_t len, bool idle);
+  void receive_pattern_();
+  void parse_length_frames_();
+  void commit_frame_(const uint8_t *data, size_t len);
+  /// Undo a frame receiver that could not be started, so that normal reads and a later start work again.
+  void release_frame_receiver_(bool restore_uart);
+
+  UARTFrameConfig frame_config_;
+  uart_frame_callback_t frame_callback_;
+  TaskHandle_t frame_task_handle_{nullptr};
+  /// Complete frames, written by the frame task and passed to the callback in loop()
+  RingbufHandle_t frame_ring_buffer_{nullptr};
+  /// Frame being assembled by the frame task
+  uint8_t *frame_staging_{nullptr};
+  size_t frame_staging_len_{0};
+  std::atomic<uint32_t> frames_received_{0};
+  std::atomic<uint32_t> frames_dropped_{0};
+  uint32_t frames_dropped_logged_{0};
 };
 
 }  // namespace uart
@@ -257,6 +257,17 @@ def _validate(config):
             raise cv.Invalid("At least one network required for fast_connect!")
         if len(networks) != 1:
             raise cv.Invalid("Fast connect can only be used with one network!")
+        if config.get(CONF_FAST_RECONNECT, False):
+            raise cv.Invalid(
+                "fast_reconnect cannot be used together with fast_connect!"
+            )
+
+    if (
+        config.get(CONF_REUSE_DHCP_LEASE, False)
+        and not config.get(CONF_FAST_CONNECT, False)
+        and not config.get(CONF_FAST_RECONNECT, False)
+    ):
+        raise cv.Invalid("reuse_dhcp_lease requires fast_connect or fast_reconnect!")
 
     if CONF_USE_ADDRESS not in config:
         use_address = CORE.name + config[CONF_DOMAIN]
@@ -282,6 +293,8 @@ def _validate(config):
 
 CONF_OUTPUT_POWER = "output_power"
 CONF_PASSIVE_SCAN = "passive_scan"
+CONF_FAST_RECONNECT = "fast_reconnect"
+CONF_REUSE_DHCP_LEASE = "reuse_dhcp_lease"
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
@@ -305,6 +318,8 @@ CONFIG_SCHEMA = cv.All(
                 rtl87xx="none",
             ): cv.enum(WIFI_POWER_SAVE_MODES, upper=True),
             cv.Optional(CONF_FAST_CONNECT, default=False): cv.boolean,
+            cv.Optional(CONF_FAST_RECONNECT, default=False): cv.boolean,
+            cv.Optional(CONF_REUSE_DHCP_LEASE, default=False): cv.boolean,
             cv.Optional(CONF_USE_ADDRESS): cv.string_strict,
             cv.SplitDefault(CONF_OUTPUT_POWER, esp8266=20.0): cv.All(
                 cv.decibel, cv.float_range(min=8.5, max=20.5)
@@ -425,6 +440,8 @@ async def to_code(config):
     cg.add(var.set_reboot_timeout(config[CONF_REBOOT_TIMEOUT]))
     cg.add(var.set_power_save_mode(config[CONF_POWER_SAVE_MODE]))
     cg.add(var.set_fast_connect(config[CONF_FAST_CONNECT]))
+    cg.add(var.set_fast_reconnect(config[CONF_FAST_RECONNECT]))
+    cg.add(var.set_reuse_dhcp_lease(config[CONF_REUSE_DHCP_LEASE]))
     cg.add(var.set_passive_scan(config[CONF_PASSIVE_SCAN]))
     if CONF_OUTPUT_POWER in config:
         cg.add(var.set_output_power(config[CONF_OUTPUT_POWER]))
@@ -41,6 +41,8 @@ namespace esphome {
 namespace wifi {
 
 static const char *const TAG = "wifi";
+/// Wake-ups a DHCP lease is reused on before asking the DHCP server again, so it doesn't outlive the lease time.
+static const uint8_t MAX_DHCP_LEASE_REUSES = 10;
 
 float WiFiComponent::get_setup_priority() const { return setup_priority::WIFI; }
 
@@ -61,11 +63,13 @@ void WiFiComponent::start() {
   ESP_LOGCONFIG(TAG, "Starting WiFi...");
   ESP_LOGCONFIG(TAG, "  Local MAC: %s", get_mac_address_pretty().c_str());
   this->last_connected_ = millis();
+  this->connect_started_ = this->last_connected_;
+  this->connect_times_ = {};
 
   uint32_t hash = this->has_sta() ? fnv1_hash(App.get_compilation_time()) : 88491487UL;
 
   this->pref_ = global_preferences->make_preference<wifi::SavedWifiSettings>(hash, true);
-  if (this->fast_connect_) {
+  if (this->fast_connect_ || this->fast_reconnect_) {
     this->fast_connect_pref_ = global_preferences->make_preference<wifi::SavedWifiFastConnectSettings>(hash, false);
   }
 
@@ -91,8 +95,13 @@ void WiFiComponent::start() {
 
     if (this->fast_connect_) {
       this->selected_ap_ = this->sta_[0];
+      this->selected_sta_index_ = 0;
       this->load_fast_connect_settings_();
       this->start_connecting(this->selected_ap_, false);
+    } else if (this->fast_reconnect_ && this->load_fast_connect_settings_()) {
+      // Skip the scan, it is only needed if the network is not where it was anymore
+      this->fast_reconnect_attempt_ = true;
+      this->start_connecting(this->selected_ap_, false);
     } else {
       this->start_scanning();
     }
@@ -161,6 +170,8 @@ void WiFiComponent::loop() {
       case WIFI_COMPONENT_STATE_STA_CONNECTED: {
         if (!this->is_connected()) {
           ESP_LOGW(TAG, "WiFi Connection lost... Reconnecting...");
+          this->connect_started_ = now;
+          this->connect_times_ = {};
           this->state_ = WIFI_COMPONENT_STATE_STA_CONNECTING;
           this->retry_connect();
         } else {
@@ -365,6 +376,7 @@ void WiFiComponent::start_connecting(const WiFiAP &ap, bool two) {
   ESP_LOGV(TAG, "  Hidden: %s", YESNO(ap.get_hidden()));
 #endif
 
+  this->associated_at_ = 0;
   if (!this->wifi_sta_connect_(ap)) {
     ESP_LOGE(TAG, "wifi_sta_connect_ failed!");
     this->retry_connect();
@@ -493,6 +505,7 @@ void WiFiComponent::check_scanning_finished() {
     return;
   }
   this->scan_done_ = false;
+  this->connect_times_.scan += millis() - this->action_started_;
 
   ESP_LOGD(TAG, "Found networks:");
   if (this->scan_result_.empty()) {
@@ -555,11 +568,13 @@ void WiFiComponent::check_scanning_finished() {
 
   WiFiAP connect_params;
   WiFiScanResult scan_res = this->scan_result_[0];
-  for (auto &config : this->sta_) {
+  for (size_t i = 0; i < this->sta_.size(); i++) {
+    const WiFiAP &config = this->sta_[i];
     // search for matching STA config, at least one will match (from checks before)
     if (!scan_res.matches(config)) {
       continue;
     }
+    this->selected_sta_index_ = i;
 
     if (config.get_hidden()) {
       // selected network is hidden, we use the data from the config
@@ -614,7 +629,18 @@ void WiFiComponent::check_connecting_finished() {
     // We won't retry hidden networks unless a reconnect fails more than three times again
     this->retry_hidden_ = false;
 
+    const uint32_t now = millis();
+    // Without an event for the association, it is counted as part of getting an IP
+    const uint32_t associated_at = this->associated_at_ != 0 ? this->associated_at_ : this->action_started_;
+    this->connect_times_.associate = associated_at - this->action_started_;
+    this->connect_times_.ip = now - associated_at;
+    this->connect_times_.total = now - this->connect_started_;
+    this->fast_reconnect_attempt_ = false;
+
     ESP_LOGI(TAG, "WiFi Connected!");
+    ESP_LOGD(TAG, "Connected in %" PRIu32 " ms (scan %" PRIu32 " ms, association %" PRIu32 " ms, IP %" PRIu32 " ms)",
+             this->connect_times_.total, this->connect_times_.scan, this->connect_times_.associate,
+             this->connect_times_.ip);
     this->print_connect_params_();
 
     if (this->has_ap()) {
@@ -635,9 +661,13 @@ void WiFiComponent::check_connecting_finished() {
     this->state_ = WIFI_COMPONENT_STATE_STA_CONNECTED;
     this->num_retried_ = 0;
 
-    if (this->fast_connect_) {
+    if (this->fast_connect_ || this->fast_reconnect_) {
       this->save_fast_connect_settings_();
     }
+    if (this->dhcp_lease_reused_) {
+      // Later reconnects get a new lease over DHCP
+      this->drop_dhcp_lease_(false);
+    }
 
     return;
   }
@@ -676,6 +706,21 @@ void WiFiComponent::check_connecting_finished() {
 }
 
 void WiFiComponent::retry_connect() {
+  if (this->dhcp_lease_reused_) {
+    // The address may not be ours anymore, don't use it again
+    ESP_LOGD(TAG, "Connecting with the saved DHCP lease failed");
+    this->drop_dhcp_lease_(true);
+  }
+
+  if (this->fast_reconnect_attempt_) {
+    // The saved network could not be connected to, look for it with a scan like without fast_reconnect
+    ESP_LOGD(TAG, "Connecting with saved settings failed");
+    this->fast_reconnect_attempt_ = false;
+    this->error_from_callback_ = false;
+    this->start_scanning();
+    return;
+  }
+
   if (this->selected_ap_.get_bssid()) {
     auto bssid = *this->selected_ap_.get_bssid();
     float priority = this->get_sta_priority(bssid);
@@ -748,35 +793,110 @@ bool WiFiComponent::is_esp32_improv_active_() {
 #endif
 }
 
-void WiFiComponent::load_fast_connect_settings_() {
+static uint32_t ip4_to_u32(const network::IPAddress &ip) {
+  ip_addr_t addr = ip;
+  return ip_addr_get_ip4_u32(&addr);
+}
+
+static network::IPAddress u32_to_ip4(uint32_t ip) {
+  ip_addr_t addr;
+  ip_addr_set_ip4_u32(&addr, ip);
+  return network::IPAddress(&addr);
+}
+
+bool WiFiComponent::load_fast_connect_settings_() {
   SavedWifiFastConnectSettings fast_connect_save{};
 
-  if (this->fast_connect_pref_.load(&fast_connect_save)) {
-    bssid_t bssid{};
-    std::copy(fast_connect_save.bssid, fast_connect_save.bssid + 6, bssid.begin());
-    this->selected_ap_.set_bssid(bssid);
-    this->selected_ap_.set_channel(fast_connect_save.channel);
+  if (!this->fast_connect_pref_.load(&fast_connect_save))
+    return false;
+  this->fast_connect_save_ = fast_connect_save;
+  if (this->fast_reconnect_) {
+    if (fast_connect_save.sta_index >= this->sta_.size())
+      return false;
+    this->selected_sta_index_ = fast_connect_save.sta_index;
+    this->selected_ap_ = this->sta_[fast_connect_save.sta_index];
+  }
+
+  bssid_t bssid{};
+  std::copy(fast_connect_save.bssid, fast_connect_save.bssid + 6, bssid.begin());
+  this->selected_ap_.set_bssid(bssid);
+  this->selected_ap_.set_channel(fast_connect_save.channel);
 
-    ESP_LOGD(TAG, "Loaded saved fast_connect wifi settings");
+  if (this->reuse_dhcp_lease_ && fast_connect_save.ip != 0 && !this->selected_ap_.get_manual_ip().has_value()) {
+    if (!this->wifi_woke_from_deep_sleep_()) {
+      ESP_LOGD(TAG, "Not waking up from deep sleep, requesting a new DHCP lease");
+    } else if (fast_connect_save.lease_reuses >= MAX_DHCP_LEASE_REUSES) {
+      ESP_LOGD(TAG, "Saved DHCP lease was reused %u times, requesting a new one", fast_connect_save.lease_reuses);
+    } else {
+      // Use the last lease as static IP, which skips DHCP
+      ManualIP manual_ip{};
+      manual_ip.static_ip = u32_to_ip4(fast_connect_save.ip);
+      manual_ip.gateway = u32_to_ip4(fast_connect_save.gateway);
+      manual_ip.subnet = u32_to_ip4(fast_connect_save.subnet);
+      manual_ip.dns1 = u32_to_ip4(fast_connect_save.dns1);
+      manual_ip.dns2 = u32_to_ip4(fast_connect_save.dns2);
+      this->selected_ap_.set_manual_ip(manual_ip);
+      this->dhcp_lease_reused_ = true;
+    }
   }
+
+  ESP_LOGD(TAG, "Loaded saved fast_connect wifi settings");
+  return true;
 }
 
 void WiFiComponent::save_fast_connect_settings_() {
   bssid_t bssid = wifi_bssid();
-  uint8_t channel = wifi_channel_();
-
-  if (bssid != this->selected_ap_.get_bssid() || channel != this->selected_ap_.get_channel()) {
-    SavedWifiFastConnectSettings fast_connect_save{};
+  SavedWifiFastConnectSettings fast_connect_save{};
 
-    memcpy(fast_connect_save.bssid, bssid.data(), 6);
-    fast_connect_save.channel = channel;
+  memcpy(fast_connect_save.bssid, bssid.data(), 6);
+  fast_connect_save.channel = wifi_channel_();
+  fast_connect_save.sta_index = this->selected_sta_index_;
+  if (this->dhcp_lease_reused_) {
+    // The address was not handed out again, keep the saved lease and count this use
+    fast_connect_save.ip = this->fast_connect_save_.ip;
+    fast_connect_save.gateway = this->fast_connect_save_.gateway;
+    fast_connect_save.subnet = this->fast_connect_save_.subnet;
+    fast_connect_save.dns1 = this->fast_connect_save_.dns1;
+    fast_connect_save.dns2 = this->fast_connect_save_.dns2;
+    fast_connect_save.lease_reuses = this->fast_connect_save_.lease_reuses + 1;
+  } else if (this->reuse_dhcp_lease_ && !this->sta_[this->selected_sta_index_].get_manual_ip().has_value()) {
+    for (auto &ip : this->wifi_sta_ip_addresses()) {
+      if (ip.is_set() && ip.is_ip4()) {
+        fast_connect_save.ip = ip4_to_u32(ip);
+        fast_connect_save.gateway = ip4_to_u32(this->wifi_gateway_ip_());
+        fast_connect_save.subnet = ip4_to_u32(this->wifi_subnet_mask_());
+        fast_connect_save.dns1 = ip4_to_u32(this->wifi_dns_ip_(0));
+        fast_connect_save.dns2 = ip4_to_u32(this->wifi_dns_ip_(1));
+        break;
+      }
+    }
+  }
 
+  if (memcmp(&fast_connect_save, &this->fast_connect_save_, sizeof(fast_connect_save)) != 0) {
     this->fast_connect_pref_.save(&fast_connect_save);
+    this->fast_connect_save_ = fast_connect_save;
 
     ESP_LOGD(TAG, "Saved fast_connect wifi settings");
   }
 }
 
+void WiFiComponent::drop_dhcp_lease_(bool erase) {
+  this->dhcp_lease_reused_ = false;
+  this->selected_ap_.set_manual_ip({});
+  if (!erase)
+    return;
+
+  SavedWifiFastConnectSettings fast_connect_save = this->fast_connect_save_;
+  fast_connect_save.ip = 0;
+  fast_connect_save.gateway = 0;
+  fast_connect_save.subnet = 0;
+  fast_connect_save.dns1 = 0;
+  fast_connect_save.dns2 = 0;
+  fast_connect_save.lease_reuses = 0;
+  this->fast_connect_pref_.save(&fast_connect_save);
+  this->fast_connect_save_ = fast_connect_save;
+}
+
 void WiFiAP::set_ssid(const std::string &ssid) { this->ssid_ = ssid; }
 void WiFiAP::set_bssid(bssid_t bssid) { this->bssid_ = bssid; }
 void WiFiAP::set_bssid(optional<bssid_t> bssid) { this->bssid_ = bssid; }
@@ -60,6 +60,16 @@ struct SavedWifiSettings {
 struct SavedWifiFastConnectSettings {
   uint8_t bssid[6];
   uint8_t channel;
+  /// Index of the network in the configuration.
+  uint8_t sta_index;
+  /// The IPv4 configuration received over DHCP, all 0 if the network uses a static IP or reuse_dhcp_lease is off.
+  uint32_t ip;
+  uint32_t gateway;
+  uint32_t subnet;
+  uint32_t dns1;
+  uint32_t dns2;
+  /// Number of wake-ups from deep sleep the lease was used on without asking the DHCP server again.
+  uint8_t lease_reuses;
 } PACKED;  // NOLINT
 
 enum WiFiComponentState {
@@ -102,6 +112,18 @@ struct ManualIP {
   network::IPAddress dns2;  ///< The second DNS server. 0.0.0.0 for default.
 };
 
+/// Time spent in each phase of the last connection, in milliseconds.
+struct WiFiConnectTimes {
+  /// Scanning for networks, 0 if the network was connected to without a scan.
+  uint32_t scan;
+  /// From starting to connect to associating with the AP.
+  uint32_t associate;
+  /// From associating with the AP to getting an IP address.
+  uint32_t ip;
+  /// From starting to connect to getting an IP address, including failed attempts.
+  uint32_t total;
+};
+
 #ifdef USE_WIFI_WPA2_EAP
 struct EAPAuth {
   std::string identity;  // required for all auth types
@@ -231,6 +253,8 @@ class WiFiComponent : public Component {
   void check_scanning_finished();
   void start_connecting(const WiFiAP &ap, bool two);
   void set_fast_connect(bool fast_connect);
+  void set_fast_reconnect(bool fast_reconnect) { this->fast_reconnect_ = fast_reconnect; }
+  void set_reuse_dhcp_lease(bool reuse_dhcp_lease) { this->reuse_dhcp_lease_ = reuse_dhcp_lease; }
   void set_ap_timeout(uint32_t ap_timeout) { ap_timeout_ = ap_timeout; }
 
   void check_connecting_finished();
@@ -276,6 +300,7 @@ class WiFiComponent : public Component {
   void set_use_address(const std::string &use_address);
 
   const std::vector<WiFiScanResult> &get_scan_result() const { return scan_result_; }
+  const WiFiConnectTimes &get_connect_times() const { return connect_times_; }
 
   network::IPAddress wifi_soft_ap_ip();
 
@@ -348,12 +373,15 @@ class WiFiComponent : public Component {
   network::IPAddress wifi_subnet_mask_();
   network::IPAddress wifi_gateway_ip_();
   network::IPAddress wifi_dns_ip_(int num);
+  bool wifi_woke_from_deep_sleep_();
 
   bool is_captive_portal_active_();
   bool is_esp32_improv_active_();
 
-  void load_fast_connect_settings_();
+  bool load_fast_connect_settings_();
   void save_fast_connect_settings_();
+  /// Stop using the saved DHCP lease as static IP, and erase it from the saved settings if it didn't work.
+  void drop_dhcp_lease_(bool erase);
 
 #ifdef USE_ESP8266
   static void wifi_event_callback(System_Event_t *event);
@@ -383,7 +411,15 @@ class WiFiComponent : public Component {
   std::vector<WiFiAP> sta_;
   std::vector<WiFiSTAPriority> sta_priorities_;
   WiFiAP selected_ap_;
+  /// Index of the selected network in sta_.
+  uint8_t selected_sta_index_{0};
   bool fast_connect_{false};
+  bool fast_reconnect_{false};
+  bool reuse_dhcp_lease_{false};
+  /// The saved DHCP lease is set as manual IP of selected_ap_ for the first connection after waking up.
+  bool dhcp_lease_reused_{false};
+  /// Connecting with the saved settings of fast_reconnect, a scan is started if that fails.
+  bool fast_reconnect_attempt_{false};
   bool retry_hidden_{false};
 
   bool has_ap_{false};
@@ -391,6 +427,11 @@ class WiFiComponent : public Component {
   WiFiComponentState state_{WIFI_COMPONENT_STATE_OFF};
   bool handled_connected_state_{false};
   uint32_t action_started_;
+  /// Start of the first attempt since the last connection, for connect_times_.
+  uint32_t connect_started_{0};
+  /// When the AP was associated with during the current attempt, 0 if not yet.
+  uint32_t associated_at_{0};
+  WiFiConnectTimes connect_times_{};
   uint8_t num_retried_{0};
   uint32_t last_connected_{0};
   uint32_t reboot_timeout_{};
@@ -404,6 +445,7 @@ class WiFiComponent : public Component {
   bool passive_scan_{false};
   ESPPreferenceObject pref_;
   ESPPreferenceObject fast_connect_pref_;
+  SavedWifiFastConnectSettings fast_connect_save_{};
   bool has_saved_wifi_settings_{false};
 #ifdef USE_WIFI_11KV_SUPPORT
   bool btm_{false};
@@ -4,6 +4,7 @@
 #ifdef USE_ESP32_FRAMEWORK_ARDUINO
 
 #include <esp_netif.h>
+#include <esp_system.h>
 #include <esp_wifi.h>
 
 #include <algorithm>
@@ -519,6 +520,7 @@ void WiFiComponent::wifi_event_callback_(esphome_wifi_event_id_t event, esphome_
       buf[it.ssid_len] = '\0';
       ESP_LOGV(TAG, "Event: Connected ssid='%s' bssid=" LOG_SECRET("%s") " channel=%u, authmode=%s", buf,
                format_mac_addr(it.bssid).c_str(), it.channel, get_auth_mode_str(it.authmode));
+      this->associated_at_ = millis();
 #if USE_NETWORK_IPV6
       this->set_timeout(100, [] { WiFi.enableIpV6(); });
 #endif /* USE_NETWORK_IPV6 */
@@ -803,6 +805,7 @@ int32_t WiFiComponent::wifi_channel_() { return WiFi.channel(); }
 network::IPAddress WiFiComponent::wifi_subnet_mask_() { return network::IPAddress(WiFi.subnetMask()); }
 network::IPAddress WiFiComponent::wifi_gateway_ip_() { return network::IPAddress(WiFi.gatewayIP()); }
 network::IPAddress WiFiComponent::wifi_dns_ip_(int num) { return network::IPAddress(WiFi.dnsIP(num)); }
+bool WiFiComponent::wifi_woke_from_deep_sleep_() { return esp_reset_reason() == ESP_RST_DEEPSLEEP; }
 
 }  // namespace wifi
 }  // namespace esphome
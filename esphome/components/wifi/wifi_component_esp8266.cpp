@@ -491,6 +491,7 @@ void WiFiComponent::wifi_event_callback(System_Event_t *event) {
       ESP_LOGV(TAG, "Event: Connected ssid='%s' bssid=%s channel=%u", buf, format_mac_addr(it.bssid).c_str(),
                it.channel);
       s_sta_connected = true;
+      global_wifi_component->associated_at_ = millis();
       break;
     }
     case EVENT_STAMODE_DISCONNECTED: {
@@ -829,6 +830,7 @@ int32_t WiFiComponent::wifi_channel_() { return WiFi.channel(); }
 network::IPAddress WiFiComponent::wifi_subnet_mask_() { return {(const ip_addr_t *) WiFi.subnetMask()}; }
 network::IPAddress WiFiComponent::wifi_gateway_ip_() { return {(const ip_addr_t *) WiFi.gatewayIP()}; }
 network::IPAddress WiFiComponent::wifi_dns_ip_(int num) { return {(const ip_addr_t *) WiFi.dnsIP(num)}; }
+bool WiFiComponent::wifi_woke_from_deep_sleep_() { return system_get_rst_info()->reason == REASON_DEEP_SLEEP_AWAKE; }
 void WiFiComponent::wifi_loop_() {}
 
 }  // namespace wifi
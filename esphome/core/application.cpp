@@ -7,6 +7,10 @@
 #include "esphome/components/status_led/status_led.h"
 #endif
 
+#ifdef USE_SOCKET_SELECT_SUPPORT
+#include "esphome/components/socket/socket.h"
+#endif
+
 namespace esphome {
 
 static const char *const TAG = "app";
@@ -83,6 +87,9 @@ void Application::loop() {
 
   auto elapsed = now - this->last_loop_;
   if (elapsed >= this->loop_interval_ || HighFrequencyLoopRequester::is_high_frequency()) {
+#ifdef USE_SOCKET_SELECT_SUPPORT
+    socket::wait_for_ready_sockets(0);
+#endif
     yield();
   } else {
     uint32_t delay_time = this->loop_interval_ - elapsed;
@@ -91,7 +98,12 @@ void Application::loop() {
     // otherwise interval=0 schedules result in constant looping with almost no sleep
     next_schedule = std::max(next_schedule, delay_time / 2);
     delay_time = std::min(next_schedule, delay_time);
+#ifdef USE_SOCKET_SELECT_SUPPORT
+    // Wakes up early when a monitored socket receives data
+    socket::wait_for_ready_sockets(delay_time);
+#else
     delay(delay_time);
+#endif
   }
   this->last_loop_ = now;
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <vector>
 #include "esphome/core/component.h"
 #include "esphome/core/helpers.h"
@@ -111,6 +112,12 @@ template<typename... Ts> class Trigger {
       return false;
     return this->automation_parent_->is_running();
   }
+  /// Returns the number of runs of the actions connected to this trigger that haven't finished yet.
+  int num_action_runs_in_flight() {
+    if (this->automation_parent_ == nullptr)
+      return 0;
+    return this->automation_parent_->num_runs_in_flight();
+  }
 
  protected:
   Automation<Ts...> *automation_parent_{nullptr};
@@ -192,6 +199,16 @@ template<typename... Ts> class ActionList {
       this->actions_end_->next_ = action;
     }
     this->actions_end_ = action;
+    action->next_ = this->end_action_;
+  }
+  /// Set an action that is played after all other actions and stays last when actions are added.
+  void set_end_action(Action<Ts...> *action) {
+    this->end_action_ = action;
+    if (this->actions_end_ == nullptr) {
+      this->actions_begin_ = action;
+    } else {
+      this->actions_end_->next_ = action;
+    }
   }
   void add_actions(const std::vector<Action<Ts...> *> &actions) {
     for (auto *action : actions) {
@@ -229,27 +246,106 @@ template<typename... Ts> class ActionList {
 
   Action<Ts...> *actions_begin_{nullptr};
   Action<Ts...> *actions_end_{nullptr};
+  Action<Ts...> *end_action_{nullptr};
+};
+
+/** Slots for the arguments of runs waiting in an action.
+ *
+ * Slots are reused once released, so actions holding on to their arguments don't allocate anymore once the pool has
+ * grown to the number of concurrent runs.
+ */
+template<typename... Ts> class ActionStatePool {
+ public:
+  /// Store the arguments in a free slot and return its index.
+  uint16_t acquire(Ts... x) {
+    for (uint16_t i = 0; i < this->used_.size(); i++) {
+      if (!this->used_[i]) {
+        this->used_[i] = true;
+        this->slots_[i] = std::make_tuple(x...);
+        return i;
+      }
+    }
+    this->slots_.emplace_back(x...);
+    this->used_.push_back(true);
+    return this->slots_.size() - 1;
+  }
+  const std::tuple<Ts...> &get(uint16_t index) const { return this->slots_[index]; }
+  void release(uint16_t index) { this->used_[index] = false; }
+  /// Move the arguments out of a slot and release it. The result stays valid when the slot is acquired again.
+  std::tuple<Ts...> take(uint16_t index) {
+    this->used_[index] = false;
+    return std::move(this->slots_[index]);
+  }
+  /// Index of a slot in use, or -1 if all slots are free.
+  int find_used() const {
+    for (uint16_t i = 0; i < this->used_.size(); i++) {
+      if (this->used_[i])
+        return i;
+    }
+    return -1;
+  }
+  void release_all() { std::fill(this->used_.begin(), this->used_.end(), false); }
+
+ protected:
+  std::vector<std::tuple<Ts...>> slots_;
+  std::vector<bool> used_;
 };
 
+template<typename... Ts> class AutomationEndAction;
+
 template<typename... Ts> class Automation {
  public:
-  explicit Automation(Trigger<Ts...> *trigger) : trigger_(trigger) { this->trigger_->set_automation_parent(this); }
+  explicit Automation(Trigger<Ts...> *trigger) : trigger_(trigger) {
+    this->trigger_->set_automation_parent(this);
+    this->actions_.set_end_action(new AutomationEndAction<Ts...>(this));
+  }
 
   void add_action(Action<Ts...> *action) { this->actions_.add_action(action); }
   void add_actions(const std::vector<Action<Ts...> *> &actions) { this->actions_.add_actions(actions); }
 
-  void stop() { this->actions_.stop(); }
+  void stop() {
+    this->actions_.stop();
+    this->runs_in_flight_ = 0;
+  }
 
-  void trigger(Ts... x) { this->actions_.play(x...); }
+  void trigger(Ts... x) {
+    this->runs_in_flight_++;
+    this->actions_.play(x...);
+  }
 
   bool is_running() { return this->actions_.is_running(); }
 
   /// Return the number of actions in the action part of this automation that are currently running.
   int num_running() { return this->actions_.num_running(); }
 
+  /// Return the number of runs of this automation that have been started and not finished yet.
+  int num_runs_in_flight() {
+    // runs dropped by an action without reaching the end are only noticed once nothing is running anymore
+    if (this->runs_in_flight_ != 0 && !this->actions_.is_running())
+      this->runs_in_flight_ = 0;
+    return this->runs_in_flight_;
+  }
+
  protected:
+  friend AutomationEndAction<Ts...>;
+
   Trigger<Ts...> *trigger_;
   ActionList<Ts...> actions_;
+  int runs_in_flight_{0};
+};
+
+/// Internal action at the end of every automation counting the finished runs.
+template<typename... Ts> class AutomationEndAction : public Action<Ts...> {
+ public:
+  explicit AutomationEndAction(Automation<Ts...> *parent) : parent_(parent) {}
+
+  void play(Ts... x) override {
+    if (this->parent_->runs_in_flight_ > 0)
+      this->parent_->runs_in_flight_--;
+  }
+
+ protected:
+  Automation<Ts...> *parent_;
 };
 
 }  // namespace esphome
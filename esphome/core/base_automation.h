@@ -155,16 +155,27 @@ template<typename... Ts> class DelayAction : public Action<Ts...>, public Compon
   TEMPLATABLE_VALUE(uint32_t, delay)
 
   void play_complex(Ts... x) override {
-    auto f = std::bind(&DelayAction<Ts...>::play_next_, this, x...);
     this->num_running_++;
-    this->set_timeout(this->delay_.value(x...), f);
+    // the arguments are kept in a reusable slot, the callback only captures small values and doesn't allocate
+    uint16_t slot = this->pending_.acquire(x...);
+    this->set_timeout(this->delay_.value(x...), [this, slot]() {
+      // moved out first, the following actions may run this delay again and reuse the slot
+      auto args = this->pending_.take(slot);
+      this->play_next_tuple_(args);
+    });
   }
   float get_setup_priority() const override { return setup_priority::HARDWARE; }
 
   void play(Ts... x) override { /* ignore - see play_complex */
   }
 
-  void stop() override { this->cancel_timeout(""); }
+  void stop() override {
+    this->cancel_timeout("");
+    this->pending_.release_all();
+  }
+
+ protected:
+  ActionStatePool<Ts...> pending_;
 };
 
 template<typename... Ts> class LambdaAction : public Action<Ts...> {
@@ -279,7 +290,8 @@ template<typename... Ts> class RepeatAction : public Action<Ts...> {
     this->then_.add_action(new LambdaAction<uint32_t, Ts...>([this](uint32_t iteration, Ts... x) {
       iteration++;
       if (iteration >= this->count_.value(x...)) {
-        this->play_next_tuple_(this->var_);
+        // the arguments are passed along the loop, so concurrent runs don't share any state
+        this->play_next_(x...);
       } else {
         this->then_.play(iteration, x...);
       }
@@ -288,11 +300,10 @@ template<typename... Ts> class RepeatAction : public Action<Ts...> {
 
   void play_complex(Ts... x) override {
     this->num_running_++;
-    this->var_ = std::make_tuple(x...);
     if (this->count_.value(x...) > 0) {
       this->then_.play(0, x...);
     } else {
-      this->play_next_tuple_(this->var_);
+      this->play_next_(x...);
     }
   }
 
@@ -303,7 +314,6 @@ template<typename... Ts> class RepeatAction : public Action<Ts...> {
 
  protected:
   ActionList<uint32_t, Ts...> then_;
-  std::tuple<Ts...> var_;
 };
 
 template<typename... Ts> class WaitUntilAction : public Action<Ts...>, public Component {
@@ -324,8 +334,8 @@ template<typename... Ts> class WaitUntilAction : public Action<Ts...>, public Co
     this->var_ = std::make_tuple(x...);
 
     if (this->timeout_value_.has_value()) {
-      auto f = std::bind(&WaitUntilAction<Ts...>::play_next_, this, x...);
-      this->set_timeout("timeout", this->timeout_value_.value(x...), f);
+      this->set_timeout("timeout", this->timeout_value_.value(x...),
+                        [this]() { this->play_next_tuple_(this->var_); });
     }
 
     this->loop();
@@ -40,6 +40,7 @@
 #define USE_LIGHT
 #define USE_LOCK
 #define USE_LOGGER
+#define USE_LOGGER_BINARY
 #define USE_LVGL
 #define USE_LVGL_ANIMIMG
 #define USE_LVGL_BINARY_SENSOR
@@ -104,10 +105,13 @@
 #define USE_ESP32_BLE_SERVER
 #define USE_ESP32_CAMERA
 #define USE_IMPROV
+#define USE_LOGGER_ASYNC
 #define USE_MICRO_WAKE_WORD_VAD
 #define USE_MICROPHONE
+#define USE_PREFERENCES_RTC_CACHE 512
 #define USE_PSRAM
 #define USE_SOCKET_IMPL_BSD_SOCKETS
+#define USE_SOCKET_SELECT_SUPPORT
 #define USE_SPEAKER
 #define USE_SPI
 #define USE_VOICE_ASSISTANT
@@ -136,6 +140,7 @@
 #define USE_ADC_SENSOR_VCC
 #define USE_ARDUINO_VERSION_CODE VERSION_CODE(3, 1, 2)
 #define USE_ESP8266_PREFERENCES_FLASH
+#define USE_ESP8266_PREFERENCES_LOG
 #define USE_HTTP_REQUEST_ESP8266_HTTPS
 #define USE_SOCKET_IMPL_LWIP_TCP
 
@@ -158,10 +163,12 @@
 
 #ifdef USE_LIBRETINY
 #define USE_SOCKET_IMPL_LWIP_SOCKETS
+#define USE_SOCKET_SELECT_SUPPORT
 #endif
 
 #ifdef USE_HOST
 #define USE_SOCKET_IMPL_BSD_SOCKETS
+#define USE_SOCKET_SELECT_SUPPORT
 #endif
 
 // Disabled feature flags
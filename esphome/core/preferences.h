@@ -11,6 +11,8 @@ class ESPPreferenceBackend {
  public:
   virtual bool save(const uint8_t *data, size_t len) = 0;
   virtual bool load(uint8_t *data, size_t len) = 0;
+  /// Hold back writes to flash until this time passed since the last one. Ignored by backends without flash writes.
+  virtual void set_min_write_interval(uint32_t interval_ms) {}
 };
 
 class ESPPreferenceObject {
@@ -30,10 +32,32 @@ class ESPPreferenceObject {
     return backend_->load(reinterpret_cast<uint8_t *>(dest), sizeof(T));
   }
 
+  /**
+   * Limit how often this preference is written to flash, for values that change often.
+   *
+   * Saved values are still returned by load() right away. Only the last value saved in the interval is written,
+   * by the first sync() after it, or by flush().
+   */
+  void set_min_write_interval(uint32_t interval_ms) {
+    if (backend_ != nullptr)
+      backend_->set_min_write_interval(interval_ms);
+  }
+
  protected:
   ESPPreferenceBackend *backend_{nullptr};
 };
 
+struct ESPPreferencesStats {
+  /// Values (ESP32) or sectors (ESP8266) written to flash.
+  uint32_t writes{0};
+  /// Flash sectors erased.
+  uint32_t erases{0};
+  /// Saved values not written because they did not change.
+  uint32_t unchanged{0};
+  /// Values held back by sync() because of their minimum write interval.
+  uint32_t deferred{0};
+};
+
 class ESPPreferences {
  public:
   virtual ESPPreferenceObject make_preference(size_t length, uint32_t type, bool in_flash) = 0;
@@ -46,6 +70,13 @@ class ESPPreferences {
    */
   virtual bool sync() = 0;
 
+  /**
+   * Commit all pending writes to flash, including the ones held back by their minimum write interval.
+   *
+   * @return true if write is successful.
+   */
+  virtual bool flush() { return this->sync(); }
+
   /**
    * Forget all unsaved changes and re-initialize the permanent preferences storage.
    * Usually followed by a restart which moves the system to "factory" conditions
@@ -63,6 +94,12 @@ class ESPPreferences {
   ESPPreferenceObject make_preference(uint32_t type) {
     return this->make_preference(sizeof(T), type);
   }
+
+  /// Counters since boot, to estimate the flash wear caused by the preferences.
+  const ESPPreferencesStats &get_stats() const { return this->stats_; }
+
+ protected:
+  ESPPreferencesStats stats_;
 };
 
 extern ESPPreferences *global_preferences;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
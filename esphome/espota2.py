@@ -11,6 +11,7 @@ import time
 
 from esphome.core import EsphomeError
 from esphome.helpers import is_ip_address, resolve_ip_address
+from esphome.ota_delta import OTAImageCache, make_patch
 
 RESPONSE_OK = 0x00
 RESPONSE_REQUEST_AUTH = 0x01
@@ -23,6 +24,7 @@ RESPONSE_RECEIVE_OK = 0x44
 RESPONSE_UPDATE_END_OK = 0x45
 RESPONSE_SUPPORTS_COMPRESSION = 0x46
 RESPONSE_CHUNK_OK = 0x47
+RESPONSE_SUPPORTS_DELTA = 0x48
 
 RESPONSE_ERROR_MAGIC = 0x80
 RESPONSE_ERROR_UPDATE_PREPARE = 0x81
@@ -36,6 +38,7 @@ RESPONSE_ERROR_ESP8266_NOT_ENOUGH_SPACE = 0x88
 RESPONSE_ERROR_ESP32_NOT_ENOUGH_SPACE = 0x89
 RESPONSE_ERROR_NO_UPDATE_PARTITION = 0x8A
 RESPONSE_ERROR_MD5_MISMATCH = 0x8B
+RESPONSE_ERROR_INVALID_PATCH = 0x8D
 RESPONSE_ERROR_UNKNOWN = 0xFF
 
 OTA_VERSION_1_0 = 1
@@ -44,6 +47,13 @@ OTA_VERSION_2_0 = 2
 MAGIC_BYTES = [0x6C, 0x26, 0xF7, 0x5C, 0x45]
 
 FEATURE_SUPPORTS_COMPRESSION = 0x01
+FEATURE_SUPPORTS_DELTA = 0x02
+
+DELTA_MODE_FULL = 0x00
+DELTA_MODE_PATCH = 0x01
+
+# Patches that don't save at least this share of the image are not used
+DELTA_MAX_PATCH_RATIO = 0.9
 
 
 UPLOAD_BLOCK_SIZE = 8192
@@ -80,6 +90,10 @@ class OTAError(EsphomeError):
     pass
 
 
+class DeltaOTAError(OTAError):
+    """An update with a patch failed, the whole image can still be uploaded."""
+
+
 def recv_decode(sock, amount, decode=True):
     data = sock.recv(amount)
     if not decode:
@@ -171,6 +185,10 @@ def check_error(data, expect):
             "Error: Application MD5 code mismatch. Please try again "
             "or flash over USB with a good quality cable."
         )
+    if dat == RESPONSE_ERROR_INVALID_PATCH:
+        raise OTAError(
+            "Error: The patch does not match the firmware running on the ESP."
+        )
     if dat == RESPONSE_ERROR_UNKNOWN:
         raise OTAError("Unknown error from ESP")
     if not isinstance(expect, (list, tuple)):
@@ -194,7 +212,11 @@ def send_check(sock, data, msg):
 
 
 def perform_ota(
-    sock: socket.socket, password: str, file_handle: io.IOBase, filename: str
+    sock: socket.socket,
+    password: str,
+    file_handle: io.IOBase,
+    filename: str,
+    image_cache: OTAImageCache | None = None,
 ) -> None:
     file_contents = file_handle.read()
     file_size = len(file_contents)
@@ -213,9 +235,15 @@ def perform_ota(
         )
 
     # Features
-    send_check(sock, FEATURE_SUPPORTS_COMPRESSION, "features")
+    requested_features = FEATURE_SUPPORTS_COMPRESSION
+    if image_cache is not None:
+        requested_features |= FEATURE_SUPPORTS_DELTA
+    send_check(sock, requested_features, "features")
     features = receive_exactly(
-        sock, 1, "features", [RESPONSE_HEADER_OK, RESPONSE_SUPPORTS_COMPRESSION]
+        sock,
+        1,
+        "features",
+        [RESPONSE_HEADER_OK, RESPONSE_SUPPORTS_COMPRESSION, RESPONSE_SUPPORTS_DELTA],
     )[0]
 
     if features == RESPONSE_SUPPORTS_COMPRESSION:
@@ -249,6 +277,38 @@ def perform_ota(
         send_check(sock, result, "auth result")
         receive_exactly(sock, 1, "auth result", RESPONSE_AUTH_OK)
 
+    patch = None
+    if features == RESPONSE_SUPPORTS_DELTA:
+        running_hash = receive_exactly(sock, 32, "running image hash", [], decode=False)
+        _LOGGER.debug("Hash of running image is %s", running_hash.hex())
+        running_image = image_cache.get(running_hash)
+        if running_image is not None:
+            patch = make_patch(running_image, file_contents)
+            if len(patch) > len(file_contents) * DELTA_MAX_PATCH_RATIO:
+                patch = None
+        if patch is not None:
+            _LOGGER.info("Sending a patch of %s bytes", len(patch))
+            send_check(sock, DELTA_MODE_PATCH, "delta mode")
+        else:
+            send_check(sock, DELTA_MODE_FULL, "delta mode")
+
+    try:
+        _upload(sock, version, upload_contents, patch)
+    except OTAError as err:
+        if patch is not None:
+            raise DeltaOTAError(err) from err
+        raise
+
+    if image_cache is not None:
+        image_cache.store(file_contents)
+
+    # Do not connect logs until it is fully on
+    time.sleep(1)
+
+
+def _upload(
+    sock: socket.socket, version: int, upload_contents: bytes, patch: bytes | None
+) -> None:
     upload_size = len(upload_contents)
     upload_size_encoded = [
         (upload_size >> 24) & 0xFF,
@@ -265,6 +325,12 @@ def perform_ota(
     send_check(sock, upload_md5, "file checksum")
     receive_exactly(sock, 1, "file checksum", RESPONSE_BIN_MD5_OK)
 
+    if patch is not None:
+        # The device rebuilds the image from the patch and checks it with the MD5
+        upload_contents = patch
+        upload_size = len(patch)
+        send_check(sock, upload_size.to_bytes(4, "big"), "patch size")
+
     # Disable nodelay for transfer
     sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 0)
     # Limit send buffer (usually around 100kB) in order to have progress bar
@@ -306,11 +372,8 @@ def perform_ota(
 
     _LOGGER.info("OTA successful")
 
-    # Do not connect logs until it is fully on
-    time.sleep(1)
-
 
-def run_ota_impl_(remote_host, remote_port, password, filename):
+def run_ota_impl_(remote_host, remote_port, password, filename, image_cache=None):
     if is_ip_address(remote_host):
         _LOGGER.info("Connecting to %s", remote_host)
         ip = remote_host
@@ -341,7 +404,17 @@ def run_ota_impl_(remote_host, remote_port, password, filename):
 
     with open(filename, "rb") as file_handle:
         try:
-            perform_ota(sock, password, file_handle, filename)
+            perform_ota(sock, password, file_handle, filename, image_cache)
+        except DeltaOTAError as err:
+            _LOGGER.warning("%s, uploading the whole image", err)
+            sock.close()
+            # Give the device time to close the failed update
+            time.sleep(1)
+            result = run_ota_impl_(remote_host, remote_port, password, filename)
+            if result == 0:
+                file_handle.seek(0)
+                image_cache.store(file_handle.read())
+            return result
         except OTAError as err:
             _LOGGER.error(str(err))
             return 1
@@ -351,9 +424,16 @@ def run_ota_impl_(remote_host, remote_port, password, filename):
     return 0
 
 
-def run_ota(remote_host, remote_port, password, filename):
+def run_ota(remote_host, remote_port, password, filename, image_cache_dir=None):
+    """Upload filename to the device.
+
+    Images are kept in image_cache_dir to send only patches against them later.
+    """
+    image_cache = None
+    if image_cache_dir is not None:
+        image_cache = OTAImageCache(image_cache_dir)
     try:
-        return run_ota_impl_(remote_host, remote_port, password, filename)
+        return run_ota_impl_(remote_host, remote_port, password, filename, image_cache)
     except OTAError as err:
         _LOGGER.error(err)
         return 1
@@ -0,0 +1,131 @@
+"""Patches for delta OTA updates.
+
+A device that supports delta updates sends the SHA-256 of its running image. When the
+image with that hash was uploaded before, only a patch against it is sent. The device
+rebuilds the new image from the patch, see ota_backend_delta.h for the format.
+"""
+
+from __future__ import annotations
+
+import hashlib
+import logging
+from pathlib import Path
+import struct
+
+_LOGGER = logging.getLogger(__name__)
+
+# Must match the operations of DeltaOTABackend
+OP_COPY = 0x00
+OP_INSERT = 0x01
+
+# Length of the matches looked for, shorter matches are inserted
+BLOCK_SIZE = 64
+
+# Offset of hash_appended in the ESP32 image header
+IMAGE_HASH_APPENDED_OFFSET = 23
+IMAGE_HASH_SIZE = 32
+
+# Number of images kept per device
+CACHED_IMAGES = 3
+
+
+def image_hash(data: bytes) -> bytes:
+    """Return the hash of an ESP32 image like esp_partition_get_sha256() does."""
+    if len(data) > IMAGE_HASH_APPENDED_OFFSET and data[IMAGE_HASH_APPENDED_OFFSET]:
+        return data[-IMAGE_HASH_SIZE:]
+    return hashlib.sha256(data).digest()
+
+
+def _insert(patch: bytearray, data: bytes) -> None:
+    if data:
+        patch += struct.pack("<BI", OP_INSERT, len(data))
+        patch += data
+
+
+def make_patch(old: bytes, new: bytes) -> bytes:
+    """Return a patch that rebuilds new from old."""
+    index: dict[bytes, int] = {}
+    for offset in range(0, len(old) - BLOCK_SIZE + 1, BLOCK_SIZE):
+        index.setdefault(old[offset : offset + BLOCK_SIZE], offset)
+
+    patch = bytearray()
+    # Start of the data that is not in the patch yet
+    pending = 0
+    position = 0
+    while position + BLOCK_SIZE <= len(new):
+        old_offset = index.get(new[position : position + BLOCK_SIZE])
+        if old_offset is None:
+            position += 1
+            continue
+
+        # Extend the match in both directions
+        start, old_start = position, old_offset
+        while (
+            start > pending and old_start > 0 and new[start - 1] == old[old_start - 1]
+        ):
+            start -= 1
+            old_start -= 1
+        end = position + BLOCK_SIZE
+        old_end = old_offset + BLOCK_SIZE
+        while end < len(new) and old_end < len(old) and new[end] == old[old_end]:
+            end += 1
+            old_end += 1
+
+        _insert(patch, new[pending:start])
+        patch += struct.pack("<BII", OP_COPY, old_start, end - start)
+        pending = position = end
+
+    _insert(patch, new[pending:])
+    return bytes(patch)
+
+
+def apply_patch(old: bytes, patch: bytes) -> bytes:
+    """Rebuild the new image like the device does."""
+    new = bytearray()
+    position = 0
+    while position < len(patch):
+        op = patch[position]
+        if op == OP_COPY:
+            offset, length = struct.unpack_from("<II", patch, position + 1)
+            if offset + length > len(old):
+                raise ValueError("Copy outside of the old image")
+            new += old[offset : offset + length]
+            position += 9
+        elif op == OP_INSERT:
+            (length,) = struct.unpack_from("<I", patch, position + 1)
+            new += patch[position + 5 : position + 5 + length]
+            position += 5 + length
+        else:
+            raise ValueError(f"Invalid operation 0x{op:02X}")
+    return bytes(new)
+
+
+class OTAImageCache:
+    """The last images uploaded to a device, by their hash."""
+
+    def __init__(self, directory: str | Path) -> None:
+        self._directory = Path(directory)
+
+    def _path(self, hash_: bytes) -> Path:
+        return self._directory / f"{hash_.hex()}.bin"
+
+    def get(self, hash_: bytes) -> bytes | None:
+        try:
+            return self._path(hash_).read_bytes()
+        except OSError:
+            return None
+
+    def store(self, data: bytes) -> None:
+        try:
+            self._directory.mkdir(parents=True, exist_ok=True)
+            stored = self._path(image_hash(data))
+            stored.write_bytes(data)
+            older = sorted(
+                (path for path in self._directory.glob("*.bin") if path != stored),
+                key=lambda path: path.stat().st_mtime,
+                reverse=True,
+            )
+            for path in older[CACHED_IMAGES - 1 :]:
+                path.unlink()
+        except OSError as err:
+            _LOGGER.debug("Could not store the image for delta updates: %s", err)
@@ -0,0 +1,161 @@
+import base64
+import struct
+
+import pytest
+
+from esphome.components.logger import binary_log
+
+STRINGS_ADDRESS = 0x3F400000
+TAG = "sensor"
+FORMAT = "'%s': Sending state %.2f %s with %d decimals"
+
+
+def _elf(strings_address, strings):
+    """Build a 32 bit ELF file with a single loaded section holding the strings."""
+    header_size = 52
+    section = struct.pack(
+        "<IIIIIIIIII",
+        0,
+        binary_log.SHT_PROGBITS,
+        binary_log.SHF_ALLOC,
+        strings_address,
+        header_size,
+        len(strings),
+        0,
+        0,
+        1,
+        0,
+    )
+    header = bytearray(header_size)
+    header[:5] = b"\x7fELF\x01"
+    struct.pack_into("<I", header, 0x20, header_size + len(strings))
+    struct.pack_into("<HH", header, 0x2E, 40, 2)
+    return bytes(header) + strings + bytes(40) + section
+
+
+@pytest.fixture
+def decoder(tmp_path):
+    path = tmp_path / "firmware.elf"
+    path.write_bytes(_elf(STRINGS_ADDRESS, f"{TAG}\0{FORMAT}\0".encode()))
+    return binary_log.BinaryLogDecoder(path)
+
+
+def _line(arguments, level=3, line=42, tag=STRINGS_ADDRESS, format_=None):
+    if format_ is None:
+        format_ = STRINGS_ADDRESS + len(TAG) + 1
+    data = struct.pack("<BHII", level, line, tag, format_) + arguments
+    return binary_log.BINARY_LOG_PREFIX + base64.b64encode(data).decode()
+
+
+def _format(format_, arguments):
+    match = binary_log.FORMAT_SPECIFIER_RE.match(format_)
+    return binary_log._format_argument(match, binary_log._Arguments(arguments))
+
+
+@pytest.mark.parametrize(
+    "format_, arguments, expected",
+    (
+        ("%d", struct.pack("<i", -12), "-12"),
+        ("%i", struct.pack("<i", 7), "7"),
+        ("%5d", struct.pack("<i", 7), "    7"),
+        ("%-3d|", struct.pack("<i", 7), "7  "),
+        ("%lld", struct.pack("<q", -(2**40)), str(-(2**40))),
+        ("%ju", struct.pack("<Q", 2**63), str(2**63)),
+        ("%u", struct.pack("<I", 4000000000), "4000000000"),
+        ("%lu", struct.pack("<I", 4000000000), "4000000000"),
+        ("%hhu", struct.pack("<I", 200), "200"),
+        ("%x", struct.pack("<I", 0xBEEF), "beef"),
+        ("%08X", struct.pack("<I", 0xBEEF), "0000BEEF"),
+        ("%o", struct.pack("<I", 8), "10"),
+        ("%c", struct.pack("<I", ord("A")), "A"),
+        ("%f", struct.pack("<d", 1.5), "1.500000"),
+        ("%.1f", struct.pack("<d", 2.25), "2.2"),
+        ("%e", struct.pack("<d", 1500.0), "1.500000e+03"),
+        ("%G", struct.pack("<d", 0.00001), "1E-05"),
+        ("%a", struct.pack("<d", 1.0), "0x1.0000000000000p+0"),
+        ("%*d", struct.pack("<ii", 4, 7), "   7"),
+        ("%.*f", struct.pack("<id", 3, 1.0), "1.000"),
+        ("%p", struct.pack("<I", 0x3FFB0000), "0x3ffb0000"),
+        ("%s", b"text\0", "text"),
+        ("%6s", b"ab\0", "    ab"),
+        ("%s", b"\xff\0", "\\xff"),
+        ("%%", b"", "%"),
+    ),
+)
+def test_format_argument(format_, arguments, expected):
+    assert _format(format_, arguments) == expected
+
+
+@pytest.mark.parametrize(
+    "format_, arguments",
+    (
+        ("%d", b""),
+        ("%d", b"\x01\x02"),
+        ("%lld", struct.pack("<i", 1)),
+        ("%f", struct.pack("<f", 1.0)),
+        ("%*d", struct.pack("<i", 4)),
+        ("%s", b""),
+    ),
+)
+def test_format_argument_truncated(format_, arguments):
+    with pytest.raises(IndexError):
+        _format(format_, arguments)
+
+
+def test_format_argument_unsupported_conversion():
+    with pytest.raises(IndexError):
+        _format("%n", struct.pack("<I", 0))
+
+
+def test_string_without_terminator():
+    assert _format("%s", b"cut") == "cut"
+
+
+def test_decode(decoder):
+    arguments = b"temp\0" + struct.pack("<d", 21.5) + b"C\0" + struct.pack("<i", 1)
+
+    assert decoder.decode(_line(arguments)) == (
+        "\033[0;32m[I][sensor:042]: 'temp': Sending state 21.50 C with 1 decimals"
+        "\033[0m"
+    )
+
+
+def test_decode_truncated_arguments(decoder):
+    arguments = b"temp\0" + struct.pack("<f", 21.5)
+
+    assert decoder.decode(_line(arguments)) == (
+        "\033[0;32m[I][sensor:042]: 'temp': Sending state ? ? with ? decimals\033[0m"
+    )
+
+
+def test_decode_level_out_of_range(decoder):
+    arguments = b"temp\0" + struct.pack("<d", 1) + b"C\0" + struct.pack("<i", 1)
+
+    assert decoder.decode(_line(arguments, level=200)).startswith("\033[0;38m[VV]")
+
+
+@pytest.mark.parametrize(
+    "line",
+    (
+        "[I][sensor:042]: text message",
+        binary_log.BINARY_LOG_PREFIX + "not base64!",
+        binary_log.BINARY_LOG_PREFIX + base64.b64encode(b"\x03\x2a\x00").decode(),
+    ),
+)
+def test_decode_passes_other_lines(decoder, line):
+    assert decoder.decode(line) == line
+
+
+def test_decode_unknown_address(decoder):
+    line = _line(b"", format_=0x40000000)
+    expected = f"{line} (format not found, is the firmware up to date?)"
+
+    assert decoder.decode(line) == expected
+
+
+def test_not_an_elf_file(tmp_path):
+    path = tmp_path / "firmware.bin"
+    path.write_bytes(b"\xe9" + bytes(100))
+
+    with pytest.raises(ValueError):
+        binary_log.BinaryLogDecoder(path)
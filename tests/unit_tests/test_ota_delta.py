@@ -0,0 +1,58 @@
+import hashlib
+import random
+
+import pytest
+
+from esphome import ota_delta
+
+
+def _image(size, seed=0):
+    return random.Random(seed).randbytes(size)
+
+
+@pytest.mark.parametrize(
+    "old, new",
+    (
+        (b"", b""),
+        (b"", _image(100)),
+        (_image(100), b""),
+        (_image(10000), _image(10000)),
+        (_image(10000), _image(10000)[:5000] + b"inserted" + _image(10000)[5000:]),
+        (_image(10000), _image(10000)[:3000] + _image(10000)[4000:]),
+        (_image(10000), _image(10000, seed=1)),
+    ),
+)
+def test_patch_round_trip(old, new):
+    patch = ota_delta.make_patch(old, new)
+
+    assert ota_delta.apply_patch(old, patch) == new
+
+
+def test_patch_is_small_for_small_changes():
+    old = _image(100000)
+    new = bytearray(old)
+    new[50000:50010] = b"0123456789"
+    new[70000:70000] = b"shifted"
+
+    patch = ota_delta.make_patch(old, bytes(new))
+
+    assert len(patch) < 500
+
+
+def test_image_hash():
+    image = bytearray(_image(1000))
+    image[ota_delta.IMAGE_HASH_APPENDED_OFFSET] = 0
+    assert ota_delta.image_hash(bytes(image)) == hashlib.sha256(image).digest()
+
+    image[ota_delta.IMAGE_HASH_APPENDED_OFFSET] = 1
+    assert ota_delta.image_hash(bytes(image)) == image[-32:]
+
+
+def test_image_cache(tmp_path):
+    cache = ota_delta.OTAImageCache(tmp_path / "images")
+    images = [_image(100, seed) for seed in range(ota_delta.CACHED_IMAGES + 1)]
+    for image in images:
+        cache.store(image)
+
+    assert cache.get(ota_delta.image_hash(images[-1])) == images[-1]
+    assert len(list((tmp_path / "images").iterdir())) == ota_delta.CACHED_IMAGES